@@ -0,0 +1,706 @@
+/*
+  ==============================================================================
+
+	Benchmarks.cpp
+	Created: 17th October 2026 - 07:45 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "TimeStretcher.h"
+#include "DeckResampler.h"
+#include "LibraryQueryEngine.h"
+#include "LibrarySession.h"
+#include "MainComponent.h"
+#include "WaveformCache.h"
+#include "TrackAnalyser.h"
+#include "DJAudioPlayer.h"
+#include "SyncEngine.h"
+using namespace juce;
+
+//==============================================================================
+/* offline timings of the audio engine, run with --benchmark or --benchmark=name1,name2 on the command line.
+   results are written to the log, the GUI is only opened by the startup benchmark */
+
+namespace
+{
+	struct Benchmark
+	{
+		const char* name;
+		void (*run)();
+	};
+
+	const Benchmark benchmarks[] =
+	{
+		{ "timestretch", Benchmarks::timeStretch },
+		{ "resampler", Benchmarks::resampler },
+		{ "search", Benchmarks::search },
+		{ "session", Benchmarks::session },
+		{ "waveform", Benchmarks::waveform },
+		{ "analysis", Benchmarks::analysis },
+		{ "sync", Benchmarks::sync },
+		{ "hotcues", Benchmarks::hotCues },
+		{ "startup", Benchmarks::startup },
+	};
+
+	const double benchmarkSampleRate{ 44100.0 };
+	const int benchmarkBlockSize{ 512 };
+
+	/* ten seconds of chords over noise, enough texture that the similarity search has real work to do */
+	AudioBuffer<float> makeTestSignal()
+	{
+		const int numSamples{ (int) benchmarkSampleRate * 10 };
+		AudioBuffer<float> signal{ 2, numSamples };
+		Random random{ 1234 };
+
+		for (int ch = 0; ch < 2; ++ch)
+		{
+			float* data = signal.getWritePointer(ch);
+			for (int i = 0; i < numSamples; ++i)
+			{
+				const double t{ i / benchmarkSampleRate };
+				data[i] = (float) (0.3 * std::sin(MathConstants<double>::twoPi * 220.0 * t)
+					+ 0.2 * std::sin(MathConstants<double>::twoPi * 277.2 * t * (ch + 1))
+					+ 0.1 * std::sin(MathConstants<double>::twoPi * 329.6 * t))
+					+ 0.05f * (random.nextFloat() * 2.0f - 1.0f);
+			}
+		}
+		return signal;
+	}
+
+	/* pulls seconds of audio through source in device sized blocks, returns the wall clock time taken in ms */
+	double timeRender(AudioSource& source, double seconds)
+	{
+		AudioBuffer<float> block{ 2, benchmarkBlockSize };
+		const int numBlocks{ (int) (seconds * benchmarkSampleRate / benchmarkBlockSize) };
+
+		const double start{ Time::getMillisecondCounterHiRes() };
+		for (int i = 0; i < numBlocks; ++i)
+		{
+			AudioSourceChannelInfo info{ &block, 0, benchmarkBlockSize };
+			source.getNextAudioBlock(info);
+		}
+		return Time::getMillisecondCounterHiRes() - start;
+	}
+
+	/* fills the store and engine with made up tracks, each also handed to onAdded if given */
+	void makeTestLibrary(TrackStore& store, LibraryQueryEngine& engine, int numTracks,
+						 std::function<void(const Track&)> onAdded = nullptr)
+	{
+		const char* words[] = { "deep", "house", "techno", "night", "drive", "summer", "dub", "remix", "edit", "original",
+			"mix", "love", "city", "lights", "dance", "floor", "acid", "rain", "sunset", "groove", "bass", "line", "soul", "fire" };
+		const char* formats[] = { ".mp3", ".wav", ".flac", ".aiff" };
+		const char* keys[] = { "8A", "8B", "9A", "11B", "4A", "2B" };
+		Random random{ 1234 };
+
+		for (int i = 0; i < numTracks; ++i)
+		{
+			String title{ "Artist " + String(random.nextInt(5000)) + " -" };
+			for (int w = 3 + random.nextInt(4); --w >= 0;)
+				title << " " << words[random.nextInt(numElementsInArray(words))];
+
+			Track track{ File::getCurrentWorkingDirectory().getChildFile("library/" + title + formats[random.nextInt(4)]) };
+			track.lengthInSeconds = 120.0 + random.nextInt(360);
+			track.bpm = 80.0 + random.nextInt(96);
+			track.analysed = TrackAnalysis::allMeasured;
+			track.key = keys[random.nextInt(numElementsInArray(keys))];
+			store.add(track);
+			engine.addTrack(track);
+			if (onAdded != nullptr)
+				onAdded(track);
+		}
+	}
+
+	/* the AudioFilesSample folder that ships with the project, looked for above the working directory and the executable */
+	File findSampleFolder()
+	{
+		for (auto start : { File::getCurrentWorkingDirectory(), File::getSpecialLocation(File::currentExecutableFile) })
+			for (auto folder = start; folder.getParentDirectory() != folder; folder = folder.getParentDirectory())
+				if (folder.getChildFile("AudioFilesSample").isDirectory())
+					return folder.getChildFile("AudioFilesSample");
+		return {};
+	}
+
+	/* a click on every beat of a loop a whole number of beats long, so the grid still holds once it loops.
+	   grid is set to what the analyser would find for the clicks as written */
+	LoadedTrack::Ptr makeClickTrack(double bpm, double firstBeat, double sampleRate, TrackAnalysis& grid)
+	{
+		const int samplesPerBeat{ roundToInt(sampleRate * 60.0 / bpm) };
+		const int numBeats{ 32 };
+		DecodedAudio::Ptr audio{ new DecodedAudio(2, samplesPerBeat * numBeats, sampleRate) };
+		audio->buffer.clear();
+
+		const int offset{ roundToInt(firstBeat * sampleRate) };
+		for (int beat = 0; beat < numBeats; ++beat)
+			for (int i = 0; i < 400; ++i)
+				for (int ch = 0; ch < 2; ++ch)
+					audio->buffer.setSample(ch, (offset + beat * samplesPerBeat + i) % audio->buffer.getNumSamples(), 0.9f * std::exp(-i / 30.0f));
+
+		grid.bpm = sampleRate * 60.0 / samplesPerBeat;
+		grid.firstBeat = offset / sampleRate;
+		return new LoadedTrack(URL{}, audio);
+	}
+
+	/* where the clicks come out of a deck, in device samples, each taken where it first crosses half height */
+	struct ClickTimes
+	{
+		std::vector<double> times;
+		int quietSamples{ 0 };
+		float previous{ 0.0f };
+
+		void scan(const AudioBuffer<float>& block, int64 blockStart)
+		{
+			const float* samples{ block.getReadPointer(0) };
+			for (int i = 0; i < block.getNumSamples(); ++i)
+			{
+				if (samples[i] > 0.45f && previous <= 0.45f && quietSamples > 2000)
+					times.push_back(blockStart + i - 1 + (0.45f - previous) / (samples[i] - previous));
+				quietSamples = samples[i] > 0.45f ? 0 : quietSamples + 1;
+				previous = samples[i];
+			}
+		}
+
+		// milliseconds from the nearest of these to time
+		double getOffsetTo(double time) const
+		{
+			auto next = std::lower_bound(times.begin(), times.end(), time);
+			double offset{ std::numeric_limits<double>::max() };
+			if (next != times.end())
+				offset = time - *next;
+			if (next != times.begin() && std::abs(time - *(next - 1)) < std::abs(offset))
+				offset = time - *(next - 1);
+			return offset / benchmarkSampleRate * 1000.0;
+		}
+	};
+}
+
+/* returns true if the command line asked for benchmarks, after running them */
+bool Benchmarks::runFromCommandLine(const String& commandLine)
+{
+	StringArray args;
+	args.addTokens(commandLine, true);
+
+	for (auto& arg : args)
+	{
+		if (!arg.startsWith("--benchmark"))
+			continue;
+
+		// no names runs every benchmark
+		StringArray names;
+		names.addTokens(arg.fromFirstOccurrenceOf("=", false, false), ",", "");
+		names.removeEmptyStrings();
+
+		for (auto& benchmark : benchmarks)
+		{
+			if (names.isEmpty() || names.contains(benchmark.name, true))
+			{
+				Logger::writeToLog("=== " + String(benchmark.name) + " ===");
+				benchmark.run();
+			}
+		}
+		return true;
+	}
+	return false;
+}
+
+/* CPU time per second of audio for each key lock quality, at a tempo typical of mixing */
+void Benchmarks::timeStretch()
+{
+	AudioBuffer<float> signal{ makeTestSignal() };
+	const double seconds{ 30.0 };
+
+	for (int quality = 0; quality < TimeStretcher::numQualities; ++quality)
+	{
+		MemoryAudioSource memorySource{ signal, false, true };
+		TimeStretcher stretcher{ &memorySource };
+		stretcher.setQuality(quality);
+		stretcher.setTempo(1.06);
+		stretcher.setEnabled(true);
+		stretcher.prepareToPlay(benchmarkBlockSize, benchmarkSampleRate);
+
+		const double msPerSecond{ timeRender(stretcher, seconds) / seconds };
+		Logger::writeToLog(TimeStretcher::getQualityName(quality).paddedRight(' ', 8)
+			+ String(msPerSecond, 2) + " ms CPU per second of audio, "
+			+ String(roundToInt(1000.0 / jmax(msPerSecond, 0.001))) + " decks per core");
+
+		stretcher.releaseResources();
+	}
+}
+
+/* CPU time per second of audio for each resampler kernel, at a small and a large ratio */
+void Benchmarks::resampler()
+{
+	AudioBuffer<float> signal{ makeTestSignal() };
+	const double seconds{ 30.0 };
+
+	// a slight pitch up as when beatmatching, and a 96kHz file played fast on a 44.1kHz device
+	for (double ratio : { 1.0137, 2.6 })
+	{
+		for (int kernel = DeckResampler::linear; kernel < DeckResampler::numKernels; ++kernel)
+		{
+			MemoryAudioSource memorySource{ signal, false, true };
+			DeckResampler resampler{ &memorySource };
+			resampler.setKernel(kernel);
+			resampler.setResamplingRatio(ratio);
+			resampler.prepareToPlay(benchmarkBlockSize, benchmarkSampleRate);
+
+			const double msPerSecond{ timeRender(resampler, seconds) / seconds };
+			Logger::writeToLog(DeckResampler::getKernelName(kernel).paddedRight(' ', 8)
+				+ "ratio " + String(ratio, 4) + ": " + String(msPerSecond, 2) + " ms CPU per second of audio, "
+				+ String(roundToInt(resampler.getCpuCost(kernel))) + " ns/sample in the kernel");
+
+			resampler.releaseResources();
+		}
+	}
+}
+
+/* builds a library of made up tracks, then times each kind of query the playlist search box can send */
+void Benchmarks::search()
+{
+	const int numTracks{ 100000 };
+	TrackStore store;
+	LibraryQueryEngine engine{ store };
+
+	double start{ Time::getMillisecondCounterHiRes() };
+	makeTestLibrary(store, engine, numTracks);
+	Logger::writeToLog("indexed " + String(numTracks) + " tracks in "
+		+ String(Time::getMillisecondCounterHiRes() - start, 0) + " ms, the store uses "
+		+ String((int) (store.getMemoryUsage() / numTracks)) + " bytes per track");
+
+	const char* queries[] =
+	{
+		"dub",                              // short, answered by the trigram index
+		"groove",                           // fuzzy path, exact spelling
+		"grove",                            // one typo
+		"deep hoise sunset",                // several words, one misspelt
+		"bpm:120-128",                      // a range filter alone
+		"techno bpm:>130 length:<4:00",     // words and filters together
+		"format:flac key:8a summr",          // text filters and a typo
+	};
+
+	const int runs{ 20 };
+	for (auto* query : queries)
+	{
+		double total{ 0.0 };
+		size_t numHits{ 0 };
+		for (int run = 0; run < runs; ++run)
+		{
+			// an empty query in between, so the index cannot refine the previous result
+			engine.search({});
+			start = Time::getMillisecondCounterHiRes();
+			numHits = engine.search(query).size();
+			total += Time::getMillisecondCounterHiRes() - start;
+		}
+		Logger::writeToLog(String(query).quoted().paddedRight(' ', 34) + String(total / runs, 2) + " ms, "
+			+ String((int) numHits) + " hits");
+	}
+}
+
+/* saves a large library as a snapshot and times loading it back, which is what startup pays */
+void Benchmarks::session()
+{
+	const int numTracks{ 100000 };
+	const File sessionFile{ File::getSpecialLocation(File::tempDirectory).getChildFile("otodecks-benchmark-session.bin") };
+
+	{
+		TrackStore store;
+		LibraryQueryEngine engine{ store };
+		LibrarySession session{ store, engine, sessionFile };
+		makeTestLibrary(store, engine, numTracks, [&session](const Track& track) { session.trackAdded(track); });
+
+		const double start{ Time::getMillisecondCounterHiRes() };
+		session.save();
+		Logger::writeToLog("saved " + String(numTracks) + " tracks in " + String(Time::getMillisecondCounterHiRes() - start, 1)
+			+ " ms, " + File::descriptionOfSizeInBytes(sessionFile.getSize()));
+	}
+
+	for (int run = 0; run < 3; ++run)
+	{
+		TrackStore store;
+		LibraryQueryEngine engine{ store };
+		LibrarySession session{ store, engine, sessionFile };
+
+		const double start{ Time::getMillisecondCounterHiRes() };
+		const bool loaded{ session.load() };
+		Logger::writeToLog("loaded " + String(store.size()) + " tracks in " + String(Time::getMillisecondCounterHiRes() - start, 1)
+			+ " ms" + (loaded ? "" : ", load failed"));
+	}
+
+	sessionFile.deleteFile();
+}
+
+/* a five minute track's waveform drawn the way the decks draw it, per frame, against drawing it whole every time */
+void Benchmarks::waveform()
+{
+	AudioBuffer<float> signal{ makeTestSignal() };
+	const int repeats{ 30 };
+	const int64 lengthInSamples{ (int64) signal.getNumSamples() * repeats };
+
+	double start{ Time::getMillisecondCounterHiRes() };
+	WaveformPyramid::Builder builder{ benchmarkSampleRate, lengthInSamples };
+	for (int i = 0; i < repeats; ++i)
+		builder.addBlock(signal, 0, signal.getNumSamples());
+	WaveformPyramid::Ptr pyramid{ builder.finish() };
+	Logger::writeToLog("summarised 5 minutes in " + String(Time::getMillisecondCounterHiRes() - start, 1) + " ms, "
+		+ String((int) pyramid->levels.size()) + " levels, " + File::descriptionOfSizeInBytes((int64) pyramid->getSizeInBytes()));
+
+	const int width{ 600 }, height{ 80 }, runs{ 300 };
+	Image frame{ Image::RGB, width, height, false };
+	Graphics gfx{ frame };
+
+	// returns the average ms per call of drawFrame, which is given the frame number
+	auto timeFrames = [&](std::function<void(int)> drawFrame)
+	{
+		const double begin{ Time::getMillisecondCounterHiRes() };
+		for (int run = 0; run < runs; ++run)
+			drawFrame(run);
+		return (Time::getMillisecondCounterHiRes() - begin) / runs;
+	};
+	auto log = [](const String& name, double ms) { Logger::writeToLog(name.paddedRight(' ', 34) + String(ms, 3) + " ms"); };
+
+	// the overview, drawn whole on every tick against copying the cached image into the playhead's strip
+	log("overview drawn whole", timeFrames([&](int)
+	{
+		gfx.fillAll(Colours::darkgrey);
+		pyramid->draw(gfx, frame.getBounds(), 0, lengthInSamples, Colours::blue, Colours::lightblue);
+	}));
+
+	Image overview{ Image::RGB, width, height, false };
+	{
+		Graphics overviewGfx{ overview };
+		overviewGfx.fillAll(Colours::darkgrey);
+		pyramid->draw(overviewGfx, overview.getBounds(), 0, lengthInSamples, Colours::blue, Colours::lightblue);
+	}
+	log("overview playhead from cache", timeFrames([&](int run)
+	{
+		gfx.saveState();
+		gfx.reduceClipRegion(run % width, 0, 4, height);
+		gfx.drawImageAt(overview, 0, 0);
+		gfx.setColour(Colours::darkorange);
+		gfx.drawRect(run % width, 0, 3, height);
+		gfx.restoreState();
+	}));
+
+	// the zoomed view at eight seconds across, drawing its strip and then a frame scrolled along it
+	const double samplesPerPixel{ 8.0 * benchmarkSampleRate / width };
+	Image strip{ Image::RGB, width * 3, height, false };
+	Graphics stripGfx{ strip };
+	log("zoomed strip drawn", timeFrames([&](int run)
+	{
+		const int64 stripStart{ (int64) (run * samplesPerPixel * width) % lengthInSamples };
+		stripGfx.fillAll(Colours::black);
+		pyramid->draw(stripGfx, strip.getBounds(), stripStart, stripStart + (int64) (samplesPerPixel * width * 3),
+					  Colours::blue, Colours::lightblue);
+	}));
+	log("zoomed frame from strip", timeFrames([&](int run)
+	{
+		gfx.drawImageAt(strip, -(run % (width * 2)), 0);
+		gfx.setColour(Colours::darkorange);
+		gfx.fillRect(width / 2 - 1, 0, 2, height);
+	}));
+}
+
+/* analyses every track in AudioFilesSample one at a time, printing what was found, then all of them again through
+   the analyser's queue the way an import does, and once more with the results of that cached.
+   waveforms and results go to temporary caches that start empty each time */
+void Benchmarks::analysis()
+{
+	const File folder{ findSampleFolder() };
+	if (!folder.isDirectory())
+	{
+		Logger::writeToLog("AudioFilesSample not found, run from inside the project folder");
+		return;
+	}
+
+	AudioFormatManager formatManager;
+	formatManager.registerBasicFormats();
+	Array<File> files{ folder.findChildFiles(File::findFiles, false, formatManager.getWildcardForAllFormats()) };
+	files.sort();
+
+	const File cacheFolder{ File::getSpecialLocation(File::tempDirectory).getChildFile("otodecks-benchmark-waveforms") };
+	const File analysisFile{ File::getSpecialLocation(File::tempDirectory).getChildFile("otodecks-benchmark-analysis.bin") };
+	auto logThroughput = [&files](const String& name, double ms, double audioSeconds)
+	{
+		Logger::writeToLog(name.paddedRight(' ', 12) + String(files.size() / (ms / 60000.0), 1) + " tracks per minute, "
+			+ String(audioSeconds / (ms / 1000.0), 0) + "x real time");
+	};
+
+	double audioSeconds{ 0.0 };
+	{
+		cacheFolder.deleteRecursively();
+		analysisFile.deleteFile();
+		WaveformCache waveformCache{ formatManager, cacheFolder };
+		AnalysisCache analysisCache{ analysisFile };
+		TrackAnalyser analyser{ formatManager, waveformCache, analysisCache };
+
+		const double start{ Time::getMillisecondCounterHiRes() };
+		for (auto& file : files)
+		{
+			const double trackStart{ Time::getMillisecondCounterHiRes() };
+			TrackAnalysis analysis;
+			if (!analyser.analyseFile(file, analysis))
+			{
+				Logger::writeToLog(file.getFileName().paddedRight(' ', 34) + "cannot be read");
+				continue;
+			}
+
+			if (std::unique_ptr<AudioFormatReader> reader{ formatManager.createReaderFor(file) })
+				audioSeconds += reader->lengthInSamples / reader->sampleRate;
+
+			Logger::writeToLog(file.getFileName().paddedRight(' ', 34)
+				+ (analysis.bpm > 0.0 ? String(analysis.bpm, 2) + " BPM, first beat at " + String(analysis.firstBeat, 3) + " s"
+									  : String("no steady beat"))
+				+ ", " + (analysis.key.isNotEmpty() ? "key " + analysis.key : String("no clear key"))
+				+ ", " + String(analysis.loudness, 1) + " LUFS, " + String(analysis.truePeak, 1) + " dBTP"
+				+ ", " + String(Time::getMillisecondCounterHiRes() - trackStart, 0) + " ms");
+		}
+		logThroughput("1 thread", Time::getMillisecondCounterHiRes() - start, audioSeconds);
+	}
+
+	{
+		cacheFolder.deleteRecursively();
+		analysisFile.deleteFile();
+		WaveformCache waveformCache{ formatManager, cacheFolder };
+		AnalysisCache analysisCache{ analysisFile };
+		TrackAnalyser analyser{ formatManager, waveformCache, analysisCache };
+
+		// the second time round every track is found in the cache, as it would be after a library is imported again
+		for (auto& name : { String(SystemStats::getNumCpus()) + " threads", String("cached") })
+		{
+			const double start{ Time::getMillisecondCounterHiRes() };
+			for (int i = 0; i < files.size(); ++i)
+				analyser.analyse((uint32) i, files.getReference(i));
+
+			while (analyser.getNumQueued() > 0 && Time::getMillisecondCounterHiRes() - start < 600000.0)
+				MessageManager::getInstance()->runDispatchLoopUntil(1);
+
+			logThroughput(name, Time::getMillisecondCounterHiRes() - start, audioSeconds);
+		}
+	}
+
+	cacheFolder.deleteRecursively();
+	analysisFile.deleteFile();
+}
+
+/* two decks of clicks synced for ten minutes, the follower at another tempo and sample rate and started off the beat.
+   the offsets are measured from the clicks coming out of each deck rather than taken from what the follower reports,
+   from a minute in so the follower has pulled itself onto the beat */
+void Benchmarks::sync()
+{
+	AudioFormatManager formatManager;
+	const int64 lengthInSamples{ (int64) (600 * benchmarkSampleRate) };
+	const int64 settledAt{ (int64) (60 * benchmarkSampleRate) };
+
+	for (bool keyLock : { false, true })
+	{
+		SyncEngine syncEngine;
+		DJAudioPlayer master{ formatManager, syncEngine };
+		DJAudioPlayer follower{ formatManager, syncEngine };
+		master.prepareToPlay(benchmarkBlockSize, benchmarkSampleRate);
+		follower.prepareToPlay(benchmarkBlockSize, benchmarkSampleRate);
+
+		TrackAnalysis masterGrid, followerGrid;
+		master.loadTrack(makeClickTrack(126.0, 0.0, benchmarkSampleRate, masterGrid), masterGrid);
+		follower.loadTrack(makeClickTrack(121.7, 0.1, 48000.0, followerGrid), followerGrid);
+		master.toggleLooping();
+		follower.toggleLooping();
+		follower.setKeyLock(keyLock);
+		follower.setPosition(1.234);
+
+		master.setSyncMode(SyncEngine::master);
+		follower.setSyncMode(SyncEngine::follower);
+		master.start();
+		follower.start();
+
+		AudioBuffer<float> masterBlock{ 2, benchmarkBlockSize }, followerBlock{ 2, benchmarkBlockSize };
+		ClickTimes masterClicks, followerClicks;
+		const double start{ Time::getMillisecondCounterHiRes() };
+		for (int64 time = 0; time < lengthInSamples; time += benchmarkBlockSize)
+		{
+			syncEngine.beginBlock(benchmarkBlockSize);
+			master.getNextAudioBlock({ &masterBlock, 0, benchmarkBlockSize });
+			follower.getNextAudioBlock({ &followerBlock, 0, benchmarkBlockSize });
+			masterClicks.scan(masterBlock, time);
+			followerClicks.scan(followerBlock, time);
+		}
+		const double elapsed{ Time::getMillisecondCounterHiRes() - start };
+
+		double firstOffset{ 0.0 }, lastOffset{ 0.0 }, worstOffset{ 0.0 };
+		bool settled{ false };
+		for (double time : followerClicks.times)
+		{
+			if (time < settledAt)
+				continue;
+			lastOffset = masterClicks.getOffsetTo(time);
+			firstOffset = settled ? firstOffset : lastOffset;
+			worstOffset = jmax(worstOffset, std::abs(lastOffset));
+			settled = true;
+		}
+
+		Logger::writeToLog(String(keyLock ? "key lock  " : "varispeed ") + String((int) followerClicks.times.size()) + " beats, offset "
+			+ String(firstOffset, 3) + " ms after 1 minute, " + String(lastOffset, 3) + " ms after 10, worst "
+			+ String(worstOffset, 3) + " ms, drift " + String(lastOffset - firstOffset, 3) + " ms, rendered in "
+			+ String(elapsed / 1000.0, 1) + " s");
+
+		master.releaseResources();
+		follower.releaseResources();
+	}
+}
+
+/* plays on for a while after each jump in real time, so the read-ahead thread has only the time it would have on a
+   device. the player runs at the file's rate with the linear kernel, which passes samples through untouched */
+void Benchmarks::hotCues()
+{
+	const File folder{ findSampleFolder() };
+	if (!folder.isDirectory())
+	{
+		Logger::writeToLog("AudioFilesSample not found, run from inside the project folder");
+		return;
+	}
+
+	AudioFormatManager formatManager;
+	formatManager.registerBasicFormats();
+	Array<File> files{ folder.findChildFiles(File::findFiles, false, "*.mp3") };
+	files.sort();
+	if (files.isEmpty())
+	{
+		Logger::writeToLog("no MP3 files in " + folder.getFullPathName());
+		return;
+	}
+
+	const File cacheFolder{ File::getSpecialLocation(File::tempDirectory).getChildFile("otodecks-benchmark-waveforms") };
+	cacheFolder.deleteRecursively();
+	{
+		WaveformCache waveformCache{ formatManager, cacheFolder };
+		TimeSliceThread readAheadThread{ "Deck read-ahead" };
+		readAheadThread.startThread();
+		DecodedTrackCache decodedCache{ (size_t) 64 * 1024 * 1024 };
+		TrackLoader trackLoader{ formatManager, readAheadThread, decodedCache, waveformCache };
+
+		SyncEngine syncEngine;
+		DJAudioPlayer player{ formatManager, syncEngine };
+		player.setResamplerKernel(DeckResampler::linear);
+
+		auto runMessageLoopUntil = [](std::function<bool()> done)
+		{
+			const double start{ Time::getMillisecondCounterHiRes() };
+			while (!done() && Time::getMillisecondCounterHiRes() - start < 60000.0)
+				MessageManager::getInstance()->runDispatchLoopUntil(1);
+		};
+
+		LoadedTrack::Ptr track;
+		trackLoader.loadAsync(URL{ files.getFirst() }, player.getLoadOptions(), [&track](LoadedTrack::Ptr loaded) { track = loaded; });
+		runMessageLoopUntil([&track] { return track != nullptr; });
+		if (track == nullptr)
+		{
+			Logger::writeToLog(files.getFirst().getFileName() + " cannot be read");
+			return;
+		}
+
+		// cues spread through the track, far enough apart that none is still buffered from the last
+		HotCues hotCues;
+		Array<int64> positions;
+		for (int slot = 0; slot < HotCues::numSlots; ++slot)
+		{
+			hotCues.positions[(size_t) slot] = track->lengthInSamples * (slot + 1) / (HotCues::numSlots + 1);
+			positions.add(hotCues.positions[(size_t) slot]);
+		}
+		player.loadTrack(track, {}, hotCues);
+		player.prepareToPlay(benchmarkBlockSize, track->sampleRate);
+		trackLoader.decodeCuesAsync(track, positions);
+		runMessageLoopUntil([&track] { return track->cueAudio.size() == HotCues::numSlots; });
+
+		std::unique_ptr<AudioFormatReader> reader{ formatManager.createReaderFor(files.getFirst()) };
+		AudioBuffer<float> block{ 2, benchmarkBlockSize }, expected{ 2, benchmarkBlockSize };
+		const double blockMs{ benchmarkBlockSize / track->sampleRate * 1000.0 };
+		const int blocksPerJump{ (int) (2.5 * track->sampleRate / benchmarkBlockSize) };
+
+		Logger::writeToLog(files.getFirst().getFileName() + ", " + String(track->getLengthInSeconds(), 1) + " s at "
+			+ String(track->sampleRate, 0) + " Hz");
+		player.start();
+		for (bool useHotCues : { false, true })
+		{
+			const int underrunsBefore{ player.getUnderrunCount() };
+			int exactJumps{ 0 };
+			float worstError{ 0.0f };
+			for (int slot = 0; slot < HotCues::numSlots; ++slot)
+			{
+				const int64 cue{ hotCues.positions[(size_t) slot] };
+				if (useHotCues)
+					player.triggerHotCue(slot);
+				else
+					player.setPosition(cue / track->sampleRate);
+
+				reader->read(&expected, 0, benchmarkBlockSize, cue, true, true);
+				for (int i = 0; i < blocksPerJump; ++i)
+				{
+					const double blockStart{ Time::getMillisecondCounterHiRes() };
+					syncEngine.beginBlock(benchmarkBlockSize);
+					player.getNextAudioBlock({ &block, 0, benchmarkBlockSize });
+
+					if (i == 0)
+					{
+						float error{ 0.0f };
+						for (int ch = 0; ch < 2; ++ch)
+							for (int n = 0; n < benchmarkBlockSize; ++n)
+								error = jmax(error, std::abs(block.getSample(ch, n) - expected.getSample(ch, n)));
+						exactJumps += error < 1.0e-5f ? 1 : 0;
+						worstError = jmax(worstError, error);
+					}
+					Thread::sleep(jmax(0, roundToInt(blockMs - (Time::getMillisecondCounterHiRes() - blockStart))));
+				}
+			}
+
+			Logger::writeToLog(String(useHotCues ? "hot cues  " : "seeks     ") + String(exactJumps) + " of "
+				+ String(HotCues::numSlots) + " jumps exact, worst first block error " + String(worstError, 4) + ", "
+				+ String(player.getUnderrunCount() - underrunsBefore) + " underruns");
+		}
+		player.stop();
+		player.releaseResources();
+	}
+	cacheFolder.deleteRecursively();
+}
+
+/* opens the real main window on a saved synthetic library, pumping the message loop until it is interactive */
+void Benchmarks::startup()
+{
+	const int numTracks{ 100000 };
+	const File sessionFile{ File::getSpecialLocation(File::tempDirectory).getChildFile("otodecks-benchmark-startup.bin") };
+
+	{
+		TrackStore store;
+		LibraryQueryEngine engine{ store };
+		LibrarySession session{ store, engine, sessionFile };
+		makeTestLibrary(store, engine, numTracks, [&session](const Track& track) { session.trackAdded(track); });
+		session.save();
+	}
+
+	for (int run = 0; run < 3; ++run)
+	{
+		const double start{ Time::getMillisecondCounterHiRes() };
+		auto mainComponent = std::make_unique<MainComponent>(sessionFile);
+		const double constructed{ Time::getMillisecondCounterHiRes() - start };
+
+		{
+			DocumentWindow window{ "OtoDecks startup benchmark", Colours::black, 0 };
+			window.setContentNonOwned(mainComponent.get(), true);
+			window.setVisible(true);
+
+			while (!mainComponent->isInteractive() && Time::getMillisecondCounterHiRes() - start < 30000.0)
+				MessageManager::getInstance()->runDispatchLoopUntil(1);
+		}
+
+		if (!mainComponent->isInteractive())
+			Logger::writeToLog("run " + String(run + 1) + ": not interactive after 30 seconds");
+		else
+			Logger::writeToLog("run " + String(run + 1) + ": constructed in " + String(constructed, 1)
+				+ " ms, first frame " + String(mainComponent->getTimeToFirstFrame(), 1)
+				+ " ms, rows " + String(mainComponent->getTimeToRowsShown(), 1)
+				+ " ms, interactive " + String(mainComponent->getTimeToInteractive(), 1) + " ms");
+	}
+
+	sessionFile.deleteFile();
+	sessionFile.withFileExtension("journal").deleteFile();
+}
@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+	Benchmarks.h
+	Created: 17th October 2026 - 07:30 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/* offline timings of the audio engine, run with --benchmark or --benchmark=name1,name2 on the command line.
+   results are written to the log, the GUI is only opened by the startup benchmark */
+
+namespace Benchmarks
+{
+	// returns true if the command line asked for benchmarks, after running them
+	bool runFromCommandLine(const juce::String& commandLine);
+
+	// CPU time per second of audio for each key lock quality
+	void timeStretch();
+
+	// CPU time per second of audio for each resampler kernel, at a small and a large ratio
+	void resampler();
+
+	// query time over a synthetic library for plain, typo and filtered searches
+	void search();
+
+	// time to save and load a large library session
+	void session();
+
+	// drawing cost per frame of the whole track waveform and the scrolling zoomed view, cached against drawn each time
+	void waveform();
+
+	// tracks per minute the analyser gets through in the AudioFilesSample folder, on one thread, on every core and from its cache
+	void analysis();
+
+	// how far a synced follower's beats are from the master's after ten minutes of audio, varispeed and key lock
+	void sync();
+
+	// whether the first block after a jump to each of eight cues in a streamed MP3 is the file's audio at the cue,
+	// and read-ahead underruns after it, for plain seeks and for hot cues
+	void hotCues();
+
+	// time from building the main window to its first frame, to the library rows and to being interactive
+	void startup();
+}
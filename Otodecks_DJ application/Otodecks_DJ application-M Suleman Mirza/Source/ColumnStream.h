@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+	ColumnStream.h
+	Created: 18th October 2026 - 11:05 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+//==============================================================================
+/* whole columns written as a count and their raw bytes, padded so every column starts on an
+   8 byte boundary. a file of them can be memory mapped and each column copied out in one go,
+   nothing is parsed value by value. values are in the machine's byte order */
+
+class ColumnWriter
+{
+public:
+	ColumnWriter(juce::OutputStream& _out) : out{ _out } {}
+
+	template <typename T>
+	void writeColumn(const std::vector<T>& column)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "columns are copied as raw bytes");
+		writeBytes(column.data(), column.size(), sizeof(T));
+	}
+
+	void writeText(const std::string& text)
+	{
+		writeBytes(text.data(), text.size(), 1);
+	}
+
+	void writeValue(juce::uint64 value)
+	{
+		out.write(&value, sizeof(value));
+	}
+
+private:
+	void writeBytes(const void* data, size_t count, size_t elementSize)
+	{
+		writeValue((juce::uint64) count);
+		const size_t numBytes{ count * elementSize };
+		out.write(data, numBytes);
+
+		const char padding[8]{};
+		out.write(padding, (8 - numBytes % 8) % 8);
+	}
+
+	juce::OutputStream& out;
+};
+
+class ColumnReader
+{
+public:
+	ColumnReader(const void* _data, size_t _size) : data{ static_cast<const char*>(_data) }, size{ _size } {}
+
+	template <typename T>
+	bool readColumn(std::vector<T>& column)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "columns are copied as raw bytes");
+		const juce::uint64 count{ readValue() };
+		if (!canRead(count, sizeof(T)))
+			return false;
+
+		column.resize((size_t) count);
+		if (count > 0)
+			std::memcpy(column.data(), data + position, (size_t) count * sizeof(T));
+		skip((size_t) count * sizeof(T));
+		return true;
+	}
+
+	// points into the data instead of copying, valid for as long as the data is. columns start 8 byte aligned
+	template <typename T>
+	const T* readSpan(size_t& count)
+	{
+		static_assert(std::is_trivially_copyable<T>::value && alignof(T) <= 8, "columns are read as raw bytes");
+		const juce::uint64 numElements{ readValue() };
+		if (!canRead(numElements, sizeof(T)))
+			return nullptr;
+
+		const T* span{ reinterpret_cast<const T*>(data + position) };
+		count = (size_t) numElements;
+		skip(count * sizeof(T));
+		return span;
+	}
+
+	bool readText(std::string& text)
+	{
+		const juce::uint64 count{ readValue() };
+		if (!canRead(count, 1))
+			return false;
+
+		text.assign(data + position, (size_t) count);
+		skip((size_t) count);
+		return true;
+	}
+
+	juce::uint64 readValue()
+	{
+		juce::uint64 value{ 0 };
+		if (canRead(1, sizeof(value)))
+		{
+			std::memcpy(&value, data + position, sizeof(value));
+			position += sizeof(value);
+		}
+		return value;
+	}
+
+	// true once a read ran past the end, everything read after that is empty
+	bool failed() const { return hasFailed; }
+
+private:
+	bool canRead(juce::uint64 count, size_t elementSize)
+	{
+		if (hasFailed || count > (size - position) / elementSize)
+			hasFailed = true;
+		return !hasFailed;
+	}
+
+	void skip(size_t numBytes)
+	{
+		position = juce::jmin(size, position + numBytes + (8 - numBytes % 8) % 8);
+	}
+
+	const char* data;
+	size_t size;
+	size_t position{ 0 };
+	bool hasFailed{ false };
+};
@@ -1,231 +1,557 @@
-/*
-  ==============================================================================
-
-	DJAudioPlayer.cpp
-	Created: 15th January 2023 - 6:00 PM
-	Author:  Muhammad Suleman Mirza
-
-  ==============================================================================
-*/
-
-#include "DJAudioPlayer.h"
-using namespace juce;
-
-/* class that contains the various functions of handling audio data */
-
-DJAudioPlayer::DJAudioPlayer(AudioFormatManager& _formatManager) :
-	formatManager{ _formatManager },	
-	globalSampleRate{ 0 }
-{
-
-}
-
-DJAudioPlayer::~DJAudioPlayer() 
-{
-
-}
-
-void DJAudioPlayer::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
-{
-	globalSampleRate = sampleRate;
-	transportSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
-	resampleSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
-	filterSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
-	lowSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
-	midSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
-	highSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
-}
-void DJAudioPlayer::getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill)
-{
-	highSource.getNextAudioBlock(bufferToFill);
-}
-
-void DJAudioPlayer::releaseResources()
-{
-	highSource.releaseResources();
-}
-
-/* load audio track from file path */
-bool DJAudioPlayer::loadURL(URL audioURL)
-{
-	auto* reader = formatManager.createReaderFor(audioURL.createInputStream(false));
-
-	if (reader != nullptr)
-	{
-		std::unique_ptr<AudioFormatReaderSource> newSource
-		(new AudioFormatReaderSource(reader, true));
-		transportSource.setSource(newSource.get(), 0, nullptr, reader->sampleRate);
-		readerSource.reset(newSource.release());
-
-		DBG("DJAudioPlayer::loadURL: file successfully loaded");
-		return true;
-	}
-	else {
-		DBG("DJAudioPlayer::loadURL: unable to load file");
-	}
-	return false;
-}
-
-/* starts transportSource audio playback */
-void DJAudioPlayer::start()
-{
-	transportSource.start();
-}
-
-/* stops transportSource audio playback */
-void DJAudioPlayer::stop()
-{
-	transportSource.stop();
-}
-
-/* returns true if audio source is playing, false otherwise */
-bool DJAudioPlayer::isPlaying()
-{
-	return transportSource.isPlaying();
-}
-
-/* returns data in seconds about length of track */
-double DJAudioPlayer::getLengthOfTrack()
-{
-	return transportSource.getLengthInSeconds();
-}
-
-/* returns track duration in minutes without initializing transportSource */
-double DJAudioPlayer::getLengthAudioURL(URL audioURL)
-{
-	double lengthInSeconds{ 0 };
-	auto* reader = formatManager.createReaderFor(audioURL.createInputStream(false));
-	if (reader != nullptr)
-	{
-		std::unique_ptr<AudioFormatReaderSource> newSource(new AudioFormatReaderSource(reader, true));
-		// length of track = lengthInSamples / sampleRate
-		lengthInSeconds = reader->lengthInSamples / reader->sampleRate;
-		newSource.reset();
-	}
-	return lengthInSeconds;
-}
-
-/* returns current track position in seconds*/
-double DJAudioPlayer::getCurrentPosition()
-{
-	return transportSource.getCurrentPosition();
-}
-
-/* returns ratio of current track playback time*/
-double DJAudioPlayer::getPositionRelative()
-{
-	return transportSource.getCurrentPosition() / transportSource.getLengthInSeconds();
-}
-
-//==============================================================================
-/* sets position of audioplay back, used in posSlider */
-void DJAudioPlayer::setPosition(double posInSeconds)
-{
-	transportSource.setPosition(posInSeconds);
-}
-
-/* sets relative position of track ie. a truncated slider */
-void DJAudioPlayer::setPositionRelative(double pos)
-{
-	if (pos < 0 || pos > 1.0)
-	{
-		DBG("DJAudioPlayer::setPositionRelative: position is out of set range");
-	}
-	else
-	{
-		double posInSeconds = transportSource.getLengthInSeconds() * pos;
-		setPosition(posInSeconds);
-	}
-}
-
-/* set volume of the audio track */
-void DJAudioPlayer::setGain(double gain)
-{
-	if (gain < 0 || gain > 2.0)
-	{
-		DBG("DJAudioPlayer::setGain: gain is out of set range");
-	}
-	else
-	{
-		transportSource.setGain(gain);
-	}
-}
-
-/* set playback speed of the track */
-void DJAudioPlayer::setSpeed(double ratio)
-{
-	if (ratio < 0 || ratio > 100.0)
-	{
-		DBG("DJAudioPlayer::setSpeed: speed is out of set range");
-	}
-	else
-	{
-		resampleSource.setResamplingRatio(ratio);
-	}
-}
-
-/* returns true if toggle was successful, looping is off by default */
-bool DJAudioPlayer::toggleLooping()
-{
-	if (readerSource) // check audiosource exists
-	{
-		if (!readerSource->isLooping())
-		{
-			readerSource->setLooping(true);
-			DBG("DJAudioPlayer::toggleLooping: looping toggled ON");
-			return true;
-		}
-		else
-		{
-			readerSource->setLooping(false);
-			DBG("DJAudioPlayer::toggleLooping: looping toggled OFF");
-		}
-	}
-	return false;
-}
-
-//==============================================================================
-/* sets coefficients of lowpass and highpass frequency for freqSlider */
-void DJAudioPlayer::setFrequency(double frequency = 0)
-{
-	if (frequency < 0) 
-	{
-		IIRCoefficients lowPassFilter = IIRCoefficients::makeLowPass(globalSampleRate, frequency * -1);
-		filterSource.setCoefficients(lowPassFilter);
-		DBG("DJAudioPlayer::setLowPass: frequency: " << frequency * -1);
-	}
-	else if (frequency > 0)
-	{
-		IIRCoefficients highPassFilter = IIRCoefficients::makeHighPass(globalSampleRate, frequency);
-		filterSource.setCoefficients(highPassFilter);
-		DBG("DJAudioPlayer::setHighPass: frequency: " << frequency);
-	}
-	else
-	{
-		filterSource.makeInactive();
-	}
-}
-
-/* sets coefficients of low shelf, changes output source */
-void DJAudioPlayer::setLowShelf(double gainFactor = 1.0)
-{
-	IIRCoefficients lowShelf = IIRCoefficients::makeLowShelf(globalSampleRate, 300, 1.0 / juce::MathConstants<double>::sqrt2, gainFactor);
-	lowSource.setCoefficients(lowShelf);
-	DBG("DJAudioPlayer::setLowShelf: gainFactor: " << gainFactor);
-}
-
-/* sets coefficients of peak filter, changes output source */
-void DJAudioPlayer::setPeakFilter(double gainFactor = 1.0)
-{
-	IIRCoefficients peakFilter = IIRCoefficients::makePeakFilter(globalSampleRate, 3000, 1.0 / juce::MathConstants<double>::sqrt2, gainFactor);
-	midSource.setCoefficients(peakFilter);
-	DBG("DJAudioPlayer::setPeakFilter: gainFactor: " << gainFactor);
-}
-
-/* sets coefficients of high shelf, changes output source */
-void DJAudioPlayer::setHighShelf(double gainFactor = 1.0)
-{
-	IIRCoefficients highShelf = IIRCoefficients::makeHighShelf(globalSampleRate, 4500, 1.0 / juce::MathConstants<double>::sqrt2, gainFactor);
-	highSource.setCoefficients(highShelf);
-	DBG("DJAudioPlayer::setHighShelf: gainFactor: " << gainFactor);
+/*
+  ==============================================================================
+
+	DJAudioPlayer.cpp
+	Created: 15th January 2023 - 6:00 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#include "DJAudioPlayer.h"
+using namespace juce;
+
+/* class that contains the various functions of handling audio data */
+
+DJAudioPlayer::DJAudioPlayer(AudioFormatManager& _formatManager, SyncEngine& _syncEngine) :
+	formatManager{ _formatManager },
+	syncEngine{ _syncEngine },
+	globalSampleRate{ 0 },
+	speedRatio{ 1.0 },
+	readAheadSamples{ 32768 },
+	decodeToRam{ false }
+{
+	// the track source stays attached, loaded tracks are swapped in behind it
+	transportSource.setSource(&trackSource);
+}
+
+DJAudioPlayer::~DJAudioPlayer() 
+{
+	if (syncEngine.getMaster() == this)
+		syncEngine.setMaster(nullptr);
+	transportSource.setSource(nullptr);
+}
+
+void DJAudioPlayer::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+	globalSampleRate = sampleRate;
+	updateResamplingRatio();
+
+	// start at the current settings, only later changes are ramped
+	gainRamp.reset(sampleRate, 0.05);
+	gainRamp.setCurrentAndTargetValue(targetGain.load() * Decibels::decibelsToGain((float) getNormalisationGain()));
+	ratioRamp.reset(sampleRate, 0.05);
+	ratioRamp.setCurrentAndTargetValue(targetRatio.load());
+	resampleSource.setResamplingRatio(ratioRamp.getCurrentValue());
+
+	// prepares resampleSource, timeStretcher and transportSource down the chain
+	equaliser.prepareToPlay(samplesPerBlockExpected, sampleRate);
+}
+
+/* renders the chain, the resampler glides to where the ratio ramp has got to and gain changes are faded.
+   a synced follower's speed comes from the sync clock instead, and the master moves the clock on afterwards */
+void DJAudioPlayer::getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill)
+{
+	// a hot cue jump starts this block, whatever the stretcher and resampler read before it is dropped
+	// so the cue's first sample is the first one out
+	if (trackSource.applyPendingJump())
+	{
+		timeStretcher.flush();
+		resampleSource.flush();
+	}
+
+	const int mode{ getSyncMode() };
+	auto* track = trackSource.getActiveTrack();
+	if (mode == SyncEngine::follower && track != nullptr && track->analysis.bpm > 0
+		&& syncEngine.getBeatsPerSample() > 0 && transportSource.isPlaying())
+	{
+		followClock(*track);
+	}
+	else
+	{
+		syncedSpeed.store(0.0);
+		timeStretcher.setTempo(speedRatio.load());
+		ratioRamp.setTargetValue(targetRatio.load());
+		resampleSource.setResamplingRatio(ratioRamp.skip(bufferToFill.numSamples));
+	}
+	equaliser.getNextAudioBlock(bufferToFill);
+
+	if (mode == SyncEngine::master && transportSource.isPlaying())
+		publishBeat();
+
+	// the normalisation gain is the trim in front of the fader, it changes with the track and so is ramped with it
+	const double normalisation{ track != nullptr ? getNormalisationGain(track->analysis) : 0.0 };
+	gainRamp.setTargetValue(targetGain.load() * Decibels::decibelsToGain((float) normalisation));
+	if (gainRamp.isSmoothing())
+	{
+		const float startGain{ gainRamp.getCurrentValue() };
+		const float endGain{ gainRamp.skip(bufferToFill.numSamples) };
+		for (int ch = 0; ch < bufferToFill.buffer->getNumChannels(); ++ch)
+			bufferToFill.buffer->applyGainRamp(ch, bufferToFill.startSample, bufferToFill.numSamples, startGain, endGain);
+	}
+	else if (gainRamp.getTargetValue() != 1.0f)
+	{
+		bufferToFill.buffer->applyGain(bufferToFill.startSample, bufferToFill.numSamples, gainRamp.getTargetValue());
+	}
+
+	if (transportSource.isPlaying())
+	{
+		stoppedSamples.store(0);
+		heardPosition.store(getHeardPosition());
+	}
+	else
+		stoppedSamples.store(jmin(tailSamples, stoppedSamples.load() + bufferToFill.numSamples));
+}
+
+void DJAudioPlayer::releaseResources()
+{
+	equaliser.releaseResources();
+}
+
+/* true once the deck is stopped and its fade, stretcher and resampler tails have played out */
+bool DJAudioPlayer::isIdle() const
+{
+	return !transportSource.isPlaying() && stoppedSamples.load() >= tailSamples;
+}
+
+/* swaps in a track opened by TrackLoader, never blocks on the audio thread. the beat grid and hot cues go with it */
+void DJAudioPlayer::loadTrack(LoadedTrack::Ptr track, const TrackAnalysis& analysis, const HotCues& hotCues)
+{
+	if (track != nullptr)
+	{
+		track->analysis = analysis;
+		track->hotCues = hotCues;
+	}
+	trackSource.setTrack(track);
+	updateResamplingRatio();
+	DBG("DJAudioPlayer::loadTrack: track handed to audio thread");
+}
+
+double DJAudioPlayer::getNormalisationGain()
+{
+	auto* track = trackSource.getTrack();
+	return track != nullptr ? getNormalisationGain(track->analysis) : 0.0;
+}
+
+/* the gain that brings the track to the reference loudness, but no further than its true peak allows.
+   a loud master is turned down all the way, a quiet one only turned up as far as its headroom goes */
+double DJAudioPlayer::getNormalisationGain(const TrackAnalysis& analysis)
+{
+	if ((analysis.measured & TrackAnalysis::loudnessMeasured) == 0)
+		return 0.0;
+
+	const double gain{ jmin(referenceLoudness - analysis.loudness, truePeakCeiling - analysis.truePeak) };
+	return jlimit(-maxNormalisation, maxNormalisation, gain);
+}
+
+/* settings the track loader uses to prepare tracks for this deck */
+TrackLoader::LoadOptions DJAudioPlayer::getLoadOptions()
+{
+	TrackLoader::LoadOptions options;
+	options.readAheadSamples = readAheadSamples;
+	options.blockSize = trackSource.getBlockSize();
+	options.decodeToRam = decodeToRam;
+	if (globalSampleRate > 0)
+		options.sampleRate = globalSampleRate;
+	return options;
+}
+
+/* the track most recently loaded, nullptr if there is none */
+LoadedTrack::Ptr DJAudioPlayer::getTrack()
+{
+	return trackSource.getTrack();
+}
+
+//==============================================================================
+HotCues DJAudioPlayer::getHotCues()
+{
+	auto* track = trackSource.getTrack();
+	return track != nullptr ? track->hotCues : HotCues{};
+}
+
+/* while playing the cue goes where the output has got to rather than where the source has read ahead to */
+int64 DJAudioPlayer::setHotCue(int slot)
+{
+	auto* track = trackSource.getTrack();
+	if (track == nullptr || !isPositiveAndBelow(slot, HotCues::numSlots))
+		return HotCues::empty;
+
+	const int64 position{ isPlaying() ? (int64) std::llround(heardPosition.load()) : trackSource.getNextReadPosition() };
+	track->hotCues.positions[(size_t) slot] = jlimit((int64) 0, jmax((int64) 0, track->lengthInSamples - 1), position);
+	track->pruneCueAudio();
+	DBG("DJAudioPlayer::setHotCue: " << slot << " at sample " << track->hotCues.positions[(size_t) slot]);
+	return track->hotCues.positions[(size_t) slot];
+}
+
+void DJAudioPlayer::clearHotCue(int slot)
+{
+	auto* track = trackSource.getTrack();
+	if (track == nullptr || !isPositiveAndBelow(slot, HotCues::numSlots))
+		return;
+
+	track->hotCues.positions[(size_t) slot] = HotCues::empty;
+	track->pruneCueAudio();
+}
+
+/* plays from the cue's decoded audio when the track loader has it ready, a cue set a moment ago is a plain seek */
+void DJAudioPlayer::triggerHotCue(int slot)
+{
+	auto* track = trackSource.getTrack();
+	if (track == nullptr || !isPositiveAndBelow(slot, HotCues::numSlots))
+		return;
+
+	const int64 position{ track->hotCues.positions[(size_t) slot] };
+	if (position == HotCues::empty)
+		return;
+
+	CueAudio::Ptr cue{ track->getCueAudio(position) };
+	if (cue == nullptr)
+		cue = new CueAudio(track, position, 0);
+	trackSource.jumpTo(cue);
+}
+
+/* starts transportSource audio playback, a follower starts on the sync clock's beat */
+void DJAudioPlayer::start()
+{
+	if (getSyncMode() == SyncEngine::follower && !transportSource.isPlaying())
+		alignToClock();
+	transportSource.start();
+}
+
+/* stops transportSource audio playback */
+void DJAudioPlayer::stop()
+{
+	transportSource.stop();
+}
+
+/* returns true if audio source is playing, false otherwise */
+bool DJAudioPlayer::isPlaying()
+{
+	return transportSource.isPlaying();
+}
+
+/* returns data in seconds about length of track */
+double DJAudioPlayer::getLengthOfTrack()
+{
+	auto* track = trackSource.getTrack();
+	return track != nullptr ? track->getLengthInSeconds() : 0.0;
+}
+
+/* returns current track position in seconds, positions are counted at the file's sample rate */
+double DJAudioPlayer::getCurrentPosition()
+{
+	auto* track = trackSource.getTrack();
+	return track != nullptr ? trackSource.getNextReadPosition() / track->sampleRate : 0.0;
+}
+
+/* returns ratio of current track playback time*/
+double DJAudioPlayer::getPositionRelative()
+{
+	return getCurrentPosition() / getLengthOfTrack();
+}
+
+//==============================================================================
+/* sets position of audioplay back, used in posSlider */
+void DJAudioPlayer::setPosition(double posInSeconds)
+{
+	if (auto* track = trackSource.getTrack())
+		trackSource.setNextReadPosition((int64) (posInSeconds * track->sampleRate));
+}
+
+/* sets relative position of track ie. a truncated slider */
+void DJAudioPlayer::setPositionRelative(double pos)
+{
+	if (pos < 0 || pos > 1.0)
+	{
+		DBG("DJAudioPlayer::setPositionRelative: position is out of set range");
+	}
+	else
+	{
+		double posInSeconds = getLengthOfTrack() * pos;
+		setPosition(posInSeconds);
+	}
+}
+
+/* set volume of the audio track */
+void DJAudioPlayer::setGain(double gain)
+{
+	if (gain < 0 || gain > 2.0)
+	{
+		DBG("DJAudioPlayer::setGain: gain is out of set range");
+	}
+	else
+	{
+		targetGain.store((float) gain);
+	}
+}
+
+/* set playback speed of the track */
+void DJAudioPlayer::setSpeed(double ratio)
+{
+	if (ratio < 0 || ratio > 100.0)
+	{
+		DBG("DJAudioPlayer::setSpeed: speed is out of set range");
+	}
+	else
+	{
+		speedRatio = ratio;
+		updateResamplingRatio();
+	}
+}
+
+/* returns true if toggle was successful, looping is off by default */
+bool DJAudioPlayer::toggleLooping()
+{
+	if (trackSource.getTrack() != nullptr) // check audiosource exists
+	{
+		if (!trackSource.isLooping())
+		{
+			trackSource.setLooping(true);
+			DBG("DJAudioPlayer::toggleLooping: looping toggled ON");
+			return true;
+		}
+		else
+		{
+			trackSource.setLooping(false);
+			DBG("DJAudioPlayer::toggleLooping: looping toggled OFF");
+		}
+	}
+	return false;
+}
+
+/* sets how many samples are decoded ahead of playback, applies to the next loaded track */
+void DJAudioPlayer::setReadAheadSize(int numSamples)
+{
+	readAheadSamples = jmax(0, numSamples);
+}
+
+/* returns read-ahead buffer size in samples, 0 means decoding on the audio thread */
+int DJAudioPlayer::getReadAheadSize()
+{
+	return readAheadSamples;
+}
+
+/* returns the number of audio blocks played before the read-ahead buffer was ready */
+int DJAudioPlayer::getUnderrunCount()
+{
+	return trackSource.getUnderrunCount();
+}
+
+/* choose between streaming from disk and decoding the whole track to RAM, applies to the next load */
+void DJAudioPlayer::setDecodeToRam(bool shouldDecode)
+{
+	decodeToRam = shouldDecode;
+}
+
+bool DJAudioPlayer::getDecodeToRam()
+{
+	return decodeToRam;
+}
+
+/* combines the speed slider with the correction from the file's sample rate to the device rate */
+void DJAudioPlayer::updateResamplingRatio()
+{
+	auto* track = trackSource.getTrack();
+	double rateCorrection{ 1.0 };
+	if (track != nullptr && globalSampleRate > 0)
+		rateCorrection = track->sampleRate / globalSampleRate;
+
+	// with key lock on the stretcher changes the tempo and the resampler only converts the sample rate.
+	// only the audio thread touches resampleSource and the stretcher's tempo, it ramps towards this
+	const bool keyLock{ timeStretcher.isEnabled() };
+	targetRatio.store((keyLock ? 1.0 : speedRatio.load()) * rateCorrection);
+}
+
+//==============================================================================
+/* off, following the sync clock or being the master that drives it, see SyncEngine */
+void DJAudioPlayer::setSyncMode(int mode)
+{
+	if (mode == SyncEngine::master)
+		syncEngine.setMaster(this);
+	else if (syncEngine.getMaster() == this)
+		syncEngine.setMaster(nullptr);
+
+	syncMode.store(mode);
+	DBG("DJAudioPlayer::setSyncMode: " << mode);
+}
+
+/* another deck taking over as master leaves this one following it */
+int DJAudioPlayer::getSyncMode()
+{
+	const int mode{ syncMode.load() };
+	return mode == SyncEngine::master && syncEngine.getMaster() != this ? (int) SyncEngine::follower : mode;
+}
+
+bool DJAudioPlayer::hasBeatGrid()
+{
+	auto* track = trackSource.getTrack();
+	return track != nullptr && track->analysis.bpm > 0;
+}
+
+double DJAudioPlayer::getSpeed()
+{
+	const double synced{ syncedSpeed.load() };
+	return synced > 0 ? synced : speedRatio.load();
+}
+
+double DJAudioPlayer::getSyncOffset()
+{
+	return syncOffset.load();
+}
+
+/* the track position the deck's output has got to, in samples of the track. whatever the stretcher and resampler
+   have read ahead is taken off the source's read position, so it is exact whatever the block size */
+double DJAudioPlayer::getHeardPosition() const
+{
+	return trackSource.getNextReadPosition() - timeStretcher.getBufferedInput(resampleSource.getBufferedInput());
+}
+
+/* the track's beats per second at its own speed, doubled or halved when that is nearer the clock,
+   so a half time track can follow a double time one */
+double DJAudioPlayer::getBeatsPerSecond(const TrackAnalysis& analysis, double clockBeatsPerSecond)
+{
+	double beatsPerSecond{ analysis.bpm / 60.0 };
+	if (clockBeatsPerSecond > beatsPerSecond * MathConstants<double>::sqrt2)
+		beatsPerSecond *= 2.0;
+	else if (clockBeatsPerSecond * MathConstants<double>::sqrt2 < beatsPerSecond)
+		beatsPerSecond *= 0.5;
+	return beatsPerSecond;
+}
+
+/* audio thread, picks this block's speed so the deck's beat lands on the clock's. the error is measured from
+   where the audio really is every block, so a follower's error never builds up however long it plays */
+void DJAudioPlayer::followClock(const LoadedTrack& track)
+{
+	const double clockTempo{ syncEngine.getBeatsPerSample() };
+	const double beatsPerSecond{ getBeatsPerSecond(track.analysis, clockTempo * globalSampleRate) };
+	const double beat{ (getHeardPosition() / track.sampleRate - track.analysis.firstBeat) * beatsPerSecond };
+
+	// pulled to the nearest beat of the clock, never more than half a beat either way
+	double error{ syncEngine.getBeat() - beat };
+	error -= std::round(error);
+
+	// taken out over a quarter of a second, bending the tempo no more than a hand on the platter would
+	const double maxBend{ clockTempo * 0.04 };
+	const double tempo{ clockTempo + jlimit(-maxBend, maxBend, error / (0.25 * globalSampleRate)) };
+	const double speed{ jlimit(0.25, 4.0, tempo * globalSampleRate / beatsPerSecond) };
+	syncedSpeed.store(speed);
+	syncOffset.store(error / (clockTempo * globalSampleRate) * 1000.0);
+
+	const double rateCorrection{ track.sampleRate / globalSampleRate };
+	double ratio{ speed * rateCorrection };
+	if (timeStretcher.isEnabled())
+	{
+		timeStretcher.setTempo(speed);
+		ratio = rateCorrection;
+	}
+	ratioRamp.setCurrentAndTargetValue(ratio);
+	resampleSource.setResamplingRatio(ratio);
+}
+
+/* audio thread, the master tells the clock where its beat is now the block has been rendered */
+void DJAudioPlayer::publishBeat()
+{
+	auto* track = trackSource.getActiveTrack();
+	if (track == nullptr || track->analysis.bpm <= 0)
+		return;
+
+	const double rateCorrection{ track->sampleRate / globalSampleRate };
+	const double speed{ timeStretcher.isEnabled() ? speedRatio.load() : ratioRamp.getCurrentValue() / rateCorrection };
+	const double beatsPerSecond{ track->analysis.bpm / 60.0 };
+	syncEngine.publishMasterBeat((getHeardPosition() / track->sampleRate - track->analysis.firstBeat) * beatsPerSecond,
+								 speed * beatsPerSecond / globalSampleRate);
+}
+
+/* a follower starting from still jumps to the clock's nearest beat, the audio thread bends out what is left */
+void DJAudioPlayer::alignToClock()
+{
+	auto* track = trackSource.getTrack();
+	const double clockTempo{ syncEngine.getBeatsPerSample() };
+	if (track == nullptr || track->analysis.bpm <= 0 || clockTempo <= 0 || globalSampleRate <= 0)
+		return;
+
+	const double beatsPerSecond{ getBeatsPerSecond(track->analysis, clockTempo * globalSampleRate) };
+	double error{ syncEngine.getBeat() - (getCurrentPosition() - track->analysis.firstBeat) * beatsPerSecond };
+	error -= std::round(error);
+
+	double position{ getCurrentPosition() + error / beatsPerSecond };
+	if (position < 0)
+		position += 1.0 / beatsPerSecond;
+	setPosition(position);
+}
+
+/* switches between varispeed and key lock, where the speed slider keeps the pitch */
+void DJAudioPlayer::setKeyLock(bool shouldLock)
+{
+	timeStretcher.setEnabled(shouldLock);
+	updateResamplingRatio();
+	DBG("DJAudioPlayer::setKeyLock: " << (shouldLock ? "on" : "off"));
+}
+
+bool DJAudioPlayer::getKeyLock()
+{
+	return timeStretcher.isEnabled();
+}
+
+/* trades key lock sound quality against CPU, see TimeStretcher::Quality */
+void DJAudioPlayer::setKeyLockQuality(int quality)
+{
+	timeStretcher.setQuality(quality);
+}
+
+int DJAudioPlayer::getKeyLockQuality()
+{
+	return timeStretcher.getQuality();
+}
+
+/* picks the resampler's interpolation kernel, see DeckResampler::Kernel */
+void DJAudioPlayer::setResamplerKernel(int kernel)
+{
+	resampleSource.setKernel(kernel);
+}
+
+int DJAudioPlayer::getResamplerKernel()
+{
+	return resampleSource.getKernel();
+}
+
+/* the kernel being used right now, automatic switches between linear and sinc */
+int DJAudioPlayer::getActiveResamplerKernel()
+{
+	return resampleSource.getActiveKernel();
+}
+
+/* measured cost of a resampler kernel in nanoseconds per output sample */
+double DJAudioPlayer::getResamplerCost(int kernel)
+{
+	return resampleSource.getCpuCost(kernel);
+}
+
+//==============================================================================
+/* sets lowpass (negative) or highpass (positive) cutoff for freqSlider, 0 turns the filter off */
+void DJAudioPlayer::setFrequency(double frequency = 0)
+{
+	equaliser.setFilterFrequency(frequency);
+	DBG("DJAudioPlayer::setFrequency: frequency: " << frequency);
+}
+
+/* sets gain factor of the low shelf */
+void DJAudioPlayer::setLowShelf(double gainFactor = 1.0)
+{
+	equaliser.setStageGain(DeckEqualiser::lowShelfStage, (float) gainFactor);
+	DBG("DJAudioPlayer::setLowShelf: gainFactor: " << gainFactor);
+}
+
+/* sets gain factor of the peak filter */
+void DJAudioPlayer::setPeakFilter(double gainFactor = 1.0)
+{
+	equaliser.setStageGain(DeckEqualiser::peakStage, (float) gainFactor);
+	DBG("DJAudioPlayer::setPeakFilter: gainFactor: " << gainFactor);
+}
+
+/* sets gain factor of the high shelf */
+void DJAudioPlayer::setHighShelf(double gainFactor = 1.0)
+{
+	equaliser.setStageGain(DeckEqualiser::highShelfStage, (float) gainFactor);
+	DBG("DJAudioPlayer::setHighShelf: gainFactor: " << gainFactor);
 }
\ No newline at end of file
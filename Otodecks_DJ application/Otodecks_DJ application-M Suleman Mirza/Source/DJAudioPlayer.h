@@ -1,62 +1,145 @@
-/*
-  ==============================================================================
-
-    DJAudioPlayer.h
-    Created: 15th January 2023 - 5:30 PM
-	Author:  Muhammad Suleman Mirza
-
-  ==============================================================================
-*/
-
-#pragma once
-#include <JuceHeader.h>
-#include <string>
-
-/* class that contains the various functions of handling audio data */
-
-class DJAudioPlayer : public juce::AudioSource
-{
-    public:
-        DJAudioPlayer(juce::AudioFormatManager& _formatManager);
-        ~DJAudioPlayer();
-
-        //==============================================================================
-        void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
-        void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
-        void releaseResources() override;
-        bool loadURL(juce::URL audioURL);
-
-        // audio getter functions
-        void start();
-        void stop();
-        bool isPlaying();
-        double getLengthOfTrack();
-        double getLengthAudioURL(juce::URL audioURL);
-        double getCurrentPosition();
-        double getPositionRelative();
-        
-        // audio setter functions
-        void setPosition(double posInSeconds);
-        void setPositionRelative(double pos);
-        void setGain(double gain);
-        void setSpeed(double ratio);
-        bool toggleLooping();
-
-        // IIRFilter filter passes
-        void setFrequency(double frequency);
-        void setLowShelf(double frequency);
-        void setPeakFilter(double frequency);
-        void setHighShelf(double frequency);
-
-private:
-    // load audio file dependency classes
-    juce::AudioFormatManager& formatManager;
-    std::unique_ptr<AudioFormatReaderSource> readerSource;
-    juce::AudioTransportSource transportSource;
-    juce::ResamplingAudioSource resampleSource{ &transportSource, false, 2 };
-    juce::IIRFilterAudioSource filterSource {&resampleSource, false};
-    juce::IIRFilterAudioSource lowSource{ &filterSource , false };
-    juce::IIRFilterAudioSource midSource{ &lowSource , false };
-    juce::IIRFilterAudioSource highSource{ &midSource , false };
-    double globalSampleRate;
+/*
+  ==============================================================================
+
+    DJAudioPlayer.h
+    Created: 15th January 2023 - 5:30 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "TrackSource.h"
+#include "DeckEqualiser.h"
+#include "TimeStretcher.h"
+#include "DeckResampler.h"
+#include "ParallelMixer.h"
+#include "SyncEngine.h"
+#include <atomic>
+#include <string>
+
+/* class that contains the various functions of handling audio data */
+
+class DJAudioPlayer : public ParallelMixer::Input
+{
+    public:
+        DJAudioPlayer(juce::AudioFormatManager& _formatManager, SyncEngine& _syncEngine);
+        ~DJAudioPlayer();
+
+        //==============================================================================
+        void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+        void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+        void releaseResources() override;
+        bool isIdle() const override;
+        void loadTrack(LoadedTrack::Ptr track, const TrackAnalysis& analysis,   // analysis is the library's beat grid and loudness
+                       const HotCues& hotCues = {});
+        TrackLoader::LoadOptions getLoadOptions();
+        LoadedTrack::Ptr getTrack();
+
+        // audio getter functions
+        void start();
+        void stop();
+        bool isPlaying();
+        double getLengthOfTrack();
+        double getCurrentPosition();
+        double getPositionRelative();
+        
+        // audio setter functions
+        void setPosition(double posInSeconds);
+        void setPositionRelative(double pos);
+        void setGain(double gain);   // the fader, after the normalisation gain
+        void setSpeed(double ratio);
+        bool toggleLooping();
+
+        // tempo sync, a SyncEngine::Mode. a follower without a beat grid or a master to follow keeps its own speed
+        void setSyncMode(int mode);
+        int getSyncMode();
+        bool hasBeatGrid();
+        double getSpeed();        // the speed the deck is really playing at, the sync clock's while following
+        double getSyncOffset();   // milliseconds the deck's beat is behind the clock's, while following
+
+        // hot cues of the loaded track. setting one marks the sample being heard and returns it, or HotCues::empty
+        // without a track. a jump is taken at the start of the next audio block, to the sample
+        HotCues getHotCues();
+        juce::int64 setHotCue(int slot);
+        void clearHotCue(int slot);
+        void triggerHotCue(int slot);
+
+        // decibels the loaded track is turned up or down by to play at referenceLoudness, zero if its loudness was never measured
+        double getNormalisationGain();
+
+        // read-ahead buffering, decoded on the shared read-ahead thread
+        void setReadAheadSize(int numSamples);
+        int getReadAheadSize();
+        int getUnderrunCount();
+
+        // decode whole tracks into the shared RAM cache so seeking is instant
+        void setDecodeToRam(bool shouldDecode);
+        bool getDecodeToRam();
+
+        // key lock changes tempo without changing pitch, quality is a TimeStretcher::Quality
+        void setKeyLock(bool shouldLock);
+        bool getKeyLock();
+        void setKeyLockQuality(int quality);
+        int getKeyLockQuality();
+
+        // resampler interpolation, a DeckResampler::Kernel
+        void setResamplerKernel(int kernel);
+        int getResamplerKernel();
+        int getActiveResamplerKernel();
+        double getResamplerCost(int kernel);
+
+        // filter and EQ, ramped on the audio thread so slider moves never click
+        void setFrequency(double frequency);
+        void setLowShelf(double frequency);
+        void setPeakFilter(double frequency);
+        void setHighShelf(double frequency);
+
+private:
+    // load audio file dependency classes
+    juce::AudioFormatManager& formatManager;
+    SyncEngine& syncEngine;
+    TrackSource trackSource;
+    juce::AudioTransportSource transportSource;
+    TimeStretcher timeStretcher{ &transportSource };
+    DeckResampler resampleSource{ &timeStretcher };
+    DeckEqualiser equaliser{ &resampleSource };
+    double globalSampleRate;
+    std::atomic<double> speedRatio;
+    int readAheadSamples;
+    bool decodeToRam;
+
+    // written by the GUI, ramped towards by the audio thread
+    std::atomic<float> targetGain{ 1.0f };
+    std::atomic<double> targetRatio{ 1.0 };
+    juce::SmoothedValue<float> gainRamp{ 1.0f };
+    juce::SmoothedValue<double> ratioRamp{ 1.0 };
+
+    // the sync mode asked for, and what following the sync clock last did. the speed is zero when the deck was not following
+    std::atomic<int> syncMode{ SyncEngine::off };
+    std::atomic<double> syncedSpeed{ 0.0 };
+    std::atomic<double> syncOffset{ 0.0 };
+
+    // where the output had got to at the end of the last block rendered while playing, in samples of the track
+    std::atomic<double> heardPosition{ 0.0 };
+
+    // tracks are normalised towards this loudness, without their true peak going over the ceiling
+    static constexpr double referenceLoudness{ -14.0 };   // LUFS
+    static constexpr double truePeakCeiling{ -1.0 };      // dBTP
+    static constexpr double maxNormalisation{ 12.0 };     // dB either way
+
+    // silence rendered since the transport stopped, the mixer skips the deck once the chain has flushed its tail
+    static constexpr int tailSamples{ 16384 };
+    std::atomic<int> stoppedSamples{ tailSamples };
+
+    void updateResamplingRatio();
+    static double getNormalisationGain(const TrackAnalysis& analysis);
+
+    // tempo sync, the audio thread's side apart from alignToClock()
+    double getHeardPosition() const;
+    static double getBeatsPerSecond(const TrackAnalysis& analysis, double clockBeatsPerSecond);
+    void followClock(const LoadedTrack& track);
+    void publishBeat();
+    void alignToClock();
 };
\ No newline at end of file
@@ -0,0 +1,247 @@
+/*
+  ==============================================================================
+
+	DeckEqualiser.cpp
+	Created: 17th October 2026 - 04:50 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#include "DeckEqualiser.h"
+using namespace juce;
+
+namespace
+{
+	// designed in double precision, the coefficients go into the stages unrounded
+	using Design = dsp::IIR::ArrayCoefficients<double>;
+}
+
+//==============================================================================
+/* the deck's filter and three band EQ as one cascade of biquads, processed in a single pass over the buffer.
+   the GUI only publishes target settings, coefficients are ramped and recalculated on the audio thread */
+
+DeckEqualiser::DeckEqualiser(AudioSource* _input) :
+	input{ _input }
+{
+	for (int stage = 0; stage < numStages; ++stage)
+	{
+		targetGains[stage].store(1.0f);
+		gains[stage].setCurrentAndTargetValue(1.0f);
+		resetState(stage);
+	}
+}
+
+DeckEqualiser::~DeckEqualiser()
+{
+}
+
+void DeckEqualiser::prepareToPlay(int samplesPerBlockExpected, double newSampleRate)
+{
+	input->prepareToPlay(samplesPerBlockExpected, newSampleRate);
+	sampleRate = newSampleRate;
+
+	// ramps long enough to hide slider steps, short enough to feel immediate
+	filterFrequency.reset(sampleRate, 0.05);
+	for (auto& gain : gains)
+		gain.reset(sampleRate, 0.05);
+
+	// the coefficients were made for the old sample rate
+	for (int stage = 0; stage < numStages; ++stage)
+	{
+		stages[stage].designedFor = -1.0;
+		resetState(stage);
+	}
+}
+
+void DeckEqualiser::releaseResources()
+{
+	input->releaseResources();
+}
+
+/* pulls the next block from the input and runs every active stage over it, a sub-block at a time */
+void DeckEqualiser::getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill)
+{
+	input->getNextAudioBlock(bufferToFill);
+
+	const int numChannels{ jmin(bufferToFill.buffer->getNumChannels(), maxChannels) };
+	const int lanes{ (int) Lanes::SIMDNumElements };
+	float* channels[maxChannels];
+
+	for (int offset = 0; offset < bufferToFill.numSamples; offset += subBlockSize)
+	{
+		const int numSamples{ jmin(subBlockSize, bufferToFill.numSamples - offset) };
+		updateCoefficients(numSamples);
+
+		for (int ch = 0; ch < numChannels; ++ch)
+			channels[ch] = bufferToFill.buffer->getWritePointer(ch, bufferToFill.startSample + offset);
+
+		for (int group = 0; group * lanes < numChannels; ++group)
+		{
+			const int firstChannel{ group * lanes };
+			processGroup(channels + firstChannel, jmin(lanes, numChannels - firstChannel), numSamples, states[group]);
+		}
+	}
+}
+
+/* filters up to one register's worth of channels, each sample goes through the whole cascade at once */
+void DeckEqualiser::processGroup(float* const* channels, int numChannels, int numSamples, std::array<State, numStages>& state)
+{
+	int activeStages[numStages];
+	int numActive{ 0 };
+	for (int stage = 0; stage < numStages; ++stage)
+		if (stages[stage].active)
+			activeStages[numActive++] = stage;
+
+	// everything at unity, the input passes through untouched
+	if (numActive == 0)
+		return;
+
+	ScopedNoDenormals noDenormals;
+	alignas(Lanes::SIMDRegisterSize) double frame[Lanes::SIMDNumElements] = {};
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		for (int ch = 0; ch < numChannels; ++ch)
+			frame[ch] = channels[ch][i];
+
+		Lanes x = Lanes::fromRawArray(frame);
+		for (int n = 0; n < numActive; ++n)
+		{
+			const Biquad& bq = stages[activeStages[n]];
+			State& st = state[activeStages[n]];
+
+			Lanes y = bq.b0 * x + st.z1;
+			st.z1 = bq.b1 * x - bq.a1 * y + st.z2;
+			st.z2 = bq.b2 * x - bq.a2 * y;
+			x = y;
+		}
+		x.copyToRawArray(frame);
+
+		for (int ch = 0; ch < numChannels; ++ch)
+			channels[ch][i] = (float) frame[ch];
+	}
+}
+
+//==============================================================================
+/* publishes the freqSlider setting, the audio thread sweeps the cutoff towards it */
+void DeckEqualiser::setFilterFrequency(double frequency)
+{
+	targetFilterFrequency.store(frequency);
+}
+
+/* publishes a shelf or peak gain factor, the audio thread ramps towards it */
+void DeckEqualiser::setStageGain(int stage, float gainFactor)
+{
+	jassert(stage != filterStage && isPositiveAndBelow(stage, (int) numStages));
+	targetGains[stage].store(gainFactor);
+}
+
+/* advances every ramp by one sub-block and recalculates coefficients from where they have got to,
+   a stage's setting that has not moved since its coefficients were made needs none of the trigonometry */
+void DeckEqualiser::updateCoefficients(int numSamples)
+{
+	updateFilterStage(numSamples);
+
+	const double Q{ 1.0 / MathConstants<double>::sqrt2 };
+	for (int stage = lowShelfStage; stage < numStages; ++stage)
+	{
+		auto& gain = gains[stage];
+		gain.setTargetValue(targetGains[stage].load());
+		const float gainFactor{ gain.skip(numSamples) };
+
+		// a gain factor of exactly 1 is a flat response, drop the stage once the ramp has settled there
+		if (!gain.isSmoothing() && gainFactor == 1.0f)
+		{
+			stages[stage].active = false;
+			continue;
+		}
+
+		if (stages[stage].active && stages[stage].designedFor == gainFactor)
+			continue;
+
+		if (stage == lowShelfStage)
+			setBiquad(stage, Design::makeLowShelf(sampleRate, 300.0, Q, (double) gainFactor), gainFactor);
+		else if (stage == peakStage)
+			setBiquad(stage, Design::makePeakFilter(sampleRate, 3000.0, Q, (double) gainFactor), gainFactor);
+		else
+			setBiquad(stage, Design::makeHighShelf(sampleRate, 4500.0, Q, (double) gainFactor), gainFactor);
+	}
+}
+
+/* sweeps the high or low pass cutoff, turning off means sweeping fully open before leaving the cascade */
+void DeckEqualiser::updateFilterStage(int numSamples)
+{
+	const double target{ targetFilterFrequency.load() };
+	const int wantedType{ target < 0 ? -1 : (target > 0 ? 1 : 0) };
+
+	// switching between low and high pass starts the new filter fully open
+	if (wantedType != 0 && wantedType != filterType)
+	{
+		filterType = wantedType;
+		filterFrequency.setCurrentAndTargetValue(getOpenFrequency(filterType));
+		stages[filterStage].designedFor = -1.0;
+		resetState(filterStage);
+	}
+
+	if (filterType == 0)
+	{
+		stages[filterStage].active = false;
+		return;
+	}
+
+	const double goal{ wantedType == 0 ? getOpenFrequency(filterType) : std::abs(target) };
+	filterFrequency.setTargetValue(jlimit(20.0, getOpenFrequency(-1), goal));
+	const double frequency{ filterFrequency.skip(numSamples) };
+
+	if (wantedType == 0 && !filterFrequency.isSmoothing())
+	{
+		filterType = 0;
+		stages[filterStage].active = false;
+		return;
+	}
+
+	// a held cutoff keeps the coefficients it already has
+	if (stages[filterStage].active && stages[filterStage].designedFor == frequency)
+		return;
+
+	if (filterType < 0)
+		setBiquad(filterStage, Design::makeLowPass(sampleRate, frequency), frequency);
+	else
+		setBiquad(filterStage, Design::makeHighPass(sampleRate, frequency), frequency);
+}
+
+/* cutoff at which the filter is as good as transparent */
+double DeckEqualiser::getOpenFrequency(int type) const
+{
+	return type < 0 ? jmin(20000.0, sampleRate * 0.45) : 20.0;
+}
+
+/* normalises b0, b1, b2, a0, a1, a2 into the stage's registers, a stage coming back in starts from silence */
+void DeckEqualiser::setBiquad(int stage, const Coefficients& c, double designedFor)
+{
+	const double a0{ c[3] };
+	Biquad& bq = stages[stage];
+	bq.designedFor = designedFor;
+	bq.b0 = Lanes::expand(c[0] / a0);
+	bq.b1 = Lanes::expand(c[1] / a0);
+	bq.b2 = Lanes::expand(c[2] / a0);
+	bq.a1 = Lanes::expand(c[4] / a0);
+	bq.a2 = Lanes::expand(c[5] / a0);
+
+	if (!bq.active)
+	{
+		resetState(stage);
+		bq.active = true;
+	}
+}
+
+/* clears the filter memory of one stage in every channel group */
+void DeckEqualiser::resetState(int stage)
+{
+	for (auto& groupState : states)
+	{
+		groupState[stage].z1 = Lanes::expand(0.0);
+		groupState[stage].z2 = Lanes::expand(0.0);
+	}
+}
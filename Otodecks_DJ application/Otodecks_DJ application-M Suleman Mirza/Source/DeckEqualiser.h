@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+	DeckEqualiser.h
+	Created: 17th October 2026 - 04:15 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+//==============================================================================
+/* the deck's filter and three band EQ as one cascade of biquads, processed in a single pass over the buffer.
+   the GUI only publishes target settings, coefficients are ramped and recalculated on the audio thread.
+   a stage whose setting has settled keeps its coefficients, so a held cut costs no more than the filtering */
+
+class DeckEqualiser : public juce::AudioSource
+{
+public:
+	// stages run in this order
+	enum Stage
+	{
+		filterStage = 0,   // high pass or low pass from freqSlider
+		lowShelfStage,
+		peakStage,
+		highShelfStage,
+		numStages
+	};
+
+	DeckEqualiser(juce::AudioSource* _input);
+	~DeckEqualiser() override;
+
+	void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+	void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+	void releaseResources() override;
+
+	// safe to call from any thread, never locks or allocates
+	void setFilterFrequency(double frequency);   // < 0 low pass, > 0 high pass, 0 off
+	void setStageGain(int stage, float gainFactor);   // lowShelfStage, peakStage or highShelfStage
+
+private:
+	// one SIMD lane per channel, coefficients and state in double keep the low shelf stable at small cutoffs
+	using Lanes = juce::dsp::SIMDRegister<double>;
+	using Coefficients = std::array<double, 6>;   // b0, b1, b2, a0, a1, a2 before normalising
+	static constexpr int maxChannels{ 8 };
+	static constexpr int maxGroups{ (maxChannels + (int) Lanes::SIMDNumElements - 1) / (int) Lanes::SIMDNumElements };
+
+	// coefficients are recalculated from the ramped settings this often, while they are still moving
+	static constexpr int subBlockSize{ 32 };
+
+	struct Biquad
+	{
+		Lanes b0, b1, b2, a1, a2;
+		bool active{ false };
+		double designedFor{ -1.0 };   // the gain factor or cutoff the coefficients were made for, -1 for none
+	};
+
+	// transposed direct form II state for every stage and channel group
+	struct State
+	{
+		Lanes z1, z2;
+	};
+
+	void updateCoefficients(int numSamples);
+	void updateFilterStage(int numSamples);
+	void setBiquad(int stage, const Coefficients& c, double designedFor);
+	double getOpenFrequency(int type) const;
+	void processGroup(float* const* channels, int numChannels, int numSamples, std::array<State, numStages>& state);
+	void resetState(int stage);
+
+	juce::AudioSource* input;
+	double sampleRate{ 44100.0 };
+
+	// written by the GUI, read by the audio thread
+	std::atomic<double> targetFilterFrequency{ 0.0 };
+	std::array<std::atomic<float>, numStages> targetGains;
+
+	// audio thread only
+	int filterType{ 0 };   // -1 low pass, 1 high pass, 0 off
+	juce::SmoothedValue<double, juce::ValueSmoothingTypes::Multiplicative> filterFrequency{ 1000.0 };
+	std::array<juce::SmoothedValue<float>, numStages> gains;
+	std::array<Biquad, numStages> stages;
+	std::array<std::array<State, numStages>, maxGroups> states;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DeckEqualiser)
+};
@@ -1,263 +1,494 @@
-/*
-  ==============================================================================
-
-	DeckGUI.cpp
-	Created: 21th January 2023 - 10:16 PM
-	Author:  Muhammad Suleman Mirza
-
-  ==============================================================================
-*/
-
-#include <JuceHeader.h>
-#include "DeckGUI.h"
-using namespace juce;
-
-//==============================================================================
-/* class that handles main GUI components of the DJplayer, mainly buttons and sliders */
-
-DeckGUI::DeckGUI(DJAudioPlayer* _player,
-	AudioFormatManager& formatManagerToUse,
-	AudioThumbnailCache& cacheToUse) :
-	player{ _player },
-	waveformDisplay{ formatManagerToUse, cacheToUse }
-{
-	// timer tick rate
-	startTimer(150);
-
-	// play button
-	playButton.addListener(this);
-	customize.playButton(&playButton);
-
-	// repeat button
-	loopButton.addListener(this);
-	customize.loopButton(&loopButton);
-
-	// load button
-	loadButton.addListener(this);
-	customize.loadButton(&loadButton);
-
-	// vol slider & label
-	volSlider.addListener(this);
-	volLabel.attachToComponent(&volSlider, true);
-	customize.volSlider(&volSlider);
-	customize.volLabel(&volLabel);
-
-	// speed slider & label
-	speedSlider.addListener(this);
-	speedLabel.attachToComponent(&speedSlider, true);
-	customize.speedSlider(&speedSlider);
-	customize.speedLabel(&speedLabel);
-
-	// frequency slider & label
-	freqSlider.addListener(this);
-	freqLabel.attachToComponent(&freqSlider, true);
-	customize.freqSlider(&freqSlider);
-	customize.freqLabel(&freqLabel);
-
-	// playback position slider & label
-	posSlider.addListener(this);
-	posLabel.attachToComponent(&posSlider, true);
-	customize.posSlider(&posSlider);
-	customize.posLabel(&posLabel);
-
-	// IIRF low slider & label
-	lowSlider.addListener(this);
-	lowLabel.attachToComponent(&lowSlider, false);
-	customize.lowSlider(&lowSlider);
-	customize.lowLabel(&lowLabel);
-
-	// IIRF mid slider & label
-	midSlider.addListener(this);
-	midLabel.attachToComponent(&midSlider, false);
-	customize.midSlider(&midSlider);
-	customize.midLabel(&midLabel);
-
-
-	// IIRF high slider & label
-	highSlider.addListener(this);
-	highLabel.attachToComponent(&highSlider, false);
-	customize.highSlider(&highSlider);
-	customize.highLabel(&highLabel);
-
-	// title display label
-	customize.deckTitle(&deckTitle);
-
-	// waveform component
-	addAndMakeVisible(waveformDisplay);
-}
-
-DeckGUI::~DeckGUI()
-{
-	stopTimer();
-}
-
-void DeckGUI::paint(Graphics& gfx)
-{
-	gfx.fillAll(Colours::black.darker(0.7));   // clear the background}
-}
-
-void DeckGUI::resized()
-{
-	double rowH = getHeight() / 11;
-	// buttons, GUI components in format: x,  y,  width,  height
-	loadButton.setBounds(0, 0, getWidth() / 3, rowH);
-	playButton.setBounds(getWidth() / 3, 0, getWidth() / 3, rowH);
-	loopButton.setBounds(getWidth() / 3 * 2, 0, getWidth() / 3, rowH);
-
-	// sliders
-	volSlider.setBounds(50, rowH * 2, getWidth() - 65, rowH);
-	speedSlider.setBounds(50, rowH * 3 - 10, getWidth() - 65, rowH);
-	highSlider.setBounds(getWidth() / 3 * 2, rowH * 4 - 5, getWidth() / 3, rowH * 3 - 5);
-	midSlider.setBounds(getWidth() / 3, rowH * 4 - 5, getWidth() / 3, rowH * 3 - 5);
-	lowSlider.setBounds(0, rowH * 4 - 5, getWidth() / 3, rowH * 3 - 5);
-	freqSlider.setBounds(50, rowH * 7 - 10, getWidth() - 65, rowH);
-	posSlider.setBounds(50, getHeight() - rowH, getWidth() - 65, rowH);
-
-	// labels
-	deckTitle.setBounds(0, rowH + 8, getWidth(), rowH);
-	highLabel.setBounds(getWidth() / 3 * 2, rowH * 4, getWidth() / 3, rowH * 3 - 28);
-	midLabel.setBounds(getWidth() / 3, rowH * 4, getWidth() / 3, rowH * 3 - 28);
-	lowLabel.setBounds(0, rowH * 4, getWidth() / 3, rowH * 3 - 28);
-
-	// waveform
-	waveformDisplay.setBounds(0, getHeight() - rowH * 3, getWidth(), rowH * 2);
-}
-
-/* checks which button is clicked by validating pointer address */
-void DeckGUI::buttonClicked(Button* button)
-{
-	if (button == &playButton)
-	{
-		togglePlayButton();
-	}
-	if (button == &loopButton)
-	{
-		toggleLoopButton();
-	}
-	if (button == &loadButton)
-	{
-		// opens file browser and parses selected files
-		auto fileChooserFlags = FileBrowserComponent::canSelectFiles;
-		fChooser.launchAsync(fileChooserFlags, [this](const FileChooser& chooser)
-			{
-				auto chosenFile = chooser.getResult();
-
-				// call both audio player and waveform display functions
-				if (player->loadURL(URL{ chosenFile })) {
-					playButton.setButtonText("Play");
-				}
-				waveformDisplay.loadURL(URL{ chosenFile });
-				deckTitle.setText(chosenFile.getFileNameWithoutExtension(), dontSendNotification);
-			});
-	}
-}
-
-/* checks if audio source is currently playing, toggles playButton */
-void DeckGUI::togglePlayButton()
-{
-	if (!player->isPlaying())
-	{
-		if (posSlider.getValue() >= posSlider.getMaximum() - 2)
-		{
-			// rewind slider if finishing playing
-			posSlider.setValue(0.0);
-		}
-		player->start();
-		DBG("Play Start");
-	}
-	else
-	{
-		player->stop();
-		DBG("Play Stop");
-	}
-}
-
-/* checks if audio source is set to loop, toggles loopButton */
-void DeckGUI::toggleLoopButton()
-{
-	player->toggleLooping() ? loopButton.setButtonText("Loop: On") : loopButton.setButtonText("Loop: Off");
-}
-
-/* listener handler for slider components, identified by reference */
-void DeckGUI::sliderValueChanged(Slider* slider)
-{
-	if (slider == &volSlider)
-	{
-		// set volume
-		player->setGain(slider->getValue());
-	}
-	if (slider == &speedSlider)
-	{
-		// set playback speed
-		player->setSpeed(slider->getValue());
-	}
-	if (slider == &posSlider)
-	{
-		// set time in seconds of the track
-		player->setPosition(slider->getValue());
-		if (player->isPlaying())
-		{
-			// set slider value to length of track
-			posSlider.setRange(0.0, player->getLengthOfTrack());
-			posSlider.setNumDecimalPlacesToDisplay(2);
-		}
-	}
-	if (slider == &freqSlider)
-	{
-		// set frequency
-		player->setFrequency(slider->getValue());
-	}
-	if (slider == &highSlider)
-	{
-		// set low pass frequency
-		player->setHighShelf(slider->getValue());
-	}
-	if (slider == &midSlider)
-	{
-		// set low pass frequency
-		player->setPeakFilter(slider->getValue());
-	}
-	if (slider == &lowSlider)
-	{
-		// set low pass frequency
-		player->setLowShelf(slider->getValue());
-	}
-}
-
-bool DeckGUI::isInterestedInFileDrag(const StringArray& files)
-{
-	// allows for dragging of files into player window
-	DBG("DeckGUI::isInterestedInFileDrag");
-	return true;
-}
-
-void DeckGUI::filesDropped(const StringArray& files, int x, int y)
-{
-	// list of selected items stored as str array "files"
-	for (String filename : files)
-	{
-		DBG("DeckGUI::filesDropped " << filename);
-	}
-	if (files.size() >= 1)
-	{
-		// add to table list instead
-		// perhaps add to main component or allow drag in table
-		player->loadURL(juce::URL{ File{files[0]} });
-		waveformDisplay.loadURL(URL{ File{files[0]} });
-		deckTitle.setText(File{ files[0] }.getFileNameWithoutExtension(), dontSendNotification);
-	}
-}
-
-/* timer function to continually update audio callback */
-void DeckGUI::timerCallback()
-{
-	if (!isnan(player->getPositionRelative()) && player->isPlaying())
-	{
-		// move posSlider together according to track position 
-		waveformDisplay.setPositionRelative(player->getPositionRelative());
-		posSlider.setValue(player->getCurrentPosition());
-		playButton.setButtonText("Stop");
-	}
-	else
-		playButton.setButtonText("Play");
-}
+/*
+  ==============================================================================
+
+	DeckGUI.cpp
+	Created: 21th January 2023 - 10:16 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "DeckGUI.h"
+using namespace juce;
+
+//==============================================================================
+/* class that handles main GUI components of the DJplayer, mainly buttons and sliders */
+
+DeckGUI::DeckGUI(DJAudioPlayer* _player,
+	TrackLoader& trackLoaderToUse) :
+	player{ _player },
+	trackLoader{ trackLoaderToUse }
+{
+	// timer tick rate
+	startTimer(150);
+
+	// play button
+	playButton.addListener(this);
+	customize.playButton(&playButton);
+
+	// repeat button
+	loopButton.addListener(this);
+	customize.loopButton(&loopButton);
+
+	// load button
+	loadButton.addListener(this);
+	customize.loadButton(&loadButton);
+
+	// decode to RAM button
+	ramButton.addListener(this);
+	customize.ramButton(&ramButton);
+
+	// key lock button, cycles off and the stretcher quality settings
+	keyLockButton.addListener(this);
+	customize.keyLockButton(&keyLockButton);
+
+	// resampler button, cycles the interpolation kernels
+	resamplerButton.addListener(this);
+	customize.resamplerButton(&resamplerButton);
+
+	// sync button, cycles off, following the master deck and being the master
+	syncButton.addListener(this);
+	customize.syncButton(&syncButton);
+
+	// hot cue buttons, a click sets an empty slot and jumps to a set one
+	for (int slot = 0; slot < HotCues::numSlots; ++slot)
+	{
+		auto* button = hotCueButtons.add(new TextButton());
+		button->addListener(this);
+		customize.hotCueButton(button, slot);
+	}
+
+	// vol slider & label
+	volSlider.addListener(this);
+	volLabel.attachToComponent(&volSlider, true);
+	customize.volSlider(&volSlider);
+	customize.volLabel(&volLabel);
+
+	// speed slider & label
+	speedSlider.addListener(this);
+	speedLabel.attachToComponent(&speedSlider, true);
+	customize.speedSlider(&speedSlider);
+	customize.speedLabel(&speedLabel);
+
+	// frequency slider & label
+	freqSlider.addListener(this);
+	freqLabel.attachToComponent(&freqSlider, true);
+	customize.freqSlider(&freqSlider);
+	customize.freqLabel(&freqLabel);
+
+	// playback position slider & label
+	posSlider.addListener(this);
+	posLabel.attachToComponent(&posSlider, true);
+	customize.posSlider(&posSlider);
+	customize.posLabel(&posLabel);
+
+	// IIRF low slider & label
+	lowSlider.addListener(this);
+	lowLabel.attachToComponent(&lowSlider, false);
+	customize.lowSlider(&lowSlider);
+	customize.lowLabel(&lowLabel);
+
+	// IIRF mid slider & label
+	midSlider.addListener(this);
+	midLabel.attachToComponent(&midSlider, false);
+	customize.midSlider(&midSlider);
+	customize.midLabel(&midLabel);
+
+
+	// IIRF high slider & label
+	highSlider.addListener(this);
+	highLabel.attachToComponent(&highSlider, false);
+	customize.highSlider(&highSlider);
+	customize.highLabel(&highLabel);
+
+	// title display label
+	customize.deckTitle(&deckTitle);
+	customize.statusLabel(&statusLabel);
+
+	// waveform components, the whole track and a zoomed in view that scrolls with it
+	addAndMakeVisible(waveformDisplay);
+	addAndMakeVisible(zoomedWaveform);
+}
+
+DeckGUI::~DeckGUI()
+{
+	stopTimer();
+	if (auto track = player->getTrack())
+		trackLoader.cancelWaveform(track.get());
+}
+
+void DeckGUI::paint(Graphics& gfx)
+{
+	gfx.fillAll(Colours::black.darker(0.7));   // clear the background}
+}
+
+void DeckGUI::resized()
+{
+	double rowH = getHeight() / 12;
+	// buttons, GUI components in format: x,  y,  width,  height
+	loadButton.setBounds(0, 0, getWidth() / 7, rowH);
+	playButton.setBounds(getWidth() / 7, 0, getWidth() / 7, rowH);
+	loopButton.setBounds(getWidth() / 7 * 2, 0, getWidth() / 7, rowH);
+	ramButton.setBounds(getWidth() / 7 * 3, 0, getWidth() / 7, rowH);
+	keyLockButton.setBounds(getWidth() / 7 * 4, 0, getWidth() / 7, rowH);
+	resamplerButton.setBounds(getWidth() / 7 * 5, 0, getWidth() / 7, rowH);
+	syncButton.setBounds(getWidth() / 7 * 6, 0, getWidth() / 7, rowH);
+
+	// sliders
+	volSlider.setBounds(50, rowH * 2, getWidth() - 65, rowH);
+	speedSlider.setBounds(50, rowH * 3 - 10, getWidth() - 65, rowH);
+	highSlider.setBounds(getWidth() / 3 * 2, rowH * 4 - 5, getWidth() / 3, rowH * 3 - 5);
+	midSlider.setBounds(getWidth() / 3, rowH * 4 - 5, getWidth() / 3, rowH * 3 - 5);
+	lowSlider.setBounds(0, rowH * 4 - 5, getWidth() / 3, rowH * 3 - 5);
+	freqSlider.setBounds(50, rowH * 7 - 10, getWidth() - 65, rowH);
+	posSlider.setBounds(50, getHeight() - rowH, getWidth() - 65, rowH);
+
+	// hot cues, a row of them above the waveforms
+	for (int slot = 0; slot < hotCueButtons.size(); ++slot)
+		hotCueButtons[slot]->setBounds(getWidth() * slot / hotCueButtons.size(), getHeight() - rowH * 4,
+									   getWidth() / hotCueButtons.size(), rowH);
+
+	// labels
+	deckTitle.setBounds(0, rowH + 8, getWidth(), rowH - 22);
+	statusLabel.setBounds(0, rowH * 2 - 14, getWidth(), 14);
+	highLabel.setBounds(getWidth() / 3 * 2, rowH * 4, getWidth() / 3, rowH * 3 - 28);
+	midLabel.setBounds(getWidth() / 3, rowH * 4, getWidth() / 3, rowH * 3 - 28);
+	lowLabel.setBounds(0, rowH * 4, getWidth() / 3, rowH * 3 - 28);
+
+	// waveform
+	zoomedWaveform.setBounds(0, getHeight() - rowH * 3, getWidth(), rowH);
+	waveformDisplay.setBounds(0, getHeight() - rowH * 2, getWidth(), rowH);
+}
+
+/* checks which button is clicked by validating pointer address */
+void DeckGUI::buttonClicked(Button* button)
+{
+	if (button == &playButton)
+	{
+		togglePlayButton();
+	}
+	if (button == &loopButton)
+	{
+		toggleLoopButton();
+	}
+	if (button == &ramButton)
+	{
+		// applies to the next track loaded on this deck
+		player->setDecodeToRam(ramButton.getToggleState());
+		ramButton.setButtonText(ramButton.getToggleState() ? "RAM: On" : "RAM: Off");
+	}
+	if (button == &keyLockButton)
+	{
+		cycleKeyLockButton();
+	}
+	if (button == &resamplerButton)
+	{
+		cycleResamplerButton();
+	}
+	if (button == &syncButton)
+	{
+		cycleSyncButton();
+	}
+	for (int slot = 0; slot < hotCueButtons.size(); ++slot)
+	{
+		if (button == hotCueButtons[slot])
+			hotCueClicked(slot);
+	}
+	if (button == &loadButton)
+	{
+		// opens file browser and parses selected files
+		auto fileChooserFlags = FileBrowserComponent::canSelectFiles;
+		fChooser.launchAsync(fileChooserFlags, [this](const FileChooser& chooser)
+			{
+				auto chosenFile = chooser.getResult();
+				if (chosenFile != File{})
+				{
+					loadTrack(URL{ chosenFile }, chosenFile.getFileNameWithoutExtension(), false, {});
+				}
+			});
+	}
+}
+
+/* checks if audio source is currently playing, toggles playButton */
+void DeckGUI::togglePlayButton()
+{
+	if (!player->isPlaying())
+	{
+		if (posSlider.getValue() >= posSlider.getMaximum() - 2)
+		{
+			// rewind slider if finishing playing
+			posSlider.setValue(0.0);
+		}
+		player->start();
+		DBG("Play Start");
+	}
+	else
+	{
+		player->stop();
+		DBG("Play Stop");
+	}
+}
+
+/* asks the track loader for the file, the player and waveform share the result once it is ready.
+   the audio at each hot cue is decoded after it, so the track can start playing before its cues are ready */
+void DeckGUI::loadTrack(URL audioURL, String title, bool togglePlayOnLoad, TrackAnalysis analysis,
+	HotCues hotCues, std::function<void(const HotCues&)> onChanged)
+{
+	deckTitle.setText("Loading " + title + "...", dontSendNotification);
+
+	Component::SafePointer<DeckGUI> safeThis{ this };
+	trackLoader.loadAsync(audioURL, player->getLoadOptions(), [safeThis, title, togglePlayOnLoad, analysis, hotCues, onChanged](LoadedTrack::Ptr track)
+		{
+			if (safeThis == nullptr)
+				return;
+
+			if (track == nullptr)
+			{
+				safeThis->deckTitle.setText("Unable to load " + title, dontSendNotification);
+				return;
+			}
+
+			// a waveform still being built for the track going out is no longer wanted
+			if (auto previous = safeThis->player->getTrack())
+				safeThis->trackLoader.cancelWaveform(previous.get());
+
+			// call both audio player and waveform display functions
+			safeThis->player->loadTrack(track, analysis, hotCues);
+			safeThis->waveformDisplay.loadTrack(track);
+
+			Array<int64> cuePositions;
+			for (auto position : hotCues.positions)
+				if (position != HotCues::empty)
+					cuePositions.add(position);
+			safeThis->trackLoader.decodeCuesAsync(track, cuePositions);
+
+			// a waveform the cache did not have follows once it is built, the track plays in the meantime
+			safeThis->trackLoader.buildWaveformAsync(track, [safeThis](LoadedTrack::Ptr built)
+				{
+					if (safeThis == nullptr || safeThis->player->getTrack() != built)
+						return;
+
+					safeThis->waveformDisplay.setWaveform(built->waveform);
+					safeThis->zoomedWaveform.setWaveform(built->waveform);
+				});
+			safeThis->onHotCuesChanged = onChanged;
+			safeThis->updateHotCueButtons();
+			safeThis->zoomedWaveform.setWaveform(track->waveform);
+			safeThis->deckTitle.setText(title, dontSendNotification);
+
+			if (togglePlayOnLoad)
+				safeThis->togglePlayButton();
+			else
+				safeThis->playButton.setButtonText("Play");
+		});
+}
+
+/* an empty slot is set where the deck is and its audio decoded ahead, a set one is jumped to. shift clears it */
+void DeckGUI::hotCueClicked(int slot)
+{
+	if (player->getTrack() == nullptr)
+		return;
+
+	if (ModifierKeys::getCurrentModifiers().isShiftDown())
+	{
+		player->clearHotCue(slot);
+	}
+	else if (player->getHotCues().positions[(size_t) slot] == HotCues::empty)
+	{
+		const int64 position{ player->setHotCue(slot) };
+		trackLoader.decodeCuesAsync(player->getTrack(), { position });
+	}
+	else
+	{
+		// a stopped deck waits at the cue, the timer only moves the slider while playing
+		player->triggerHotCue(slot);
+		if (!player->isPlaying())
+		{
+			posSlider.setValue(player->getCurrentPosition(), dontSendNotification);
+			waveformDisplay.setPositionRelative(player->getPositionRelative());
+		}
+		return;
+	}
+
+	updateHotCueButtons();
+	if (onHotCuesChanged != nullptr)
+		onHotCuesChanged(player->getHotCues());
+}
+
+/* lit while the slot has a cue in it */
+void DeckGUI::updateHotCueButtons()
+{
+	const HotCues hotCues{ player->getHotCues() };
+	for (int slot = 0; slot < hotCueButtons.size(); ++slot)
+		hotCueButtons[slot]->setToggleState(hotCues.positions[(size_t) slot] != HotCues::empty, dontSendNotification);
+}
+
+/* checks if audio source is set to loop, toggles loopButton */
+void DeckGUI::toggleLoopButton()
+{
+	player->toggleLooping() ? loopButton.setButtonText("Loop: On") : loopButton.setButtonText("Loop: Off");
+}
+
+/* steps key lock through off, fast, normal and high quality */
+void DeckGUI::cycleKeyLockButton()
+{
+	if (!player->getKeyLock())
+	{
+		player->setKeyLockQuality(TimeStretcher::fast);
+		player->setKeyLock(true);
+	}
+	else if (player->getKeyLockQuality() < TimeStretcher::numQualities - 1)
+	{
+		player->setKeyLockQuality(player->getKeyLockQuality() + 1);
+	}
+	else
+	{
+		player->setKeyLock(false);
+	}
+
+	keyLockButton.setButtonText(player->getKeyLock()
+		? "Key: " + TimeStretcher::getQualityName(player->getKeyLockQuality())
+		: "Key: Off");
+}
+
+/* steps the resampler through auto, linear, cubic and sinc */
+void DeckGUI::cycleResamplerButton()
+{
+	const int kernel{ (player->getResamplerKernel() + 1) % DeckResampler::numKernels };
+	player->setResamplerKernel(kernel);
+	resamplerButton.setButtonText("Interp: " + DeckResampler::getKernelName(kernel));
+}
+
+/* steps sync through off, following the master deck and being the master */
+void DeckGUI::cycleSyncButton()
+{
+	player->setSyncMode((player->getSyncMode() + 1) % (SyncEngine::master + 1));
+	updateSyncButton();
+}
+
+/* another deck can take over as master at any time. a follower's speed slider shows the speed sync chose,
+   and a deck that stops following carries on at that speed rather than jumping back */
+void DeckGUI::updateSyncButton()
+{
+	const int mode{ player->getSyncMode() };
+	const String text{ mode == SyncEngine::master ? "Sync: Master" : mode == SyncEngine::follower ? "Sync: On" : "Sync: Off" };
+	if (text != syncButton.getButtonText())
+		syncButton.setButtonText(text);
+
+	const bool following{ mode == SyncEngine::follower && player->hasBeatGrid() };
+	speedSlider.setEnabled(!following);
+	if (following)
+		speedSlider.setValue(player->getSpeed(), dontSendNotification);
+	else if (speedSlider.getValue() != player->getSpeed())
+		player->setSpeed(speedSlider.getValue());
+}
+
+/* listener handler for slider components, identified by reference */
+void DeckGUI::sliderValueChanged(Slider* slider)
+{
+	if (slider == &volSlider)
+	{
+		// set volume
+		player->setGain(slider->getValue());
+	}
+	if (slider == &speedSlider)
+	{
+		// set playback speed
+		player->setSpeed(slider->getValue());
+	}
+	if (slider == &posSlider)
+	{
+		// set time in seconds of the track
+		player->setPosition(slider->getValue());
+		if (player->isPlaying())
+		{
+			// set slider value to length of track
+			posSlider.setRange(0.0, player->getLengthOfTrack());
+			posSlider.setNumDecimalPlacesToDisplay(2);
+		}
+	}
+	if (slider == &freqSlider)
+	{
+		// set frequency
+		player->setFrequency(slider->getValue());
+	}
+	if (slider == &highSlider)
+	{
+		// set low pass frequency
+		player->setHighShelf(slider->getValue());
+	}
+	if (slider == &midSlider)
+	{
+		// set low pass frequency
+		player->setPeakFilter(slider->getValue());
+	}
+	if (slider == &lowSlider)
+	{
+		// set low pass frequency
+		player->setLowShelf(slider->getValue());
+	}
+}
+
+bool DeckGUI::isInterestedInFileDrag(const StringArray& files)
+{
+	// allows for dragging of files into player window
+	DBG("DeckGUI::isInterestedInFileDrag");
+	return true;
+}
+
+void DeckGUI::filesDropped(const StringArray& files, int x, int y)
+{
+	// list of selected items stored as str array "files"
+	for (String filename : files)
+	{
+		DBG("DeckGUI::filesDropped " << filename);
+	}
+	if (files.size() >= 1)
+	{
+		// add to table list instead
+		// perhaps add to main component or allow drag in table
+		loadTrack(URL{ File{files[0]} }, File{ files[0] }.getFileNameWithoutExtension(), false, {});
+	}
+}
+
+/* timer function to continually update audio callback */
+void DeckGUI::timerCallback()
+{
+	if (!isnan(player->getPositionRelative()) && player->isPlaying())
+	{
+		// move posSlider together according to track position 
+		waveformDisplay.setPositionRelative(player->getPositionRelative());
+		posSlider.setValue(player->getCurrentPosition());
+		playButton.setButtonText("Stop");
+	}
+	else
+		playButton.setButtonText("Play");
+
+	updateSyncButton();
+	updateStatusLabel();
+}
+
+/* shows read-ahead underruns for this deck, the shared RAM cache hit rate, the resampler's cost and
+   the loaded track's normalisation gain, only redrawn when they change */
+void DeckGUI::updateStatusLabel()
+{
+	auto& cache = trackLoader.getDecodedCache();
+	const int kernel{ player->getActiveResamplerKernel() };
+	String status{ "Underruns: " + String(player->getUnderrunCount())
+		+ " | RAM cache: " + String(roundToInt(cache.getHitRate() * 100.0)) + "% hits, "
+		+ String((int) (cache.getBytesUsed() / (1024 * 1024))) + " MB"
+		+ " | " + DeckResampler::getKernelName(kernel) + ": " + String(roundToInt(player->getResamplerCost(kernel))) + " ns/sample" };
+
+	const double normalisation{ player->getNormalisationGain() };
+	if (normalisation != 0.0)
+		status += " | Gain: " + String(normalisation > 0.0 ? "+" : "") + String(normalisation, 1) + " dB";
+
+	// how far behind the master's beat a follower is, the reason sync is not working otherwise
+	if (player->getSyncMode() == SyncEngine::follower)
+		status += !player->hasBeatGrid() ? " | Sync: no beat grid"
+			: player->isPlaying() ? " | Sync: " + String(player->getSyncOffset(), 2) + " ms" : String();
+
+	if (status != statusLabel.getText())
+		statusLabel.setText(status, dontSendNotification);
+}
@@ -1,83 +1,107 @@
-/*
-  ==============================================================================
-
-	DeckGUI.h
-	Created: 21th January 2023 - 1:07 PM
-	Author:  Muhammad Suleman Mirza
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include "DJAudioPlayer.h"
-#include "WaveformDisplay.h"
-#include "Customize.h"
-
-//==============================================================================
-/* class that handles main GUI components of the DJplayer, mainly buttons and sliders */
-
-class DeckGUI : public juce::Component,
-	public juce::Button::Listener,
-	public juce::Slider::Listener,
-	public juce::FileDragAndDropTarget,
-	public juce::Timer
-{
-public:
-	DeckGUI(DJAudioPlayer* player,      // listen to audio file
-	juce::AudioFormatManager& formatManagerToUse,
-	juce::AudioThumbnailCache& cacheToUse); // draw waveform
-	~DeckGUI() override;
-
-	void paint(juce::Graphics&) override;
-	void resized() override;
-
-	// implement Button::Listener
-	void buttonClicked(juce::Button* button) override;
-
-	// implement Slider::Listener
-	void sliderValueChanged(juce::Slider* slider) override;
-
-	// implement FileDragAndDropTarget
-	bool isInterestedInFileDrag(const juce::StringArray& files) override;
-	void filesDropped(const juce::StringArray& files, int x, int y) override;
-
-	// implement Timer for changes to the waveform
-	void timerCallback() override;
-
-	// functions to toggle and update button attributes
-	void togglePlayButton();
-	void toggleLoopButton();
-
-	juce::Label deckTitle;
-	DJAudioPlayer* player;
-	WaveformDisplay waveformDisplay;
-
-private:
-	Customize customize { this };
-	
-	juce::TextButton playButton;
-	juce::TextButton loopButton;
-	juce::TextButton loadButton;
-	
-	juce::FileChooser fChooser{ "Select a file..." };
-
-	juce::Slider volSlider;
-	juce::Slider speedSlider;
-	juce::Slider freqSlider;
-	juce::Slider posSlider;
-	juce::Label volLabel;
-	juce::Label speedLabel;
-	juce::Label freqLabel;
-	juce::Label posLabel;
-
-	juce::Slider highSlider;
-	juce::Slider midSlider;
-	juce::Slider lowSlider;
-	juce::Label highLabel;
-	juce::Label midLabel;
-	juce::Label lowLabel;
-
-	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DeckGUI)
-};
+/*
+  ==============================================================================
+
+	DeckGUI.h
+	Created: 21th January 2023 - 1:07 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DJAudioPlayer.h"
+#include "WaveformDisplay.h"
+#include "ScrollingWaveform.h"
+#include "TrackLoader.h"
+#include "Customize.h"
+
+//==============================================================================
+/* class that handles main GUI components of the DJplayer, mainly buttons and sliders */
+
+class DeckGUI : public juce::Component,
+	public juce::Button::Listener,
+	public juce::Slider::Listener,
+	public juce::FileDragAndDropTarget,
+	public juce::Timer
+{
+public:
+	DeckGUI(DJAudioPlayer* player,      // listen to audio file
+	TrackLoader& trackLoaderToUse);     // open files and their waveforms off the message thread
+	~DeckGUI() override;
+
+	void paint(juce::Graphics&) override;
+	void resized() override;
+
+	// implement Button::Listener
+	void buttonClicked(juce::Button* button) override;
+
+	// implement Slider::Listener
+	void sliderValueChanged(juce::Slider* slider) override;
+
+	// implement FileDragAndDropTarget
+	bool isInterestedInFileDrag(const juce::StringArray& files) override;
+	void filesDropped(const juce::StringArray& files, int x, int y) override;
+
+	// implement Timer for changes to the waveform
+	void timerCallback() override;
+
+	// functions to toggle and update button attributes
+	void togglePlayButton();
+	void toggleLoopButton();
+	void cycleKeyLockButton();
+	void cycleResamplerButton();
+	void cycleSyncButton();
+	void hotCueClicked(int slot);
+
+	// opens a file in the background and hands it to the player and waveform once ready.
+	// the analysis is the library's beat grid for sync, empty for files from outside the library.
+	// hot cues set or cleared on the deck are passed to onHotCuesChanged, so the library can keep them
+	void loadTrack(juce::URL audioURL, juce::String title, bool togglePlayOnLoad, TrackAnalysis analysis,
+				   HotCues hotCues = {}, std::function<void(const HotCues&)> onHotCuesChanged = nullptr);
+
+	juce::Label deckTitle;
+	juce::Label statusLabel;
+	DJAudioPlayer* player;
+	WaveformDisplay waveformDisplay;
+	ScrollingWaveform zoomedWaveform{ [this] { return player->getCurrentPosition(); } };   // follows the playhead every frame
+
+private:
+	TrackLoader& trackLoader;
+	Customize customize { this };
+	
+	juce::TextButton playButton;
+	juce::TextButton loopButton;
+	juce::TextButton loadButton;
+	juce::TextButton ramButton;
+	juce::TextButton keyLockButton;
+	juce::TextButton resamplerButton;
+	juce::TextButton syncButton;
+	juce::OwnedArray<juce::TextButton> hotCueButtons;
+	std::function<void(const HotCues&)> onHotCuesChanged;   // for the track loaded last
+	
+	juce::FileChooser fChooser{ "Select a file..." };
+
+	juce::Slider volSlider;
+	juce::Slider speedSlider;
+	juce::Slider freqSlider;
+	juce::Slider posSlider;
+	juce::Label volLabel;
+	juce::Label speedLabel;
+	juce::Label freqLabel;
+	juce::Label posLabel;
+
+	juce::Slider highSlider;
+	juce::Slider midSlider;
+	juce::Slider lowSlider;
+	juce::Label highLabel;
+	juce::Label midLabel;
+	juce::Label lowLabel;
+
+	void updateStatusLabel();
+	void updateSyncButton();
+	void updateHotCueButtons();
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DeckGUI)
+};
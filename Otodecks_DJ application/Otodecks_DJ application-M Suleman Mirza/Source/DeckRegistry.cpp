@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+	DeckRegistry.cpp
+	Created: 17th October 2026 - 11:40 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#include "DeckRegistry.h"
+using namespace juce;
+
+//==============================================================================
+/* owns every deck's player and GUI, decks can be added and removed while audio is running */
+
+DeckRegistry::DeckRegistry(ParallelMixer& _mixer,
+	AudioFormatManager& _formatManager,
+	TrackLoader& _trackLoader,
+	SyncEngine& _syncEngine) :
+	mixer{ _mixer },
+	formatManager{ _formatManager },
+	trackLoader{ _trackLoader },
+	syncEngine{ _syncEngine }
+{
+}
+
+DeckRegistry::~DeckRegistry()
+{
+}
+
+/* creates a player and its GUI, the mixer prepares the player before it joins the graph */
+DeckRegistry::Deck* DeckRegistry::addDeck()
+{
+	if (decks.size() >= maxDecks)
+		return nullptr;
+
+	auto* deck = decks.add(new Deck());
+	deck->id = nextId++;
+	deck->player = std::make_shared<DJAudioPlayer>(formatManager, syncEngine);
+	deck->gui = std::make_unique<DeckGUI>(deck->player.get(), trackLoader);
+	deck->gui->deckTitle.setText("Deck " + String(deck->id) + " Screen", dontSendNotification);
+
+	mixer.addInputSource(deck->player);
+	sendChangeMessage();
+
+	DBG("DeckRegistry::addDeck: deck " << deck->id);
+	return deck;
+}
+
+/* the GUI goes now, the player once the audio thread has moved on to a graph without it */
+void DeckRegistry::removeDeck(int id)
+{
+	for (int i = 0; i < decks.size(); ++i)
+	{
+		if (decks[i]->id != id)
+			continue;
+
+		mixer.removeInputSource(decks[i]->player.get());
+		decks.remove(i);
+		sendChangeMessage();
+
+		DBG("DeckRegistry::removeDeck: deck " << id);
+		return;
+	}
+}
+
+int DeckRegistry::getNumDecks() const
+{
+	return decks.size();
+}
+
+/* returns the deck at index in the order they were added, or nullptr */
+DeckRegistry::Deck* DeckRegistry::getDeck(int index) const
+{
+	return decks[index];
+}
+
+DeckRegistry::Deck* DeckRegistry::getDeckWithId(int id) const
+{
+	for (auto* deck : decks)
+		if (deck->id == id)
+			return deck;
+	return nullptr;
+}
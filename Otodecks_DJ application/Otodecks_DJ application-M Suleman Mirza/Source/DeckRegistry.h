@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+	DeckRegistry.h
+	Created: 17th October 2026 - 11:40 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DJAudioPlayer.h"
+#include "DeckGUI.h"
+#include "ParallelMixer.h"
+#include "TrackLoader.h"
+#include "SyncEngine.h"
+#include <memory>
+
+//==============================================================================
+/* owns every deck's player and GUI, decks can be added and removed while audio is running.
+   listeners are told through ChangeBroadcaster so they can lay the decks out again */
+
+class DeckRegistry : public juce::ChangeBroadcaster
+{
+public:
+	struct Deck
+	{
+		int id;
+		std::shared_ptr<DJAudioPlayer> player;   // shared with the mixer's graph until the audio thread lets go of it
+		std::unique_ptr<DeckGUI> gui;            // declared last so it goes before the player
+	};
+
+	DeckRegistry(ParallelMixer& _mixer,
+				 juce::AudioFormatManager& _formatManager,
+				 TrackLoader& _trackLoader,
+				 SyncEngine& _syncEngine);
+	~DeckRegistry() override;
+
+	// returns nullptr once maxDecks are open
+	Deck* addDeck();
+	void removeDeck(int id);
+
+	int getNumDecks() const;
+	Deck* getDeck(int index) const;
+	Deck* getDeckWithId(int id) const;
+
+	static constexpr int maxDecks{ 8 };
+
+private:
+	ParallelMixer& mixer;
+	juce::AudioFormatManager& formatManager;
+	TrackLoader& trackLoader;
+	SyncEngine& syncEngine;
+
+	juce::OwnedArray<Deck> decks;
+	int nextId{ 1 };
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DeckRegistry)
+};
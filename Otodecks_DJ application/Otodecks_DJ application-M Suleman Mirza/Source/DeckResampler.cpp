@@ -0,0 +1,331 @@
+/*
+  ==============================================================================
+
+	DeckResampler.cpp
+	Created: 17th October 2026 - 09:30 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#include "DeckResampler.h"
+#include <cstring>
+using namespace juce;
+
+//==============================================================================
+/* varispeed resampler for a deck with a choice of interpolation kernels.
+   automatic uses the cheap linear kernel while the ratio is moving (scratching, pitch bends)
+   and the windowed sinc once the pitch has been steady for a moment */
+
+DeckResampler::DeckResampler(AudioSource* _input) :
+	input{ _input }
+{
+	for (auto& cost : nanosPerSample)
+		cost.store(0.0f);
+}
+
+DeckResampler::~DeckResampler()
+{
+}
+
+String DeckResampler::getKernelName(int kernel)
+{
+	if (kernel == linear)
+		return "Linear";
+	if (kernel == cubic)
+		return "Cubic";
+	if (kernel == sinc)
+		return "Sinc";
+	return "Auto";
+}
+
+void DeckResampler::prepareToPlay(int samplesPerBlockExpected, double newSampleRate)
+{
+	sampleRate = newSampleRate;
+	maxChunkSize = jmax(64, samplesPerBlockExpected);
+	lastRatio = ratio;
+
+	// the upstream sources see blocks scaled by the ratio, like ResamplingAudioSource
+	input->prepareToPlay(jmax(1, roundToInt(maxChunkSize * ratio)), sampleRate);
+
+	// a chunk at the highest ratio plus the kernel's reach either side
+	inputBuffer.setSize(2, (int) std::ceil(maxChunkSize * maxRatio) + numTaps + 4);
+	inputBuffer.clear();
+
+	// start with silence behind the first sample so every kernel has history to read
+	inputFill = halfTaps;
+	readPosition = halfTaps;
+
+	selectSincTable(ratio);
+
+	// start on the high quality kernel, nothing is moving yet
+	steadySamples = (int) sampleRate;
+}
+
+void DeckResampler::releaseResources()
+{
+	input->releaseResources();
+}
+
+/* ratio set by the player, the audio thread is its only caller */
+void DeckResampler::setResamplingRatio(double newRatio)
+{
+	ratio = jlimit(0.01, maxRatio, newRatio);
+}
+
+/* everything after the read position, the kernels are centred on it so nothing before it is still to come */
+double DeckResampler::getBufferedInput() const
+{
+	return inputFill - readPosition;
+}
+
+/* silence behind the read position again, as after prepareToPlay, and no glide from before the jump */
+void DeckResampler::flush()
+{
+	inputBuffer.clear(0, halfTaps);
+	inputFill = halfTaps;
+	readPosition = halfTaps;
+	lastRatio = ratio;
+}
+
+void DeckResampler::setKernel(int newKernel)
+{
+	kernelSetting.store(jlimit(0, numKernels - 1, newKernel));
+}
+
+int DeckResampler::getKernel() const
+{
+	return kernelSetting.load();
+}
+
+int DeckResampler::getActiveKernel() const
+{
+	return activeKernel.load();
+}
+
+/* average time each kernel has taken per output sample, measured while playing */
+double DeckResampler::getCpuCost(int kernel) const
+{
+	return isPositiveAndBelow(kernel, (int) numKernels) ? nanosPerSample[kernel].load() : 0.0;
+}
+
+//==============================================================================
+/* resamples the input into the block, gliding from the previous ratio to the current one */
+void DeckResampler::getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill)
+{
+	const int numChannels{ jmin(bufferToFill.buffer->getNumChannels(), 2) };
+	for (int ch = numChannels; ch < bufferToFill.buffer->getNumChannels(); ++ch)
+		bufferToFill.buffer->clear(ch, bufferToFill.startSample, bufferToFill.numSamples);
+
+	// tempo sync nudges the ratio a tiny amount every block, that is not enough to hear the kernel change over
+	const int kernel{ chooseKernel(std::abs(ratio - lastRatio) > lastRatio * 1.0e-4, bufferToFill.numSamples) };
+	activeKernel.store(kernel);
+	if (kernel == sinc)
+		selectSincTable(jmax(ratio, lastRatio));
+
+	const double ratioStep{ (ratio - lastRatio) / bufferToFill.numSamples };
+	double chunkRatio{ lastRatio };
+	int64 renderTicks{ 0 };
+
+	for (int offset = 0; offset < bufferToFill.numSamples; offset += maxChunkSize)
+	{
+		const int numSamples{ jmin(maxChunkSize, bufferToFill.numSamples - offset) };
+
+		// enough input for the chunk at whichever end of the glide is faster
+		const double advance{ numSamples * jmax(chunkRatio, chunkRatio + ratioStep * numSamples) };
+		fillInput((int) (readPosition + advance) + halfTaps + 1);
+
+		float* out[2];
+		for (int ch = 0; ch < numChannels; ++ch)
+			out[ch] = bufferToFill.buffer->getWritePointer(ch, bufferToFill.startSample + offset);
+
+		const int64 startTicks{ Time::getHighResolutionTicks() };
+		renderChunk(out, numChannels, numSamples, kernel, chunkRatio, ratioStep);
+		renderTicks += Time::getHighResolutionTicks() - startTicks;
+
+		chunkRatio += ratioStep * numSamples;
+		discardUsedInput();
+	}
+	lastRatio = ratio;
+
+	// smoothed so the reported cost does not jump around from block to block
+	const float nanos{ (float) (renderTicks * 1.0e9 / Time::getHighResolutionTicksPerSecond() / bufferToFill.numSamples) };
+	const float previous{ nanosPerSample[kernel].load() };
+	nanosPerSample[kernel].store(previous > 0.0f ? previous * 0.95f + nanos * 0.05f : nanos);
+}
+
+/* the fast kernel while the ratio moves, the sinc once it has held still for a fifth of a second */
+int DeckResampler::chooseKernel(bool ratioMoving, int numSamples)
+{
+	const int setting{ kernelSetting.load() };
+	if (setting != automatic)
+		return setting;
+
+	if (ratioMoving)
+		steadySamples = 0;
+	else
+		steadySamples = jmin(steadySamples + numSamples, (int) sampleRate);
+
+	return steadySamples >= (int) (sampleRate * 0.2) ? (int) sinc : (int) linear;
+}
+
+/* tops the input buffer up to needUpTo samples */
+void DeckResampler::fillInput(int needUpTo)
+{
+	needUpTo = jmin(needUpTo, inputBuffer.getNumSamples());
+	if (needUpTo <= inputFill)
+		return;
+
+	AudioSourceChannelInfo info{ &inputBuffer, inputFill, needUpTo - inputFill };
+	input->getNextAudioBlock(info);
+	inputFill = needUpTo;
+}
+
+/* moves the samples the kernels can still reach to the front of the buffer */
+void DeckResampler::discardUsedInput()
+{
+	const int keepFrom{ jmin((int) readPosition - halfTaps + 1, inputFill) };
+	if (keepFrom <= 0)
+		return;
+
+	for (int ch = 0; ch < 2; ++ch)
+	{
+		float* data = inputBuffer.getWritePointer(ch);
+		std::memmove(data, data + keepFrom, sizeof(float) * (size_t) (inputFill - keepFrom));
+	}
+	inputFill -= keepFrom;
+	readPosition -= keepFrom;
+}
+
+/* writes numSamples of output with the given kernel, stepping the ratio by ratioStep every sample */
+void DeckResampler::renderChunk(float* const* out, int numChannels, int numSamples, int kernel, double startRatio, double ratioStep)
+{
+	const float* in[2] = { inputBuffer.getReadPointer(0), inputBuffer.getReadPointer(1) };
+	double step{ startRatio };
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		const int base{ (int) readPosition };
+		const double frac{ readPosition - base };
+		const float t{ (float) frac };
+
+		if (kernel == linear)
+		{
+			for (int ch = 0; ch < numChannels; ++ch)
+			{
+				const float* x = in[ch] + base;
+				out[ch][i] = x[0] + t * (x[1] - x[0]);
+			}
+		}
+		else if (kernel == cubic)
+		{
+			// lagrange weights for the samples at -1, 0, 1 and 2
+			const float wm1{ -t * (t - 1.0f) * (t - 2.0f) / 6.0f };
+			const float w0{ (t + 1.0f) * (t - 1.0f) * (t - 2.0f) / 2.0f };
+			const float w1{ -(t + 1.0f) * t * (t - 2.0f) / 2.0f };
+			const float w2{ (t + 1.0f) * t * (t - 1.0f) / 6.0f };
+			for (int ch = 0; ch < numChannels; ++ch)
+			{
+				const float* x = in[ch] + base;
+				out[ch][i] = wm1 * x[-1] + w0 * x[0] + w1 * x[1] + w2 * x[2];
+			}
+		}
+		else
+		{
+			// the taps only depend on the phase, so they are shared by both channels
+			prepareSincTaps(frac);
+			for (int ch = 0; ch < numChannels; ++ch)
+				out[ch][i] = interpolateSinc(in[ch] + base - halfTaps + 1);
+		}
+
+		readPosition += step;
+		step += ratioStep;
+	}
+}
+
+//==============================================================================
+/* blends the two table rows either side of frac into the tap registers */
+void DeckResampler::prepareSincTaps(double frac)
+{
+	const double phase{ frac * numPhases };
+	const int row{ jmin((int) phase, numPhases - 1) };
+	const Lanes blend{ Lanes::expand((float) (phase - row)) };
+
+	const Lanes* a = sincTable + (size_t) row * lanesPerRow;
+	const Lanes* b = a + lanesPerRow;
+	for (int n = 0; n < lanesPerRow; ++n)
+		taps[n] = a[n] + (b[n] - a[n]) * blend;
+}
+
+/* dot product of numTaps input samples with the prepared taps, a register at a time */
+float DeckResampler::interpolateSinc(const float* in)
+{
+	alignas(Lanes::SIMDRegisterSize) float aligned[numTaps];
+	std::memcpy(aligned, in, sizeof(aligned));
+
+	Lanes sum{ Lanes::expand(0.0f) };
+	for (int n = 0; n < lanesPerRow; ++n)
+		sum += Lanes::fromRawArray(aligned + n * Lanes::SIMDNumElements) * taps[n];
+	return sum.sum();
+}
+
+/* picks the table for ratio, nothing is calculated on the audio thread */
+void DeckResampler::selectSincTable(double forRatio)
+{
+	sincTable = sincTables->getTable(forRatio);
+}
+
+//==============================================================================
+/* every table at once, the window only depends on the phase and tap so it is worked out a single time */
+DeckResampler::SincTables::SincTables()
+{
+	rows.resize(tableSize * numTables);
+
+	std::vector<double> window((size_t) (numPhases + 1) * numTaps);
+	for (int phase = 0; phase <= numPhases; ++phase)
+	{
+		for (int k = 0; k < numTaps; ++k)
+		{
+			const double x{ (k - halfTaps + 1) - phase / (double) numPhases };
+			const double w{ 0.42 + 0.5 * std::cos(MathConstants<double>::pi * x / halfTaps)
+				+ 0.08 * std::cos(MathConstants<double>::twoPi * x / halfTaps) };
+			window[(size_t) phase * numTaps + k] = jmax(0.0, w);
+		}
+	}
+
+	alignas(Lanes::SIMDRegisterSize) float row[numTaps];
+	for (int table = 0; table < numTables; ++table)
+	{
+		// going faster than the original squeezes the spectrum, so the cutoff drops to stop aliasing
+		const double cutoff{ 0.95 / std::pow(2.0, table / (double) stepsPerOctave) };
+		Lanes* destination = rows.data() + tableSize * (size_t) table;
+
+		for (int phase = 0; phase <= numPhases; ++phase)
+		{
+			const double frac{ phase / (double) numPhases };
+			double total{ 0.0 };
+			for (int k = 0; k < numTaps; ++k)
+			{
+				const double x{ (k - halfTaps + 1) - frac };
+				const double arg{ MathConstants<double>::pi * cutoff * x };
+				const double sincValue{ std::abs(arg) < 1.0e-9 ? 1.0 : std::sin(arg) / arg };
+				row[k] = (float) (sincValue * window[(size_t) phase * numTaps + k]);
+				total += row[k];
+			}
+
+			// unity gain at DC for every phase
+			for (int k = 0; k < numTaps; ++k)
+				row[k] = (float) (row[k] / total);
+
+			for (int n = 0; n < lanesPerRow; ++n)
+				destination[(size_t) phase * lanesPerRow + n] = Lanes::fromRawArray(row + n * Lanes::SIMDNumElements);
+		}
+	}
+}
+
+/* rounds up to the next table, a cutoff a little low is safer than one that lets aliasing through */
+const DeckResampler::Lanes* DeckResampler::SincTables::getTable(double forRatio) const
+{
+	const int table{ forRatio <= 1.0 ? 0 : jmin(numTables - 1, (int) std::ceil(std::log2(forRatio) * stepsPerOctave - 1.0e-6)) };
+	return rows.data() + tableSize * (size_t) table;
+}
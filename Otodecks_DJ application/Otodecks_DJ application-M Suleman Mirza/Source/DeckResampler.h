@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+	DeckResampler.h
+	Created: 17th October 2026 - 09:05 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <vector>
+
+//==============================================================================
+/* varispeed resampler for a deck with a choice of interpolation kernels.
+   automatic uses the cheap linear kernel while the ratio is moving (scratching, pitch bends)
+   and the windowed sinc once the pitch has been steady for a moment */
+
+class DeckResampler : public juce::AudioSource
+{
+public:
+	enum Kernel
+	{
+		automatic = 0,
+		linear,
+		cubic,   // 4 point lagrange
+		sinc,   // 32 tap blackman windowed sinc
+		numKernels
+	};
+
+	DeckResampler(juce::AudioSource* _input);
+	~DeckResampler() override;
+
+	void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+	void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+	void releaseResources() override;
+
+	// audio thread only, input samples consumed per output sample. the ratio glides there over the next block
+	void setResamplingRatio(double newRatio);
+	// audio thread only, input samples read but not played yet
+	double getBufferedInput() const;
+	// audio thread only, drops the buffered input so the next sample read is the first one out, for jumps
+	void flush();
+
+	// safe to call from any thread
+	void setKernel(int newKernel);
+	int getKernel() const;
+	int getActiveKernel() const;   // the kernel automatic is currently using
+	double getCpuCost(int kernel) const;   // nanoseconds per output sample, 0 until the kernel has been used
+
+	static juce::String getKernelName(int kernel);
+
+private:
+	using Lanes = juce::dsp::SIMDRegister<float>;
+	static constexpr int halfTaps{ 16 };
+	static constexpr int numTaps{ halfTaps * 2 };
+	static constexpr int numPhases{ 256 };
+	static constexpr int lanesPerRow{ numTaps / (int) Lanes::SIMDNumElements };
+	static constexpr double maxRatio{ 16.0 };
+
+	// polyphase sinc tables for cutoffs a quarter tone apart, from the original speed to maxRatio.
+	// they only depend on the cutoff, so every deck shares one set built on the message thread
+	struct SincTables
+	{
+		static constexpr int stepsPerOctave{ 24 };
+		static constexpr int numTables{ stepsPerOctave * 4 + 1 };   // log2 (maxRatio) octaves
+		static constexpr size_t tableSize{ (size_t) (numPhases + 1) * lanesPerRow };
+
+		SincTables();
+		const Lanes* getTable(double forRatio) const;
+
+		std::vector<Lanes> rows;
+	};
+
+	void renderChunk(float* const* out, int numChannels, int numSamples, int kernel, double startRatio, double ratioStep);
+	void fillInput(int needUpTo);
+	void discardUsedInput();
+	void selectSincTable(double forRatio);
+	float interpolateSinc(const float* in);
+	void prepareSincTaps(double frac);
+	int chooseKernel(bool ratioMoving, int numSamples);
+
+	juce::AudioSource* input;
+
+	// written by the GUI, read by the audio thread
+	std::atomic<int> kernelSetting{ automatic };
+	std::atomic<int> activeKernel{ sinc };
+	std::array<std::atomic<float>, numKernels> nanosPerSample;
+
+	// audio thread only
+	double ratio{ 1.0 };
+	double lastRatio{ 1.0 };
+	double sampleRate{ 44100.0 };
+	int maxChunkSize{ 512 };
+	int steadySamples{ 0 };
+	juce::AudioBuffer<float> inputBuffer;
+	int inputFill{ 0 };
+	double readPosition{ 0.0 };
+
+	// polyphase sinc rows, one more than numPhases so the last phase can be interpolated
+	juce::SharedResourcePointer<SincTables> sincTables;
+	const Lanes* sincTable{ nullptr };
+	std::array<Lanes, lanesPerRow> taps;
+	std::array<Lanes, lanesPerRow> inputLanes;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DeckResampler)
+};
@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+	DecodedTrackCache.cpp
+	Created: 17th October 2026 - 02:35 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#include "DecodedTrackCache.h"
+using namespace juce;
+
+//==============================================================================
+/* a whole track decoded to floats in RAM, shared by the cache and any deck playing it */
+
+DecodedAudio::DecodedAudio(int numChannels, int numSamples, double _sampleRate) :
+	buffer{ numChannels, numSamples },
+	sampleRate{ _sampleRate }
+{
+}
+
+/* returns memory used by the samples and waveform */
+size_t DecodedAudio::getSizeInBytes() const
+{
+	return (size_t) buffer.getNumChannels() * (size_t) buffer.getNumSamples() * sizeof(float)
+		+ (waveform != nullptr ? waveform->getSizeInBytes() : 0);
+}
+
+//==============================================================================
+/* least recently used cache of decoded tracks, shared by every deck and limited by a byte budget */
+
+DecodedTrackCache::DecodedTrackCache(size_t _budgetBytes) :
+	budgetBytes{ _budgetBytes }
+{
+}
+
+/* returns the decoded track for key, or nullptr if it is not cached */
+DecodedAudio::Ptr DecodedTrackCache::get(const String& key)
+{
+	const ScopedLock sl(lock);
+	auto it = lookup.find(key);
+	if (it == lookup.end())
+	{
+		++misses;
+		return nullptr;
+	}
+
+	// move to the front of the list, iterators stay valid
+	entries.splice(entries.begin(), entries, it->second);
+	++hits;
+	return it->second->audio;
+}
+
+/* stores a decoded track, evicting the least recently used ones until under budget */
+void DecodedTrackCache::add(const String& key, DecodedAudio::Ptr audio)
+{
+	const ScopedLock sl(lock);
+	auto it = lookup.find(key);
+	if (it != lookup.end())
+	{
+		bytesUsed -= it->second->audio->getSizeInBytes();
+		entries.erase(it->second);
+		lookup.erase(it);
+	}
+
+	entries.push_front({ key, audio });
+	lookup[key] = entries.begin();
+	bytesUsed += audio->getSizeInBytes();
+	evictToBudget();
+}
+
+void DecodedTrackCache::setBudget(size_t newBudgetBytes)
+{
+	const ScopedLock sl(lock);
+	budgetBytes = newBudgetBytes;
+	evictToBudget();
+}
+
+size_t DecodedTrackCache::getBudget() const
+{
+	const ScopedLock sl(lock);
+	return budgetBytes;
+}
+
+size_t DecodedTrackCache::getBytesUsed() const
+{
+	const ScopedLock sl(lock);
+	return bytesUsed;
+}
+
+int DecodedTrackCache::getNumHits() const
+{
+	const ScopedLock sl(lock);
+	return hits;
+}
+
+int DecodedTrackCache::getNumMisses() const
+{
+	const ScopedLock sl(lock);
+	return misses;
+}
+
+/* returns the ratio of lookups that were served from RAM */
+double DecodedTrackCache::getHitRate() const
+{
+	const ScopedLock sl(lock);
+	return (hits + misses) > 0 ? hits / (double) (hits + misses) : 0.0;
+}
+
+/* builds a key from the full path, modification time and size */
+String DecodedTrackCache::makeKey(const File& file)
+{
+	return file.getFullPathName() + "|" + String(file.getLastModificationTime().toMilliseconds()) + "|" + String(file.getSize());
+}
+
+/* drops least recently used entries, decks still playing one keep their own reference */
+void DecodedTrackCache::evictToBudget()
+{
+	while (bytesUsed > budgetBytes && !entries.empty())
+	{
+		auto& oldest = entries.back();
+		bytesUsed -= oldest.audio->getSizeInBytes();
+		lookup.erase(oldest.key);
+		entries.pop_back();
+	}
+}
@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+	DecodedTrackCache.h
+	Created: 17th October 2026 - 02:10 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "WaveformCache.h"
+#include <list>
+#include <unordered_map>
+
+//==============================================================================
+/* a whole track decoded to floats in RAM, shared by the cache and any deck playing it */
+
+class DecodedAudio : public juce::ReferenceCountedObject
+{
+public:
+	using Ptr = juce::ReferenceCountedObjectPtr<DecodedAudio>;
+
+	DecodedAudio(int numChannels, int numSamples, double _sampleRate);
+
+	juce::AudioBuffer<float> buffer;
+	double sampleRate;
+
+	// the waveform of the decoded samples, from the waveform cache or built while decoding
+	WaveformPyramid::Ptr waveform;
+
+	size_t getSizeInBytes() const;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DecodedAudio)
+};
+
+//==============================================================================
+/* least recently used cache of decoded tracks, shared by every deck and limited by a byte budget */
+
+class DecodedTrackCache
+{
+public:
+	DecodedTrackCache(size_t _budgetBytes);
+
+	// returns nullptr on a miss, hits move the entry to the front
+	DecodedAudio::Ptr get(const juce::String& key);
+	void add(const juce::String& key, DecodedAudio::Ptr audio);
+
+	void setBudget(size_t newBudgetBytes);
+	size_t getBudget() const;
+	size_t getBytesUsed() const;
+
+	int getNumHits() const;
+	int getNumMisses() const;
+	double getHitRate() const;
+
+	// key changes whenever the file on disk is modified
+	static juce::String makeKey(const juce::File& file);
+
+private:
+	struct Entry
+	{
+		juce::String key;
+		DecodedAudio::Ptr audio;
+	};
+
+	void evictToBudget();
+
+	juce::CriticalSection lock;
+	std::list<Entry> entries;   // most recently used first
+	std::unordered_map<juce::String, std::list<Entry>::iterator> lookup;
+	size_t budgetBytes;
+	size_t bytesUsed{ 0 };
+	int hits{ 0 };
+	int misses{ 0 };
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DecodedTrackCache)
+};
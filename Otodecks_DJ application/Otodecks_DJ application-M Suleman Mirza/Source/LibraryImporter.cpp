@@ -0,0 +1,249 @@
+/*
+  ==============================================================================
+
+	LibraryImporter.cpp
+	Created: 18th October 2026 - 11:45 AM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#include "LibraryImporter.h"
+#include <algorithm>
+using namespace juce;
+
+//==============================================================================
+/* imports files and folders into the library on a thread pool, results come back to the message thread in batches */
+
+LibraryImporter::LibraryImporter(AudioFormatManager& _formatManager, TrackMetadataIndex& _trackIndex) :
+	formatManager{ _formatManager },
+	trackIndex{ _trackIndex }
+{
+}
+
+LibraryImporter::~LibraryImporter()
+{
+	stopTimer();
+	++generation;
+	pool.removeAllJobs(true, 5000);
+	refreshPool.removeAllJobs(true, 5000);
+}
+
+/* walks any folders and probes every file found, a running import just gets more work */
+void LibraryImporter::importFiles(const Array<File>& filesOrFolders)
+{
+	if (!importing)
+	{
+		importing = true;
+		numFound.store(0);
+		numProbed.store(0);
+		numImported = 0;
+		startTimer(100);
+	}
+
+	const int currentGeneration{ generation.load() };
+	const JobCounter counter{ outstandingJobs };
+	std::vector<File> files;
+
+	for (auto& file : filesOrFolders)
+	{
+		if (file.isDirectory())
+		{
+			++*counter;
+			pool.addJob([this, file, currentGeneration, counter] { walkFolder(file, currentGeneration, counter); });
+		}
+		else
+		{
+			files.push_back(file);
+		}
+	}
+
+	numFound += (int) files.size();
+	queueProbes(std::move(files), currentGeneration, counter);
+}
+
+/* drops everything still queued, tracks already handed to the table stay there. jobs already running
+   see the new generation and stop on their own, the message thread does not wait for them */
+void LibraryImporter::cancelImport()
+{
+	if (!importing)
+		return;
+
+	++generation;
+	pool.removeAllJobs(true, 0);
+	outstandingJobs = std::make_shared<std::atomic<int>>(0);
+	{
+		const ScopedLock sl(pendingLock);
+		pending.clear();
+	}
+
+	importing = false;
+	if (outstandingRefreshes.load() <= 0)
+		stopTimer();
+	DBG("LibraryImporter::cancelImport: stopped after " << numImported << " of " << numFound.load());
+
+	if (onImportFinished != nullptr)
+		onImportFinished(true);
+}
+
+void LibraryImporter::setFingerprintFiles(bool shouldFingerprint)
+{
+	fingerprintFiles.store(shouldFingerprint);
+}
+
+bool LibraryImporter::getFingerprintFiles() const
+{
+	return fingerprintFiles.load();
+}
+
+bool LibraryImporter::isImporting() const
+{
+	return importing;
+}
+
+int LibraryImporter::getNumFound() const
+{
+	return numFound.load();
+}
+
+int LibraryImporter::getNumImported() const
+{
+	return numImported;
+}
+
+double LibraryImporter::getProgress() const
+{
+	const int found{ numFound.load() };
+	return found > 0 ? numProbed.load() / (double) found : 0.0;
+}
+
+/* the answer comes back through the same timer as import batches, so a screenful of rows repaints once */
+void LibraryImporter::refreshTrack(uint32 trackId, const File& file, bool needsMetadata)
+{
+	++outstandingRefreshes;
+	refreshPool.addJob([this, trackId, file, needsMetadata]
+	{
+		RefreshedTrack result{ trackId, file.existsAsFile(), {} };
+		if (result.exists && needsMetadata)
+			result.metadata = trackIndex.getMetadata(file, false);
+
+		{
+			const ScopedLock sl(pendingLock);
+			refreshed.push_back(std::move(result));
+		}
+		--outstandingRefreshes;
+	});
+
+	if (!isTimerRunning())
+		startTimer(100);
+}
+
+//==============================================================================
+/* pool thread, collects the audio files under folder and hands them out for probing in batches */
+void LibraryImporter::walkFolder(File folder, int jobGeneration, JobCounter counter)
+{
+	std::vector<File> files;
+	for (auto& entry : RangedDirectoryIterator{ folder, true, formatManager.getWildcardForAllFormats(), File::findFiles })
+	{
+		if (generation.load() != jobGeneration)
+			break;
+
+		files.push_back(entry.getFile());
+		if ((int) files.size() == probeBatchSize)
+		{
+			numFound += probeBatchSize;
+			queueProbes(std::move(files), jobGeneration, counter);
+			files.clear();
+		}
+	}
+
+	numFound += (int) files.size();
+	queueProbes(std::move(files), jobGeneration, counter);
+	--*counter;
+}
+
+/* splits files into jobs that each probe a batch through the metadata index */
+void LibraryImporter::queueProbes(std::vector<File> files, int jobGeneration, JobCounter counter)
+{
+	for (size_t start = 0; start < files.size(); start += probeBatchSize)
+	{
+		std::vector<File> batch{ files.begin() + (std::ptrdiff_t) start,
+								 files.begin() + (std::ptrdiff_t) std::min(files.size(), start + probeBatchSize) };
+		++*counter;
+		pool.addJob([this, batch = std::move(batch), jobGeneration, counter]
+		{
+			std::vector<TrackMetadata> results;
+			results.reserve(batch.size());
+			for (auto& file : batch)
+			{
+				if (generation.load() != jobGeneration)
+					break;
+				results.push_back(trackIndex.getMetadata(file, fingerprintFiles.load()));
+				++numProbed;
+			}
+
+			if (generation.load() == jobGeneration)
+			{
+				const ScopedLock sl(pendingLock);
+				pending.insert(pending.end(), results.begin(), results.end());
+			}
+			--*counter;
+		});
+	}
+}
+
+/* hands whatever has been probed or refreshed since the last tick to the table, and finishes once all jobs are done */
+void LibraryImporter::timerCallback()
+{
+	// read before draining, so results pushed by the last job are never left behind
+	const bool allJobsDone{ outstandingJobs->load() <= 0 };
+	const bool allRefreshesDone{ outstandingRefreshes.load() <= 0 };
+	deliverRefreshedTracks();
+
+	if (!importing)
+	{
+		if (allRefreshesDone)
+			stopTimer();
+		return;
+	}
+
+	std::vector<TrackMetadata> batch;
+	{
+		const ScopedLock sl(pendingLock);
+		batch.swap(pending);
+	}
+
+	if (!batch.empty())
+	{
+		// jobs finish in any order, sorting keeps folders together in the table
+		std::sort(batch.begin(), batch.end(), [](const TrackMetadata& a, const TrackMetadata& b) { return a.path < b.path; });
+		numImported += (int) batch.size();
+		if (onBatchImported != nullptr)
+			onBatchImported(batch);
+	}
+
+	if (allJobsDone)
+	{
+		if (allRefreshesDone)
+			stopTimer();
+		importing = false;
+		trackIndex.save();
+		DBG("LibraryImporter::timerCallback: imported " << numImported << " files");
+
+		if (onImportFinished != nullptr)
+			onImportFinished(false);
+	}
+}
+
+/* hands every refreshed track to the table in one go */
+void LibraryImporter::deliverRefreshedTracks()
+{
+	std::vector<RefreshedTrack> batch;
+	{
+		const ScopedLock sl(pendingLock);
+		batch.swap(refreshed);
+	}
+
+	if (!batch.empty() && onTracksRefreshed != nullptr)
+		onTracksRefreshed(batch);
+}
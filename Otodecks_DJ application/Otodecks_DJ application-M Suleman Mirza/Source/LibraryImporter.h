@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+	LibraryImporter.h
+	Created: 18th October 2026 - 11:20 AM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "TrackMetadataIndex.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/* imports files and folders into the library on a thread pool.
+   folders are walked recursively for anything the format manager can open, files are probed
+   through the metadata index in batches, and the results come back to the message thread
+   a batch at a time so the table stays usable while a big import runs.
+
+   tracks already in the library are refreshed one at a time as the table draws them, on a pool of
+   their own so visible rows never wait behind a big import */
+
+class LibraryImporter : private juce::Timer
+{
+public:
+	LibraryImporter(juce::AudioFormatManager& _formatManager, TrackMetadataIndex& _trackIndex);
+	~LibraryImporter() override;
+
+	// message thread, adds to the running import if there is one
+	void importFiles(const juce::Array<juce::File>& filesOrFolders);
+	void cancelImport();
+
+	// also fingerprints file contents so copies under another path are caught, costs a read of each file's ends
+	void setFingerprintFiles(bool shouldFingerprint);
+	bool getFingerprintFiles() const;
+
+	bool isImporting() const;
+	int getNumFound() const;
+	int getNumImported() const;
+
+	// found files can still grow while folders are being walked
+	double getProgress() const;
+
+	// message thread, checks a track's file is still there and probes it if its length is not known yet
+	void refreshTrack(juce::uint32 trackId, const juce::File& file, bool needsMetadata);
+
+	struct RefreshedTrack
+	{
+		juce::uint32 trackId;
+		bool exists;
+		TrackMetadata metadata;   // only probed if it was asked for
+	};
+
+	// called on the message thread
+	std::function<void(const std::vector<TrackMetadata>&)> onBatchImported;
+	std::function<void(bool wasCancelled)> onImportFinished;
+	std::function<void(const std::vector<RefreshedTrack>&)> onTracksRefreshed;
+
+private:
+	// every job of one import shares a count of those still to finish
+	using JobCounter = std::shared_ptr<std::atomic<int>>;
+
+	void walkFolder(juce::File folder, int generation, JobCounter counter);
+	void queueProbes(std::vector<juce::File> files, int generation, JobCounter counter);
+	void timerCallback() override;
+	void deliverRefreshedTracks();
+
+	juce::AudioFormatManager& formatManager;
+	TrackMetadataIndex& trackIndex;
+	juce::ThreadPool pool{ juce::jmax(1, juce::SystemStats::getNumCpus()) };
+
+	// results waiting for the message thread
+	juce::CriticalSection pendingLock;
+	std::vector<TrackMetadata> pending;
+	std::vector<RefreshedTrack> refreshed;
+
+	// a couple of threads is plenty for existence checks, and keeps them off the import's queue
+	juce::ThreadPool refreshPool{ 2 };
+	std::atomic<int> outstandingRefreshes{ 0 };
+
+	// jobs from a cancelled import see a stale generation and drop their work. each import counts its own
+	// jobs, so one still finishing after a cancel can never make the next import look done early
+	std::atomic<int> generation{ 0 };
+	JobCounter outstandingJobs{ std::make_shared<std::atomic<int>>(0) };
+	std::atomic<int> numFound{ 0 };
+	std::atomic<int> numProbed{ 0 };
+	int numImported{ 0 };
+	bool importing{ false };
+	std::atomic<bool> fingerprintFiles{ false };
+
+	static constexpr int probeBatchSize{ 64 };
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LibraryImporter)
+};
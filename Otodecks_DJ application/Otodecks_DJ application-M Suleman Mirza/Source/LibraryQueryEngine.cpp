@@ -0,0 +1,396 @@
+/*
+  ==============================================================================
+
+	LibraryQueryEngine.cpp
+	Created: 18th October 2026 - 05:40 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#include "LibraryQueryEngine.h"
+#include <algorithm>
+#include <cstring>
+using namespace juce;
+
+namespace
+{
+	using Lanes = dsp::SIMDRegister<float>;
+	constexpr size_t numLanes{ Lanes::SIMDNumElements };
+
+	// fewer exact matches than this and a word long enough to allow typos is matched fuzzily as well
+	const int minExactMatches{ 10 };
+
+	// columns are plain vectors, so registers are loaded and stored through an aligned copy
+	Lanes loadLanes(const float* source)
+	{
+		alignas(Lanes::SIMDRegisterSize) float aligned[numLanes];
+		std::memcpy(aligned, source, sizeof(aligned));
+		return Lanes::fromRawArray(aligned);
+	}
+
+	void storeLanes(Lanes lanes, float* destination)
+	{
+		alignas(Lanes::SIMDRegisterSize) float aligned[numLanes];
+		lanes.copyToRawArray(aligned);
+		std::memcpy(destination, aligned, sizeof(aligned));
+	}
+
+	/* seconds, or minutes and seconds written m:ss */
+	float parseNumber(const String& text, bool isTime)
+	{
+		if (isTime && text.containsChar(':'))
+			return text.upToFirstOccurrenceOf(":", false, false).getFloatValue() * 60.0f
+				+ text.fromFirstOccurrenceOf(":", false, false).getFloatValue();
+		return text.getFloatValue();
+	}
+
+	/* a-b, >a, <b, or a single value matched to the nearest whole unit */
+	LibraryQueryEngine::Range parseRange(const String& text, bool isTime)
+	{
+		LibraryQueryEngine::Range range;
+		if (text.startsWithChar('>'))
+			range.min = parseNumber(text.substring(1), isTime);
+		else if (text.startsWithChar('<'))
+			range.max = parseNumber(text.substring(1), isTime);
+		else if (text.containsChar('-'))
+		{
+			range.min = parseNumber(text.upToFirstOccurrenceOf("-", false, false), isTime);
+			range.max = parseNumber(text.fromFirstOccurrenceOf("-", false, false), isTime);
+		}
+		else
+		{
+			const float value{ parseNumber(text, isTime) };
+			range.min = value - 0.5f;
+			range.max = value + 0.5f;
+		}
+		return range;
+	}
+}
+
+//==============================================================================
+bool LibraryQueryEngine::Range::isSet() const
+{
+	return min > -1.0e30f || max < 1.0e30f;
+}
+
+/* splits the query into words and field filters, quotes keep spaces inside a value */
+LibraryQueryEngine::Query LibraryQueryEngine::Query::parse(const String& text)
+{
+	Query query;
+	StringArray tokens;
+	tokens.addTokens(text.toLowerCase(), " ", "\"");
+	tokens.trim();
+	tokens.removeEmptyStrings();
+
+	for (auto& token : tokens)
+	{
+		const String field{ token.upToFirstOccurrenceOf(":", false, false) };
+		const String value{ token.fromFirstOccurrenceOf(":", false, false).unquoted() };
+
+		if (!token.containsChar(':') || value.isEmpty())
+			query.words.add(token.unquoted());
+		else if (field == "title")
+			query.title.add(value);
+		else if (field == "path")
+			query.path.add(value);
+		else if (field == "format" || field == "ext")
+			query.format.add(value);
+		else if (field == "key")
+			query.key.add(value);
+		else if (field == "length" || field == "len" || field == "time")
+			query.length = parseRange(value, true);
+		else if (field == "bpm")
+			query.bpm = parseRange(value, false);
+		else
+			query.words.add(token);   // not a field we know, so it is just text with a colon in it
+	}
+	return query;
+}
+
+bool LibraryQueryEngine::Query::hasTextFilters() const
+{
+	return !(title.isEmpty() && path.isEmpty() && format.isEmpty() && key.isEmpty());
+}
+
+bool LibraryQueryEngine::Query::isPlainText() const
+{
+	return words.size() == 1 && !hasTextFilters() && !length.isSet() && !bpm.isSet();
+}
+
+/* short words have to be spelt right, or nearly everything would match them */
+int LibraryQueryEngine::getAllowedErrors(int length)
+{
+	if (length <= 3)
+		return 0;
+	if (length <= 7)
+		return 1;
+	return 2;
+}
+
+//==============================================================================
+/* library queries over several fields with typo tolerant matching, results ranked by score */
+
+LibraryQueryEngine::LibraryQueryEngine(const TrackStore& _store) :
+	store{ _store }
+{
+}
+
+/* indexes the title and tags, the track's other fields are read from the store when filtering */
+void LibraryQueryEngine::addTrack(const Track& track)
+{
+	textIndex.addTrack(track);
+	presence.push_back(getPresence(textIndex.getText(getNumTracks())));
+}
+
+void LibraryQueryEngine::removeTrack(int index)
+{
+	if (!isPositiveAndBelow(index, getNumTracks()))
+		return;
+
+	textIndex.removeTrack(index);
+	presence.erase(presence.begin() + index);
+}
+
+void LibraryQueryEngine::clear()
+{
+	textIndex.clear();
+	presence.clear();
+}
+
+int LibraryQueryEngine::getNumTracks() const
+{
+	return (int) presence.size();
+}
+
+void LibraryQueryEngine::swapWith(LibraryQueryEngine& other) noexcept
+{
+	textIndex.swapWith(other.textIndex);
+	presence.swap(other.presence);
+}
+
+void LibraryQueryEngine::writeTo(ColumnWriter& writer) const
+{
+	textIndex.writeTo(writer);
+}
+
+bool LibraryQueryEngine::readFrom(ColumnReader& reader)
+{
+	presence.clear();
+	if (!textIndex.readFrom(reader))
+		return false;
+
+	presence.resize((size_t) textIndex.getNumTracks());
+	for (int i = 0; i < textIndex.getNumTracks(); ++i)
+		presence[(size_t) i] = getPresence(textIndex.getText(i));
+	return true;
+}
+
+//==============================================================================
+/* filters, then scores every remaining track word by word, and returns them best first */
+const std::vector<int>& LibraryQueryEngine::search(const String& text)
+{
+	const Query query{ Query::parse(text) };
+
+	// a single word spelt right is answered by the trigram index, which refines as the user types.
+	// typos are only looked for when it finds too few tracks, or when the word is too short to allow any
+	if (query.isPlainText())
+	{
+		const auto& exact = textIndex.search(query.words[0]);
+		if ((int) exact.size() >= minExactMatches || getAllowedErrors(query.words[0].length()) == 0)
+			return exact;
+	}
+
+	const size_t numTracks{ (size_t) getNumTracks() };
+	scores.assign(numTracks, 1.0f);
+
+	applyRange(query.length, store.getLengths());
+	applyRange(query.bpm, store.getBpms());
+
+	// text filters only look at tracks the ranges let through
+	if (query.hasTextFilters())
+	{
+		for (size_t i = 0; i < numTracks; ++i)
+			if (scores[i] > 0.0f && !matchesTextFilters(query, (int) i))
+				scores[i] = 0.0f;
+	}
+
+	// every word has to match, so the scores multiply and a miss anywhere zeroes the track
+	for (auto& word : query.words)
+	{
+		const Pattern pattern{ makePattern(normalise(word)) };
+		const int length{ (int) pattern.text.size() };
+		wordScores.assign(numTracks, 0.0f);
+
+		// k edits can touch at most k of k + 1 pieces of the word, so a match holds one piece intact.
+		// the trigram index finds the tracks holding a piece and only those are matched in full.
+		// pieces are looked up without disturbing the typed query the index refines
+		for (int piece = 0; piece <= pattern.maxErrors; ++piece)
+		{
+			const size_t start{ getCharacterStart(pattern.text, length * piece / (pattern.maxErrors + 1)) };
+			const size_t end{ getCharacterStart(pattern.text, length * (piece + 1) / (pattern.maxErrors + 1)) };
+
+			for (int index : textIndex.lookup(String{ pattern.text.substr(start, end - start) }))
+			{
+				const size_t i{ (size_t) index };
+
+				// each letter of the word the track does not have at all costs at least one edit
+				if (wordScores[i] == 0.0f && scores[i] > 0.0f
+					&& countNumberOfBits(pattern.presence & ~presence[i]) <= pattern.maxErrors)
+					wordScores[i] = scoreWord(pattern, textIndex.getText(index));
+			}
+		}
+
+		FloatVectorOperations::multiply(scores.data(), wordScores.data(), (int) numTracks);
+	}
+
+	results.clear();
+	for (size_t i = 0; i < numTracks; ++i)
+		if (scores[i] > 0.0f)
+			results.push_back((int) i);
+
+	// stable, so equally good matches keep their playlist order
+	std::stable_sort(results.begin(), results.end(), [this](int a, int b) { return scores[(size_t) a] > scores[(size_t) b]; });
+	return results;
+}
+
+/* zeroes the score of every track whose column value is outside range, a register at a time */
+void LibraryQueryEngine::applyRange(const Range& range, const std::vector<float>& column)
+{
+	if (!range.isSet())
+		return;
+
+	const Lanes low{ Lanes::expand(range.min) };
+	const Lanes high{ Lanes::expand(range.max) };
+	const size_t numTracks{ jmin(column.size(), scores.size()) };
+
+	size_t i{ 0 };
+	for (; i + numLanes <= numTracks; i += numLanes)
+	{
+		const Lanes values{ loadLanes(&column[i]) };
+		const auto inside = Lanes::greaterThanOrEqual(values, low) & Lanes::lessThanOrEqual(values, high);
+		storeLanes(loadLanes(&scores[i]) & inside, &scores[i]);
+	}
+	for (; i < numTracks; ++i)
+		if (column[i] < range.min || column[i] > range.max)
+			scores[i] = 0.0f;
+}
+
+//==============================================================================
+std::string LibraryQueryEngine::normalise(const String& text)
+{
+	return text.toLowerCase().toStdString();
+}
+
+/* letters and digits get a bit each, everything else shares the rest */
+uint64 LibraryQueryEngine::getPresenceBit(unsigned char c)
+{
+	if (c >= 'a' && c <= 'z')
+		return (uint64) 1 << (c - 'a');
+	if (c >= '0' && c <= '9')
+		return (uint64) 1 << (26 + c - '0');
+	return (uint64) 1 << (36 + c % 28);
+}
+
+uint64 LibraryQueryEngine::getPresence(std::string_view text)
+{
+	uint64 bits{ 0 };
+	for (char c : text)
+		bits |= getPresenceBit((unsigned char) c);
+	return bits & ~getPresenceBit(' ');   // spaces are never worth an edit
+}
+
+LibraryQueryEngine::Pattern LibraryQueryEngine::makePattern(const std::string& word)
+{
+	Pattern pattern;
+	pattern.text = word.substr(0, 63);
+	pattern.maxErrors = getAllowedErrors((int) pattern.text.size());
+	std::fill(std::begin(pattern.charMasks), std::end(pattern.charMasks), (uint64) 0);
+
+	for (size_t i = 0; i < pattern.text.size(); ++i)
+		pattern.charMasks[(unsigned char) pattern.text[i]] |= (uint64) 1 << i;
+	pattern.presence = getPresence(pattern.text);
+	return pattern;
+}
+
+/* approximate substring match, the whole pattern is stepped through the text a character at a time
+   with one bit per pattern position and one word per number of edits (Wu and Manber's bitap).
+   an exact match at the start of a word scores highest, each edit needed scores less */
+float LibraryQueryEngine::scoreWord(const Pattern& pattern, std::string_view text)
+{
+	const int length{ (int) pattern.text.size() };
+	if (length == 0)
+		return 1.0f;
+
+	const uint64 found{ (uint64) 1 << (length - 1) };
+	uint64 state[3];
+	for (int d = 0; d <= pattern.maxErrors; ++d)
+		state[d] = ((uint64) 1 << d) - 1;
+
+	int fewestErrors{ pattern.maxErrors + 1 };
+	for (size_t i = 0; i < text.size(); ++i)
+	{
+		const uint64 mask{ pattern.charMasks[(unsigned char) text[i]] };
+
+		uint64 previous{ state[0] };
+		state[0] = ((state[0] << 1) | 1) & mask;
+		if ((state[0] & found) != 0)
+		{
+			const size_t start{ i + 1 - (size_t) length };
+			if (start == 0 || text[start - 1] == ' ')
+				return 1.2f;   // nothing scores better, no need to read on
+			fewestErrors = 0;
+		}
+
+		// substitution and insertion read the previous character's state, deletion this one's
+		for (int d = 1; d <= pattern.maxErrors; ++d)
+		{
+			const uint64 current{ state[d] };
+			state[d] = (((current << 1) | 1) & mask) | previous | (previous << 1) | (state[d - 1] << 1) | 1;
+			previous = current;
+			if ((state[d] & found) != 0)
+				fewestErrors = jmin(fewestErrors, d);
+		}
+	}
+
+	if (fewestErrors == 0)
+		return 1.0f;
+	if (fewestErrors == 1)
+		return 0.6f;
+	if (fewestErrors == 2)
+		return 0.35f;
+	return 0.0f;
+}
+
+/* moves a byte offset forward to the start of a UTF-8 character, so pieces never split one */
+size_t LibraryQueryEngine::getCharacterStart(const std::string& text, int offset)
+{
+	size_t i{ (size_t) offset };
+	while (i < text.size() && (text[i] & 0xc0) == 0x80)
+		++i;
+	return i;
+}
+
+/* words come from the parsed query, already lowercased */
+bool LibraryQueryEngine::containsAll(const String& text, const StringArray& words)
+{
+	const String lowercase{ text.toLowerCase() };
+	for (auto& word : words)
+		if (!lowercase.contains(word))
+			return false;
+	return true;
+}
+
+/* each field is only fetched from the store when the query filters on it */
+bool LibraryQueryEngine::matchesTextFilters(const Query& query, int index) const
+{
+	if (!query.title.isEmpty() && !containsAll(store.getTitle(index), query.title))
+		return false;
+	if (!query.path.isEmpty() && !containsAll(store.getPath(index), query.path))
+		return false;
+	if (!query.format.isEmpty() && !containsAll(store.getExtension(index).trimCharactersAtStart("."), query.format))
+		return false;
+	if (!query.key.isEmpty() && !containsAll(store.getKey(index), query.key))
+		return false;
+	return true;
+}
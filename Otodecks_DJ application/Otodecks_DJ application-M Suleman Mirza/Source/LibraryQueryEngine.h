@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+	LibraryQueryEngine.h
+	Created: 18th October 2026 - 05:10 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Track.h"
+#include "TrackStore.h"
+#include "TrackSearchIndex.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+//==============================================================================
+/* library queries over several fields with typo tolerant matching, results ranked by score.
+
+   a query is words and field filters separated by spaces, for example
+	   deep hous bpm:120-128 length:>3:00 format:flac
+   words are matched against the title and tags allowing a typo or two in longer words.
+   filters are title:, path:, format: and key: for text, length: and bpm: for ranges written as
+   a-b, >a, <b or a single value. lengths can be seconds or m:ss.
+
+   a query of one word is handed to the trigram index first and its matches stay in playlist order,
+   typos are only allowed for when that finds too few. anything else is filtered column by column, the
+   number filters a SIMD register at a time, and each word scored with a scalar bit-parallel matcher.
+   a word allowing typos is only matched in full against tracks the trigram index finds part of it in */
+
+class LibraryQueryEngine
+{
+public:
+	// the store's columns are filtered in place, nothing but the search text is copied
+	LibraryQueryEngine(const TrackStore& _store);
+
+	// kept in step with the store, index n is the store's track n. add after the store, remove either side
+	void addTrack(const Track& track);
+	void removeTrack(int index);
+	void clear();
+	int getNumTracks() const;
+
+	// exchanges the index with another engine's, for one read on another thread. each keeps its own store
+	void swapWith(LibraryQueryEngine& other) noexcept;
+
+	// returns matching track indices, best first
+	const std::vector<int>& search(const juce::String& query);
+
+	// the trigram index is saved with the session, the per track masks are rebuilt from its texts
+	void writeTo(ColumnWriter& writer) const;
+	bool readFrom(ColumnReader& reader);
+
+	struct Range
+	{
+		float min{ -1.0e30f };
+		float max{ 1.0e30f };
+		bool isSet() const;
+	};
+
+	struct Query
+	{
+		juce::StringArray words;                  // fuzzy matched against title and tags
+		juce::StringArray title, path, format, key;   // exact substrings of that field
+		Range length, bpm;
+
+		static Query parse(const juce::String& text);
+		bool hasTextFilters() const;
+		bool isPlainText() const;   // a single word and no filters
+	};
+
+	// edits allowed in a word of this many characters
+	static int getAllowedErrors(int length);
+
+private:
+	// one word ready for the bit-parallel matcher, bit i of a mask is pattern position i
+	struct Pattern
+	{
+		std::string text;
+		juce::uint64 charMasks[256];
+		juce::uint64 presence;   // which character classes the word uses
+		int maxErrors;
+	};
+
+	static std::string normalise(const juce::String& text);
+	static juce::uint64 getPresenceBit(unsigned char c);
+	static juce::uint64 getPresence(std::string_view text);
+	static Pattern makePattern(const std::string& word);
+	static size_t getCharacterStart(const std::string& text, int offset);
+	static float scoreWord(const Pattern& pattern, std::string_view text);
+	static bool containsAll(const juce::String& text, const juce::StringArray& words);
+
+	bool matchesTextFilters(const Query& query, int index) const;
+	void applyRange(const Range& range, const std::vector<float>& column);
+
+	const TrackStore& store;
+	TrackSearchIndex textIndex;   // title and tags, also answers plain queries
+	std::vector<juce::uint64> presence;   // one per track
+
+	// per search, the store's number columns are filtered a whole register at a time with a scalar tail
+	std::vector<float> scores, wordScores;
+
+	std::vector<int> results;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LibraryQueryEngine)
+};
@@ -0,0 +1,458 @@
+/*
+  ==============================================================================
+
+	LibrarySession.cpp
+	Created: 19th October 2026 - 12:05 AM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#include "LibrarySession.h"
+using namespace juce;
+
+namespace
+{
+	// bumped whenever the column layout changes, older sessions are ignored
+	const int sessionMagic{ (int) ByteOrder::littleEndianInt("OTSS") };
+	const int journalMagic{ (int) ByteOrder::littleEndianInt("OTSJ") };
+	const int sessionVersion{ 4 };
+
+	// the journal is folded into a snapshot once it holds this many changes, or an eighth of the library
+	const int minChangesBeforeSnapshot{ 1000 };
+	const int journalFlushIntervalMs{ 5000 };
+}
+
+//==============================================================================
+/* saves the playlist between runs as a binary snapshot plus a journal of changes since */
+
+LibrarySession::LibrarySession(TrackStore& _store, LibraryQueryEngine& _engine, const File& _sessionFile) :
+	store{ _store },
+	engine{ _engine },
+	sessionFile{ _sessionFile }
+{
+	startTimer(journalFlushIntervalMs);
+}
+
+LibrarySession::~LibrarySession()
+{
+	stopTimer();
+	cancelPendingUpdate();
+
+	// an unfinished load must not overwrite the snapshot it was reading. the store may already have been
+	// handed over without its index, so a snapshot written now would not load, and anything changed
+	// since is dropped rather than journalled against rows the journal has not been replayed onto
+	const bool interrupted{ snapshotReader != nullptr };
+	snapshotReader = nullptr;
+	if (!interrupted)
+		save();
+}
+
+File LibrarySession::getDefaultSessionFile()
+{
+	return File::getSpecialLocation(File::userApplicationDataDirectory)
+		.getChildFile("OtoDecks")
+		.getChildFile("session.bin");
+}
+
+File LibrarySession::getJournalFile() const
+{
+	return sessionFile.withFileExtension("journal");
+}
+
+/* a journal written before the first snapshot still replays, onto an empty store */
+bool LibrarySession::load()
+{
+	SnapshotReader reader{ *this };
+	const bool loadedSnapshot{ reader.readStore() && reader.readIndex() };
+	if (loadedSnapshot)
+	{
+		store.swapWith(reader.store);
+		engine.swapWith(reader.engine);
+		generation = reader.generation;
+	}
+
+	finishLoading(loadedSnapshot);
+	return loadedSnapshot || store.size() > 0;
+}
+
+/* the reader thread posts here after each step, the store is handed over as soon as it is read */
+void LibrarySession::loadInBackground()
+{
+	if (snapshotReader != nullptr)
+		return;
+
+	storeHandedOver = false;
+	snapshotReader = std::make_unique<SnapshotReader>(*this);
+	snapshotReader->startThread(Thread::Priority::normal);
+}
+
+bool LibrarySession::isLoading() const
+{
+	return snapshotReader != nullptr;
+}
+
+void LibrarySession::handleAsyncUpdate()
+{
+	if (snapshotReader == nullptr)
+		return;
+
+	const int stage{ snapshotReader->stage.load() };
+	if (stage == SnapshotReader::storeRead || stage == SnapshotReader::indexRead)
+	{
+		if (!storeHandedOver)
+		{
+			store.swapWith(snapshotReader->store);
+			storeHandedOver = true;
+			if (onStoreLoaded != nullptr)
+				onStoreLoaded();
+		}
+	}
+
+	if (stage == SnapshotReader::indexRead)
+	{
+		engine.swapWith(snapshotReader->engine);
+		generation = snapshotReader->generation;
+	}
+	else if (stage == SnapshotReader::failed)
+	{
+		// the rows may already be showing, but without a matching index they cannot be kept
+		store.clear();
+		engine.clear();
+	}
+	else
+	{
+		return;
+	}
+
+	snapshotReader = nullptr;
+	finishLoading(stage == SnapshotReader::indexRead);
+	if (onLoaded != nullptr)
+		onLoaded(stage == SnapshotReader::indexRead || store.size() > 0);
+}
+
+/* the journal goes on top of whatever the snapshot gave us */
+void LibrarySession::finishLoading(bool loadedSnapshot)
+{
+	if (!loadedSnapshot)
+		generation = 0;
+	replayJournal();
+
+	// a replayed journal is folded into the next snapshot
+	changed = numJournalChanges > 0;
+}
+
+//==============================================================================
+void LibrarySession::trackAdded(const Track& track)
+{
+	pendingRecords.writeByte((char) addRecord);
+	pendingRecords.writeString(track.file.getFullPathName());
+	pendingRecords.writeString(track.fingerprint);
+	pendingRecords.writeString(track.tags);
+	pendingRecords.writeDouble(track.lengthInSeconds);
+	pendingRecords.writeDouble(track.sampleRate);
+	pendingRecords.writeDouble(track.bpm);
+	pendingRecords.writeDouble(track.firstBeat);
+	pendingRecords.writeString(track.key);
+	pendingRecords.writeDouble(track.loudness);
+	pendingRecords.writeDouble(track.truePeak);
+	pendingRecords.writeByte((char) track.analysed);
+	++numJournalChanges;
+	changed = true;
+}
+
+void LibrarySession::trackRemoved(TrackStore::TrackId id)
+{
+	pendingRecords.writeByte((char) removeRecord);
+	pendingRecords.writeInt((int) id);
+	++numJournalChanges;
+	changed = true;
+}
+
+/* the record carries every detail, so one kind of record covers lengths and everything analysis fills in */
+void LibrarySession::trackDetailsChanged(TrackStore::TrackId id)
+{
+	const int index{ store.getIndexOf(id) };
+	if (index < 0)
+		return;
+
+	pendingRecords.writeByte((char) detailsRecord);
+	pendingRecords.writeInt((int) id);
+	pendingRecords.writeDouble(store.getLengthInSeconds(index));
+	pendingRecords.writeDouble(store.getSampleRate(index));
+	pendingRecords.writeDouble(store.getBpm(index));
+	pendingRecords.writeDouble(store.getFirstBeat(index));
+	pendingRecords.writeString(store.getKey(index));
+	pendingRecords.writeDouble(store.getLoudness(index));
+	pendingRecords.writeDouble(store.getTruePeak(index));
+	pendingRecords.writeByte((char) store.getAnalysed(index));
+	++numJournalChanges;
+	changed = true;
+}
+
+/* every slot, so clearing a cue needs no record of its own */
+void LibrarySession::hotCuesChanged(TrackStore::TrackId id)
+{
+	const int index{ store.getIndexOf(id) };
+	if (index < 0)
+		return;
+
+	pendingRecords.writeByte((char) hotCuesRecord);
+	pendingRecords.writeInt((int) id);
+	for (auto position : store.getHotCues(index).positions)
+		pendingRecords.writeInt64(position);
+	++numJournalChanges;
+	changed = true;
+}
+
+/* appends what changed since the last flush, or takes a snapshot if the journal has grown long */
+void LibrarySession::timerCallback()
+{
+	if (pendingRecords.getDataSize() == 0 || isLoading())
+		return;
+
+	if (numJournalChanges > jmax(minChangesBeforeSnapshot, store.size() / 8))
+		save();
+	else
+		flushJournal();
+}
+
+/* each flush is one record, a length followed by everything written since the last one,
+   so a flush cut short by a crash is recognised and skipped as a whole */
+void LibrarySession::flushJournal()
+{
+	const File journalFile{ getJournalFile() };
+	journalFile.getParentDirectory().createDirectory();
+
+	FileOutputStream out{ journalFile };
+	if (!out.openedOk())
+		return;
+
+	// a journal is only ever started right after the snapshot it follows was written
+	if (out.getPosition() == 0)
+	{
+		out.writeInt(journalMagic);
+		out.writeInt(sessionVersion);
+		out.writeInt64((int64) generation);
+	}
+
+	out.writeInt((int) pendingRecords.getDataSize());
+	out.write(pendingRecords.getData(), pendingRecords.getDataSize());
+	out.flush();
+
+	if (!out.getStatus().failed())
+		pendingRecords.reset();
+}
+
+/* writes to a temporary file and swaps it in, so a crash mid-save never leaves a broken session */
+void LibrarySession::save()
+{
+	if ((!changed && pendingRecords.getDataSize() == 0) || isLoading())
+		return;
+
+	sessionFile.getParentDirectory().createDirectory();
+	TemporaryFile temp{ sessionFile };
+	{
+		FileOutputStream out{ temp.getFile() };
+		if (!out.openedOk())
+			return;
+
+		out.writeInt(sessionMagic);
+		out.writeInt(sessionVersion);
+		out.writeInt64((int64) (generation + 1));
+
+		ColumnWriter writer{ out };
+		store.writeTo(writer);
+		engine.writeTo(writer);
+		out.flush();
+		if (out.getStatus().failed())
+			return;
+	}
+
+	if (!temp.overwriteTargetFileWithTemporary())
+		return;
+
+	// the old journal belongs to the old snapshot, it would be ignored on load but there is no point keeping it
+	++generation;
+	getJournalFile().deleteFile();
+	pendingRecords.reset();
+	numJournalChanges = 0;
+	changed = false;
+	DBG("LibrarySession::save: " << store.size() << " tracks to " << sessionFile.getFullPathName());
+}
+
+//==============================================================================
+/* maps the snapshot and copies its columns straight into a store and search index of its own */
+
+LibrarySession::SnapshotReader::SnapshotReader(LibrarySession& _owner) :
+	Thread{ "Session loader" },
+	owner{ _owner },
+	mapped{ _owner.sessionFile, MemoryMappedFile::readOnly }
+{
+}
+
+LibrarySession::SnapshotReader::~SnapshotReader()
+{
+	// a column read cannot be interrupted, but none takes more than a moment
+	stopThread(5000);
+}
+
+void LibrarySession::SnapshotReader::run()
+{
+	if (!readStore())
+	{
+		stage.store(failed);
+		owner.triggerAsyncUpdate();
+		return;
+	}
+
+	stage.store(storeRead);
+	owner.triggerAsyncUpdate();
+
+	stage.store(!threadShouldExit() && readIndex() ? indexRead : failed);
+	owner.triggerAsyncUpdate();
+}
+
+bool LibrarySession::SnapshotReader::readStore()
+{
+	if (mapped.getData() == nullptr || mapped.getSize() < 16)
+		return false;
+
+	MemoryInputStream header{ mapped.getData(), 16, false };
+	if (header.readInt() != sessionMagic || header.readInt() != sessionVersion)
+		return false;
+	generation = (uint64) header.readInt64();
+
+	reader = std::make_unique<ColumnReader>(static_cast<const char*>(mapped.getData()) + 16, mapped.getSize() - 16);
+	if (!store.readFrom(*reader))
+	{
+		DBG("LibrarySession::SnapshotReader: " << owner.sessionFile.getFullPathName() << " is damaged, starting empty");
+		return false;
+	}
+
+	numTracks = store.size();
+	DBG("LibrarySession::SnapshotReader: " << numTracks << " tracks");
+	return true;
+}
+
+/* the store may already have been handed over, so the index is checked against the size it was read with */
+bool LibrarySession::SnapshotReader::readIndex()
+{
+	if (reader == nullptr || !engine.readFrom(*reader) || engine.getNumTracks() != numTracks)
+	{
+		DBG("LibrarySession::SnapshotReader: the search index in " << owner.sessionFile.getFullPathName() << " is damaged");
+		engine.clear();
+		return false;
+	}
+	return true;
+}
+
+/* replays the changes made after the snapshot was written, stopping at the first incomplete record.
+   anything after the last complete record is cut off, or later flushes would be appended behind it and never replayed */
+void LibrarySession::replayJournal()
+{
+	const File journalFile{ getJournalFile() };
+	if (!journalFile.existsAsFile())
+		return;
+
+	int64 goodEnd{ 0 };
+	{
+		FileInputStream in{ journalFile };
+		if (in.openedOk() && in.readInt() == journalMagic && in.readInt() == sessionVersion
+			&& (uint64) in.readInt64() == generation)
+		{
+			goodEnd = in.getPosition();
+			while (!in.isExhausted())
+			{
+				const int size{ in.readInt() };
+				MemoryBlock record;
+				if (size <= 0 || in.readIntoMemoryBlock(record, size) != (size_t) size)
+					break;
+
+				MemoryInputStream recordStream{ record, false };
+				while (!recordStream.isExhausted() && replayRecord(recordStream))
+					++numJournalChanges;
+				goodEnd = in.getPosition();
+			}
+		}
+	}
+
+	// a journal left behind by an older snapshot is no use either, the next flush starts a new one
+	if (goodEnd == 0)
+	{
+		journalFile.deleteFile();
+	}
+	else if (goodEnd < journalFile.getSize())
+	{
+		DBG("LibrarySession::replayJournal: dropping " << (journalFile.getSize() - goodEnd) << " bytes of incomplete journal");
+		FileOutputStream out{ journalFile };
+		if (out.openedOk() && out.setPosition(goodEnd))
+			out.truncate();
+	}
+	DBG("LibrarySession::replayJournal: " << numJournalChanges << " changes, " << store.size() << " tracks");
+}
+
+bool LibrarySession::replayRecord(MemoryInputStream& in)
+{
+	const int type{ in.readByte() };
+	if (type == addRecord)
+	{
+		Track track{ File{ in.readString() } };
+		track.fingerprint = in.readString();
+		track.tags = in.readString();
+		track.lengthInSeconds = in.readDouble();
+		track.sampleRate = in.readDouble();
+		track.bpm = in.readDouble();
+		track.firstBeat = in.readDouble();
+		track.key = in.readString();
+		track.loudness = in.readDouble();
+		track.truePeak = in.readDouble();
+		track.analysed = (uint8) in.readByte();
+
+		store.add(track);
+		engine.addTrack(track);
+		return true;
+	}
+	if (type == removeRecord)
+	{
+		const int index{ store.getIndexOf((TrackStore::TrackId) in.readInt()) };
+		if (index >= 0)
+		{
+			engine.removeTrack(index);
+			store.remove(index);
+		}
+		return true;
+	}
+	if (type == detailsRecord)
+	{
+		const int index{ store.getIndexOf((TrackStore::TrackId) in.readInt()) };
+		const double lengthInSeconds{ in.readDouble() };
+		const double sampleRate{ in.readDouble() };
+		const double bpm{ in.readDouble() };
+		const double firstBeat{ in.readDouble() };
+		const String key{ in.readString() };
+		const double loudness{ in.readDouble() };
+		const double truePeak{ in.readDouble() };
+		const uint8 analysed{ (uint8) in.readByte() };
+		if (index >= 0)
+		{
+			store.setAudioDetails(index, lengthInSeconds, sampleRate);
+			store.setBeatGrid(index, bpm, firstBeat);
+			store.setKey(index, key);
+			store.setLoudness(index, loudness, truePeak);
+			store.setAnalysed(index, analysed);
+		}
+		return true;
+	}
+	if (type == hotCuesRecord)
+	{
+		const int index{ store.getIndexOf((TrackStore::TrackId) in.readInt()) };
+		HotCues hotCues;
+		for (auto& position : hotCues.positions)
+			position = in.readInt64();
+		if (index >= 0)
+			store.setHotCues(index, hotCues);
+		return true;
+	}
+	return false;
+}
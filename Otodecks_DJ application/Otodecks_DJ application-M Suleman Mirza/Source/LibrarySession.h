@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+	LibrarySession.h
+	Created: 18th October 2026 - 11:40 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ColumnStream.h"
+#include "LibraryQueryEngine.h"
+#include "Track.h"
+#include "TrackStore.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+
+//==============================================================================
+/* saves the playlist between runs as a binary snapshot plus a journal of changes since.
+
+   the snapshot is the track store's columns and the search index written whole with ColumnWriter,
+   so loading maps the file and copies the columns back without reading a track at a time.
+   it is written to a temporary file and renamed over the last one, so a crash mid-save leaves the
+   previous snapshot intact.
+
+   between snapshots each added, removed or updated track is appended to the journal every few seconds.
+   a journal only replays onto the snapshot it was started after, and a record cut short by a crash
+   is cut off along with anything after it when the journal is next loaded. the journal is folded into
+   a new snapshot once it grows past a fraction of the library, and on exit.
+
+   at startup the snapshot is read on a background thread in two steps. the store's columns are
+   swapped in first so the table can show rows, then the search index, and only then is the
+   journal replayed. nothing is saved while a load is running, or when the app closes before it finishes */
+
+class LibrarySession : private juce::Timer,
+					   private juce::AsyncUpdater
+{
+public:
+	LibrarySession(TrackStore& _store, LibraryQueryEngine& _engine, const juce::File& _sessionFile = getDefaultSessionFile());
+	~LibrarySession() override;
+
+	// loads the snapshot and replays its journal, false if there was no session to load
+	bool load();
+
+	// the same, but the snapshot is read on a background thread and handed over through the callbacks below
+	void loadInBackground();
+	bool isLoading() const;
+
+	// called on the message thread. the store is filled but the search index is not ready yet
+	std::function<void()> onStoreLoaded;
+	// the store and index are filled and the journal replayed, false if there was no session to load
+	std::function<void(bool loaded)> onLoaded;
+
+	// message thread, called after the track is in the store
+	void trackAdded(const Track& track);
+	// message thread, called before the track leaves the store
+	void trackRemoved(TrackStore::TrackId id);
+	// message thread, after the track's length or analysis results were filled in
+	void trackDetailsChanged(TrackStore::TrackId id);
+	// message thread, after a deck set or cleared one of the track's hot cues
+	void hotCuesChanged(TrackStore::TrackId id);
+
+	// writes a snapshot now if anything changed, and starts a new journal
+	void save();
+
+	static juce::File getDefaultSessionFile();
+
+private:
+	enum RecordType
+	{
+		addRecord = 1,
+		removeRecord,
+		detailsRecord,
+		hotCuesRecord
+	};
+
+	// reads the snapshot into a store and index of its own, either on its thread or called directly by load()
+	class SnapshotReader : public juce::Thread
+	{
+	public:
+		SnapshotReader(LibrarySession& _owner);
+		~SnapshotReader() override;
+		void run() override;
+
+		bool readStore();
+		bool readIndex();
+
+		enum Stage
+		{
+			reading,
+			storeRead,
+			indexRead,
+			failed
+		};
+
+		TrackStore store;
+		LibraryQueryEngine engine{ store };
+		juce::uint64 generation{ 0 };
+		int numTracks{ 0 };
+		std::atomic<int> stage{ reading };
+
+	private:
+		LibrarySession& owner;
+		juce::MemoryMappedFile mapped;
+		std::unique_ptr<ColumnReader> reader;
+	};
+
+	void timerCallback() override;
+	void handleAsyncUpdate() override;
+	void finishLoading(bool loadedSnapshot);
+	void replayJournal();
+	bool replayRecord(juce::MemoryInputStream& in);
+	void flushJournal();
+	juce::File getJournalFile() const;
+
+	TrackStore& store;
+	LibraryQueryEngine& engine;
+	juce::File sessionFile;
+
+	juce::uint64 generation{ 0 };   // which snapshot the journal belongs to
+	juce::MemoryOutputStream pendingRecords;   // changes not yet appended to the journal
+	int numJournalChanges{ 0 };
+	bool changed{ false };
+
+	std::unique_ptr<SnapshotReader> snapshotReader;   // only while loading in the background
+	bool storeHandedOver{ false };
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LibrarySession)
+};
@@ -1,90 +1,157 @@
-#include "MainComponent.h"
-using namespace juce;
-
-//==============================================================================
-/* main class container head for other components */
-
-MainComponent::MainComponent()
-{
-    // After adding any child components, adjust the size of the component.
-    setSize (1250, 700);
-
-    // Request authorization to open input channels on some systems.
-    if (RuntimePermissions::isRequired (RuntimePermissions::recordAudio)
-        && ! RuntimePermissions::isGranted (RuntimePermissions::recordAudio))
-    {
-        RuntimePermissions::request (RuntimePermissions::recordAudio,
-                                           [&] (bool granted) { setAudioChannels (granted ? 2 : 0, 2); });
-    }
-    else
-    {
-        // Set the number of input/output channels.
-        setAudioChannels (2, 2);
-    }
-
-    addAndMakeVisible(deckGUI1);
-    addAndMakeVisible(deckGUI2);
-
-    deckGUI1.deckTitle.setText("Deck 1 Screen", dontSendNotification);
-    deckGUI2.deckTitle.setText("Deck 2 Screen", dontSendNotification);
-    
-    addAndMakeVisible(playlistComponent);
-
-    // register audio file formats
-    formatManager.registerBasicFormats();
-
-}
-
-MainComponent::~MainComponent()
-{
-    // This turns off the audio device and clears the source.
-    shutdownAudio();
-}
-
-//==============================================================================
-/* prepares the source to play */
-void MainComponent::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
-{
-    // call players in mixed audio channel
-    player1.prepareToPlay(samplesPerBlockExpected, sampleRate);
-    player2.prepareToPlay(samplesPerBlockExpected, sampleRate);
-
-    mixerSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
-    mixerSource.addInputSource(&player1, false);
-    mixerSource.addInputSource(&player2, false);
-}
-
-/* called this repeatedly to retrieve additional audio data */
-void MainComponent::getNextAudioBlock (const AudioSourceChannelInfo& bufferToFill)
-{
-    mixerSource.getNextAudioBlock(bufferToFill);
-}
-
-/* lets the source discard anything it doesn't require after playback. */
-void MainComponent::releaseResources()
-{
-    player1.releaseResources();
-    player2.releaseResources();
-    mixerSource.releaseResources();
-}
-
-//==============================================================================
-/* components override this method to draw their content */
-void MainComponent::paint (Graphics& gfx)
-{
-    gfx.fillAll (getLookAndFeel().findColour (ResizableWindow::backgroundColourId));
-}
-
-/* invoked when this component's size has changed, such as window resizing */
-void MainComponent::resized()
-{
-    //set deckGUI 1 & 2 to half size of main component
-    //                              x, y,          width,      height
-    deckGUI1.setBounds(             0, 0, getWidth() / 4, getHeight() );
-    deckGUI2.setBounds(getWidth() * 0.25, 0, getWidth() / 4, getHeight() );
-
-    playlistComponent.setBounds(getWidth() * 0.50 , 0, getWidth() * 0.50, getHeight());
-
-    DBG("MainComponent::resized");
-}
-
+#include "MainComponent.h"
+using namespace juce;
+
+//==============================================================================
+/* main class container head for other components */
+
+MainComponent::MainComponent (const File& sessionFile)
+    : playlistComponent { deckRegistry, libraryImporter, trackAnalyser, sessionFile }
+{
+    // After adding any child components, adjust the size of the component.
+    setSize (1250, 700);
+
+    deckRegistry.addChangeListener(this);
+    addAndMakeVisible(playlistComponent);
+
+    // register audio file formats
+    formatManager.registerBasicFormats();
+
+    // shared by every deck's read-ahead buffer
+    readAheadThread.startThread(Thread::Priority::high);
+
+    // the audio device, the decks and the library wait for the first frame, see handleAsyncUpdate()
+    playlistComponent.onRowsLoaded = [this] { rowsShownTime = Time::getMillisecondCounterHiRes(); };
+    playlistComponent.onLibraryLoaded = [this] { libraryLoaded(); };
+}
+
+MainComponent::~MainComponent()
+{
+    cancelPendingUpdate();
+    deckRegistry.removeChangeListener(this);
+
+    // This turns off the audio device and clears the source.
+    shutdownAudio();
+}
+
+//==============================================================================
+/* prepares the source to play */
+void MainComponent::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
+{
+    // the mixer prepares every deck's player, and any added later
+    mixerSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
+}
+
+/* called this repeatedly to retrieve additional audio data */
+void MainComponent::getNextAudioBlock (const AudioSourceChannelInfo& bufferToFill)
+{
+    // every deck sees the same clock for the block, whichever thread renders it
+    syncEngine.beginBlock(bufferToFill.numSamples);
+    mixerSource.getNextAudioBlock(bufferToFill);
+}
+
+/* lets the source discard anything it doesn't require after playback. */
+void MainComponent::releaseResources()
+{
+    mixerSource.releaseResources();
+}
+
+//==============================================================================
+/* components override this method to draw their content */
+void MainComponent::paint (Graphics& gfx)
+{
+    gfx.fillAll (getLookAndFeel().findColour (ResizableWindow::backgroundColourId));
+
+    // the window is on screen, everything slower can start now
+    if (firstFrameTime == 0.0)
+    {
+        firstFrameTime = Time::getMillisecondCounterHiRes();
+        triggerAsyncUpdate();
+    }
+}
+
+/* invoked when this component's size has changed, such as window resizing */
+void MainComponent::resized()
+{
+    // the decks share the left half of main component
+    int numDecks = deckRegistry.getNumDecks();
+    for (int i = 0; i < numDecks; ++i)
+    {
+        int x = getWidth() / 2 * i / numDecks;
+        int width = getWidth() / 2 * (i + 1) / numDecks - x;
+        deckRegistry.getDeck(i)->gui->setBounds(x, 0, width, getHeight());
+    }
+
+    playlistComponent.setBounds(getWidth() * 0.50 , 0, getWidth() * 0.50, getHeight());
+
+    DBG("MainComponent::resized");
+}
+
+/* a deck was added or removed, removed decks have already taken their GUI with them */
+void MainComponent::changeListenerCallback (ChangeBroadcaster* source)
+{
+    for (int i = 0; i < deckRegistry.getNumDecks(); ++i)
+        addAndMakeVisible (*deckRegistry.getDeck(i)->gui);
+
+    resized();
+}
+
+//==============================================================================
+/* the second stage of startup, the window has drawn once and the message loop is running */
+void MainComponent::handleAsyncUpdate()
+{
+    openAudioDevice();
+
+    // start with two decks, more can be added from the playlist while audio is running
+    deckRegistry.addDeck();
+    deckRegistry.addDeck();
+
+    // the rows appear as the store is read, searching and editing once the index is in
+    playlistComponent.loadLastSession();
+}
+
+void MainComponent::openAudioDevice()
+{
+    // Request authorization to open input channels on some systems.
+    if (RuntimePermissions::isRequired (RuntimePermissions::recordAudio)
+        && ! RuntimePermissions::isGranted (RuntimePermissions::recordAudio))
+    {
+        RuntimePermissions::request (RuntimePermissions::recordAudio,
+                                           [&] (bool granted) { setAudioChannels (granted ? 2 : 0, 2); });
+    }
+    else
+    {
+        // Set the number of input/output channels.
+        setAudioChannels (2, 2);
+    }
+}
+
+void MainComponent::libraryLoaded()
+{
+    interactiveTime = Time::getMillisecondCounterHiRes();
+    if (rowsShownTime == 0.0)
+        rowsShownTime = interactiveTime;
+
+    DBG("MainComponent::libraryLoaded: first frame " << getTimeToFirstFrame() << " ms, rows "
+        << getTimeToRowsShown() << " ms, interactive " << getTimeToInteractive() << " ms");
+}
+
+double MainComponent::getTimeToFirstFrame() const
+{
+    return firstFrameTime > 0.0 ? firstFrameTime - constructionTime : 0.0;
+}
+
+double MainComponent::getTimeToRowsShown() const
+{
+    return rowsShownTime > 0.0 ? rowsShownTime - constructionTime : 0.0;
+}
+
+double MainComponent::getTimeToInteractive() const
+{
+    return interactiveTime > 0.0 ? interactiveTime - constructionTime : 0.0;
+}
+
+bool MainComponent::isInteractive() const
+{
+    return interactiveTime > 0.0;
+}
+
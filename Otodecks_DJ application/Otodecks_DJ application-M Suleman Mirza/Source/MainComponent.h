@@ -1,53 +1,102 @@
-/* 
-	Final Project - Object Oriented Programming Coursework for Endterm: Otodecks
-	==============================================================================
-	Created: 12th January 2023 - 2:00 PM
-	Author:  Muhammad Suleman Mirza
-	==============================================================================
-	If you are facing any problem while running this project, please enable the following Projucer options:
-	1 - using namespace juce; enabled
-	2 - JUCE_MODAL_LOOPS_PERMITTED=1 under preprocessor definitions
- */
-
-#pragma once
-
-#include <JuceHeader.h>
-#include "DJAudioPlayer.h"
-#include "DeckGUI.h"
-#include "PlaylistComponent.h"
-
-//==============================================================================
-/* main class container head for other components */
-
-class MainComponent : public juce::AudioAppComponent
-{
-public:
-	MainComponent();
-	~MainComponent() override;
-
-	// mandatory component virtual functions
-	void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
-	void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
-	void releaseResources() override;
-
-	void paint(juce::Graphics& gfx) override;
-	void resized() override;
-
-private:
-	//==============================================================================
-	juce::MixerAudioSource mixerSource;
-
-	// initialize audio and gui for set 1 & 2
-	DJAudioPlayer player1{ formatManager };
-	DJAudioPlayer player2{ formatManager };
-	DeckGUI deckGUI1{ &player1, formatManager, thumbCache };
-	DeckGUI deckGUI2{ &player2, formatManager, thumbCache };
-
-	// draw waveform
-	juce::AudioFormatManager formatManager;
-	juce::AudioThumbnailCache thumbCache{ 100 };
-
-	PlaylistComponent playlistComponent{ &deckGUI1, &deckGUI2 };
-
-	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MainComponent)
-};
+/* 
+	Final Project - Object Oriented Programming Coursework for Endterm: Otodecks
+	==============================================================================
+	Created: 12th January 2023 - 2:00 PM
+	Author:  Muhammad Suleman Mirza
+	==============================================================================
+	If you are facing any problem while running this project, please enable the following Projucer options:
+	1 - using namespace juce; enabled
+	2 - JUCE_MODAL_LOOPS_PERMITTED=1 under preprocessor definitions
+ */
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DeckRegistry.h"
+#include "PlaylistComponent.h"
+#include "TrackMetadataIndex.h"
+#include "LibraryImporter.h"
+#include "TrackLoader.h"
+#include "DecodedTrackCache.h"
+#include "WaveformCache.h"
+#include "TrackAnalyser.h"
+#include "ParallelMixer.h"
+#include "SyncEngine.h"
+
+//==============================================================================
+/* main class container head for other components.
+
+   startup is staged so the window is drawn before anything slow happens. the constructor only
+   builds the components, the first paint schedules opening the audio device and adding the decks,
+   and the playlist then streams the saved library in behind them */
+
+class MainComponent : public juce::AudioAppComponent,
+					  public juce::ChangeListener,
+					  private juce::AsyncUpdater
+{
+public:
+	MainComponent(const juce::File& sessionFile = LibrarySession::getDefaultSessionFile());
+	~MainComponent() override;
+
+	// mandatory component virtual functions
+	void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+	void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+	void releaseResources() override;
+
+	void paint(juce::Graphics& gfx) override;
+	void resized() override;
+
+	// implement ChangeListener, shows and lays out the decks when one is added or removed
+	void changeListenerCallback(juce::ChangeBroadcaster* source) override;
+
+	// milliseconds from construction, zero until that stage has been reached
+	double getTimeToFirstFrame() const;
+	double getTimeToRowsShown() const;
+	double getTimeToInteractive() const;   // audio running, decks up and the library searchable
+	bool isInteractive() const;
+
+private:
+	// runs once after the first frame, see the class comment
+	void handleAsyncUpdate() override;
+	void openAudioDevice();
+	void libraryLoaded();
+
+	//==============================================================================
+	// startup timings, taken first so they cover building everything below
+	double constructionTime{ juce::Time::getMillisecondCounterHiRes() };
+	double firstFrameTime{ 0.0 };
+	double rowsShownTime{ 0.0 };
+	double interactiveTime{ 0.0 };
+
+	juce::AudioFormatManager formatManager;
+
+	// waveforms on disk by file contents, filled in by the track analyser and the track loader
+	WaveformCache waveformCache{ formatManager };
+
+	// opens tracks in the background, and decodes ahead of playback for every deck
+	juce::TimeSliceThread readAheadThread{ "Deck read-ahead" };
+	DecodedTrackCache decodedCache{ (size_t) 1024 * 1024 * 1024 };   // 1 GB of decoded audio, about 50 minutes of stereo at 44.1kHz
+	TrackLoader trackLoader{ formatManager, readAheadThread, decodedCache, waveformCache };
+
+	// the tempo clock synced decks follow, moved on before the mixer renders each block
+	SyncEngine syncEngine;
+
+	// renders the decks on worker threads and sums them
+	ParallelMixer mixerSource;
+
+	// audio and gui for every deck, declared after the mixer so the decks go first
+	DeckRegistry deckRegistry{ mixerSource, formatManager, trackLoader, syncEngine };
+
+	// lengths and tags of library files, only files that changed on disk are opened again
+	TrackMetadataIndex trackIndex{ formatManager };
+	LibraryImporter libraryImporter{ formatManager, trackIndex };
+
+	// tempos, beat grids and keys for every library track, measured on all cores in the background
+	// and kept by file contents so no track is analysed twice
+	AnalysisCache analysisCache;
+	TrackAnalyser trackAnalyser{ formatManager, waveformCache, analysisCache };
+
+	PlaylistComponent playlistComponent;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MainComponent)
+};
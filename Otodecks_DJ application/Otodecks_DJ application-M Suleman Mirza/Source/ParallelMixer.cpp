@@ -0,0 +1,377 @@
+/*
+  ==============================================================================
+
+	ParallelMixer.cpp
+	Created: 17th October 2026 - 11:05 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#include "ParallelMixer.h"
+using namespace juce;
+
+//==============================================================================
+/* mixes the decks like MixerAudioSource, but renders each one into its own buffer on a pool of worker threads.
+   the audio thread renders a deck as well, then only waits for the others and sums them.
+   workers are started in prepareToPlay and keep spinning between callbacks while audio is running, so the
+   steady state never takes a lock. they only sleep on an event once callbacks stop.
+
+   the set of inputs is an immutable graph built on the message thread and swapped in atomically,
+   so decks can come and go while audio is running */
+
+ParallelMixer::ParallelMixer()
+{
+	// retired graphs, and the inputs only they still hold, are released from here
+	startTimer(1000);
+}
+
+ParallelMixer::~ParallelMixer()
+{
+	stopTimer();
+	stopWorkers();
+}
+
+/* adds an input to the mix, ignored if it is already there */
+void ParallelMixer::addInputSource(std::shared_ptr<Input> input)
+{
+	const ScopedLock sl(graphLock);
+	std::vector<std::shared_ptr<Input>> inputs;
+	if (currentGraph != nullptr)
+		inputs = currentGraph->inputs;
+
+	if (input == nullptr || std::find(inputs.begin(), inputs.end(), input) != inputs.end())
+		return;
+
+	// prepared before the audio thread can see it
+	if (prepared)
+		input->prepareToPlay(bufferSize, sampleRate);
+
+	inputs.push_back(input);
+	publishGraph(buildGraph(inputs));
+}
+
+/* takes an input out of the mix, it is destroyed once the audio thread has let go of the old graph */
+void ParallelMixer::removeInputSource(Input* input)
+{
+	const ScopedLock sl(graphLock);
+	if (currentGraph == nullptr)
+		return;
+
+	std::vector<std::shared_ptr<Input>> inputs;
+	for (auto& existing : currentGraph->inputs)
+		if (existing.get() != input)
+			inputs.push_back(existing);
+
+	publishGraph(buildGraph(inputs));
+}
+
+int ParallelMixer::getNumInputs() const
+{
+	const ScopedLock sl(graphLock);
+	return currentGraph != nullptr ? (int) currentGraph->inputs.size() : 0;
+}
+
+void ParallelMixer::setParallelThreshold(int minNumSamples)
+{
+	parallelThreshold.store(jmax(0, minNumSamples));
+}
+
+bool ParallelMixer::isRenderingInParallel() const
+{
+	return renderedInParallel.load();
+}
+
+/* returns how many inputs were playing in the last block */
+int ParallelMixer::getNumActiveInputs() const
+{
+	return numActiveInputs.load();
+}
+
+/* prepares the inputs, sizes their buffers and starts a worker per spare core */
+void ParallelMixer::prepareToPlay(int samplesPerBlockExpected, double newSampleRate)
+{
+	const ScopedLock sl(graphLock);
+	bufferSize = samplesPerBlockExpected;
+	sampleRate = newSampleRate;
+	serialBuffer.setSize(2, bufferSize);
+
+	std::vector<std::shared_ptr<Input>> inputs;
+	if (currentGraph != nullptr)
+		inputs = currentGraph->inputs;
+	for (auto& input : inputs)
+		input->prepareToPlay(bufferSize, sampleRate);
+
+	// nothing is rendering yet, so the resized graph can go straight in
+	prepared = false;
+	publishGraph(buildGraph(inputs));
+	prepared = true;
+
+	// workers keep spinning for a block and a half after their last job, long enough to catch the next callback
+	spinTicks.store((int64) (Time::getHighResolutionTicksPerSecond() * 1.5 * samplesPerBlockExpected / sampleRate));
+
+	// the audio thread waits on the workers, so they are scheduled like it, as realtime threads at the device's period
+	const int numWorkers{ jlimit(0, (int) maxWorkers, SystemStats::getNumCpus() - 1) };
+	const double periodMs{ 1000.0 * samplesPerBlockExpected / sampleRate };
+	if (numWorkers != workers.size() || periodMs != workerPeriodMs)
+	{
+		stopWorkers();
+		workerPeriodMs = periodMs;
+		const auto options = Thread::RealtimeOptions{}.withPeriodMs(periodMs).withMaximumProcessingTimeMs(periodMs);
+		for (int i = 0; i < numWorkers; ++i)
+		{
+			auto* worker = workers.add(new Worker(*this, i));
+			if (!worker->startRealtimeThread(options))
+				worker->startThread(Thread::Priority::highest);
+		}
+	}
+	DBG("ParallelMixer::prepareToPlay: " << (int) inputs.size() << " inputs, " << numWorkers << " workers");
+}
+
+void ParallelMixer::releaseResources()
+{
+	const ScopedLock sl(graphLock);
+	prepared = false;
+	renderedInParallel = false;
+
+	if (currentGraph != nullptr)
+		for (auto& input : currentGraph->inputs)
+			input->releaseResources();
+}
+
+//==============================================================================
+/* builds a graph for a set of inputs, allocating everything the audio thread will need up front */
+ParallelMixer::Graph::Ptr ParallelMixer::buildGraph(std::vector<std::shared_ptr<Input>> inputs) const
+{
+	Graph::Ptr graph{ new Graph() };
+	graph->inputs = std::move(inputs);
+	graph->buffers.resize(graph->inputs.size());
+	for (auto& buffer : graph->buffers)
+		buffer.setSize(2, jmax(1, bufferSize));
+	graph->activeInputs.reserve(graph->inputs.size());
+	return graph;
+}
+
+/* hands a new graph to the audio thread, the previous one is released later on the message thread */
+void ParallelMixer::publishGraph(Graph::Ptr graph)
+{
+	heldGraphs.add(graph);
+	currentGraph = graph;
+	desiredGraph.store(graph.get());
+
+	// nothing is reading while the device is stopped, so the swap can happen right away
+	if (!prepared)
+		activeGraph.store(graph.get());
+}
+
+/* drops our reference to any graph the audio thread can no longer be reading */
+void ParallelMixer::timerCallback()
+{
+	const ScopedLock sl(graphLock);
+	for (int i = heldGraphs.size(); --i >= 0;)
+	{
+		auto* graph = heldGraphs.getUnchecked(i);
+		if (graph != desiredGraph.load() && graph != activeGraph.load())
+			heldGraphs.remove(i);
+	}
+}
+
+/* publishes which graph we are about to read before touching it, then checks it is still wanted */
+ParallelMixer::Graph* ParallelMixer::acquireGraph()
+{
+	Graph* graph = desiredGraph.load();
+	activeGraph.store(graph);
+	while (desiredGraph.load() != graph)
+	{
+		graph = desiredGraph.load();
+		activeGraph.store(graph);
+	}
+	return graph;
+}
+
+//==============================================================================
+/* renders and sums every input that has something to play, in parallel when the block is large enough */
+void ParallelMixer::getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill)
+{
+	Graph* graph = acquireGraph();
+	if (graph == nullptr)
+	{
+		bufferToFill.clearActiveBufferRegion();
+		return;
+	}
+
+	// idle inputs cost nothing, they are not even asked for silence
+	graph->activeInputs.clear();
+	for (int i = 0; i < (int) graph->inputs.size(); ++i)
+		if (!graph->inputs[(size_t) i]->isIdle())
+			graph->activeInputs.push_back(i);
+
+	const int numActive{ (int) graph->activeInputs.size() };
+	numActiveInputs.store(numActive);
+
+	const bool parallel{ numActive > 1
+		&& !workers.isEmpty()
+		&& bufferToFill.numSamples >= parallelThreshold.load()
+		&& bufferToFill.numSamples <= graph->buffers[0].getNumSamples() };
+
+	renderedInParallel.store(parallel);
+	if (parallel)
+		renderParallel(*graph, bufferToFill);
+	else
+		renderSerial(*graph, bufferToFill);
+}
+
+/* the first input renders straight into the output and the rest are added on, as MixerAudioSource does */
+void ParallelMixer::renderSerial(Graph& graph, const AudioSourceChannelInfo& bufferToFill)
+{
+	if (graph.activeInputs.empty())
+	{
+		bufferToFill.clearActiveBufferRegion();
+		return;
+	}
+
+	graph.inputs[(size_t) graph.activeInputs[0]]->getNextAudioBlock(bufferToFill);
+	const int numChannels{ jmin(bufferToFill.buffer->getNumChannels(), serialBuffer.getNumChannels()) };
+	const int chunkSize{ jmax(1, serialBuffer.getNumSamples()) };
+
+	// blocks bigger than prepared for are mixed a buffer's worth at a time
+	for (size_t i = 1; i < graph.activeInputs.size(); ++i)
+	{
+		auto& input = graph.inputs[(size_t) graph.activeInputs[i]];
+		for (int offset = 0; offset < bufferToFill.numSamples; offset += chunkSize)
+		{
+			const int numSamples{ jmin(chunkSize, bufferToFill.numSamples - offset) };
+			AudioSourceChannelInfo info{ &serialBuffer, 0, numSamples };
+			input->getNextAudioBlock(info);
+
+			for (int ch = 0; ch < numChannels; ++ch)
+				bufferToFill.buffer->addFrom(ch, bufferToFill.startSample + offset, serialBuffer, ch, 0, numSamples);
+		}
+	}
+}
+
+/* hands the inputs out to the workers, renders alongside them and sums the buffers once all are done */
+void ParallelMixer::renderParallel(Graph& graph, const AudioSourceChannelInfo& bufferToFill)
+{
+	const int numActive{ (int) graph.activeInputs.size() };
+
+	// fill in the job, then publish it with the new generation and the first input unclaimed
+	const uint64 generation{ (claim.load() >> 32) + 1 };
+	Job& job = jobs[generation & 1];
+	job.graph.store(&graph);
+	job.numInputs.store(numActive);
+	job.numSamples.store(bufferToFill.numSamples);
+	job.remaining.store(numActive);
+	claim.store(generation << 32);
+
+	// workers that gave up spinning need waking, this only happens when callbacks have paused
+	for (int i = 0; i < jmin(workers.size(), numActive - 1); ++i)
+		if (workers.getUnchecked(i)->sleeping.exchange(false))
+			workers.getUnchecked(i)->wakeUp.signal();
+
+	renderInputs();
+
+	// all inputs are claimed by now, the last ones are finishing on other threads
+	while (job.remaining.load() > 0)
+		Thread::yield();
+
+	const int numChannels{ bufferToFill.buffer->getNumChannels() };
+	for (int ch = 0; ch < numChannels; ++ch)
+	{
+		if (ch >= 2)
+		{
+			bufferToFill.buffer->clear(ch, bufferToFill.startSample, bufferToFill.numSamples);
+			continue;
+		}
+
+		bufferToFill.buffer->copyFrom(ch, bufferToFill.startSample, graph.buffers[0], ch, 0, bufferToFill.numSamples);
+		for (int i = 1; i < numActive; ++i)
+			bufferToFill.buffer->addFrom(ch, bufferToFill.startSample, graph.buffers[(size_t) i], ch, 0, bufferToFill.numSamples);
+	}
+}
+
+/* claims inputs one at a time until none are left, called by the audio thread and every worker.
+   the claim and the job's generation change together, so a late worker can never claim from a stale job */
+void ParallelMixer::renderInputs()
+{
+	ScopedNoDenormals noDenormals;
+
+	for (;;)
+	{
+		uint64 current{ claim.load() };
+		Job& job = jobs[(current >> 32) & 1];
+		const int index{ (int) (current & 0xffffffff) };
+
+		if (index >= job.numInputs.load())
+			return;
+		if (!claim.compare_exchange_weak(current, current + 1))
+			continue;
+
+		// the audio thread waits for remaining to reach zero, so the graph stays alive until we are done
+		Graph& graph = *job.graph.load();
+		AudioSourceChannelInfo info{ &graph.buffers[(size_t) index], 0, job.numSamples.load() };
+		graph.inputs[(size_t) graph.activeInputs[(size_t) index]]->getNextAudioBlock(info);
+		job.remaining.fetch_sub(1);
+	}
+}
+
+void ParallelMixer::stopWorkers()
+{
+	for (auto* worker : workers)
+	{
+		worker->signalThreadShouldExit();
+		worker->wakeUp.signal();
+	}
+	workers.clear();
+}
+
+//==============================================================================
+/* a pre-spawned render thread, spins between callbacks and sleeps once they stop coming */
+
+ParallelMixer::Worker::Worker(ParallelMixer& _owner, int index) :
+	Thread{ "Deck render " + String(index + 1) },
+	owner{ _owner }
+{
+}
+
+ParallelMixer::Worker::~Worker()
+{
+	stopThread(1000);
+}
+
+void ParallelMixer::Worker::run()
+{
+	uint64 seenGeneration{ owner.claim.load() >> 32 };
+
+	while (!threadShouldExit())
+	{
+		const int64 spinUntil{ Time::getHighResolutionTicks() + owner.spinTicks.load() };
+		bool hasJob{ false };
+
+		for (int n = 1; !threadShouldExit(); ++n)
+		{
+			if ((owner.claim.load() >> 32) != seenGeneration)
+			{
+				hasJob = true;
+				break;
+			}
+			if (Time::getHighResolutionTicks() > spinUntil)
+				break;
+			if (n % 64 == 0)
+				Thread::yield();
+		}
+
+		if (hasJob)
+		{
+			seenGeneration = owner.claim.load() >> 32;
+			owner.renderInputs();
+			continue;
+		}
+
+		// checking again after raising the flag means a job published in between is never missed
+		sleeping.store(true);
+		if ((owner.claim.load() >> 32) == seenGeneration)
+			wakeUp.wait(100);
+		sleeping.store(false);
+	}
+}
@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+	ParallelMixer.h
+	Created: 17th October 2026 - 10:40 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/* mixes the decks like MixerAudioSource, but renders each one into its own buffer on a pool of worker threads.
+   the audio thread renders a deck as well, then only waits for the others and sums them.
+   workers are started in prepareToPlay and keep spinning between callbacks while audio is running, so the
+   steady state never takes a lock. they only sleep on an event once callbacks stop.
+
+   the set of inputs is an immutable graph built on the message thread and swapped in atomically,
+   so decks can come and go while audio is running */
+
+class ParallelMixer : public juce::AudioSource,
+					  private juce::Timer
+{
+public:
+	// a mixer input that can say when it has nothing to play, idle inputs are not rendered at all
+	class Input : public juce::AudioSource
+	{
+	public:
+		virtual bool isIdle() const = 0;
+	};
+
+	ParallelMixer();
+	~ParallelMixer() override;
+
+	// message thread, new inputs are prepared before they join the graph. safe while audio is running
+	void addInputSource(std::shared_ptr<Input> input);
+	void removeInputSource(Input* input);
+	int getNumInputs() const;
+
+	// blocks shorter than this are rendered one deck after another, waking workers would cost more than it saves
+	void setParallelThreshold(int minNumSamples);
+
+	// prepares every input as well, like MixerAudioSource
+	void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+	void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+	void releaseResources() override;
+
+	// true if the last block was rendered on more than one thread
+	bool isRenderingInParallel() const;
+	int getNumActiveInputs() const;
+
+private:
+	// everything the audio thread needs for one set of inputs, never changed once published
+	class Graph : public juce::ReferenceCountedObject
+	{
+	public:
+		using Ptr = juce::ReferenceCountedObjectPtr<Graph>;
+
+		std::vector<std::shared_ptr<Input>> inputs;
+		std::vector<juce::AudioBuffer<float>> buffers;   // one per input, for the parallel path
+		std::vector<int> activeInputs;   // audio thread scratch, reserved for every input
+	};
+
+	// one render request, two slots so a late worker never sees the next block's job half written
+	struct Job
+	{
+		std::atomic<Graph*> graph{ nullptr };
+		std::atomic<int> numInputs{ 0 };
+		std::atomic<int> numSamples{ 0 };
+		std::atomic<int> remaining{ 0 };
+	};
+
+	class Worker : public juce::Thread
+	{
+	public:
+		Worker(ParallelMixer& _owner, int index);
+		~Worker() override;
+		void run() override;
+
+		std::atomic<bool> sleeping{ false };
+		juce::WaitableEvent wakeUp;
+
+	private:
+		ParallelMixer& owner;
+	};
+
+	static constexpr int maxWorkers{ 7 };
+
+	Graph* acquireGraph();
+	Graph::Ptr buildGraph(std::vector<std::shared_ptr<Input>> inputs) const;
+	void publishGraph(Graph::Ptr graph);
+	void timerCallback() override;
+
+	void renderSerial(Graph& graph, const juce::AudioSourceChannelInfo& bufferToFill);
+	void renderParallel(Graph& graph, const juce::AudioSourceChannelInfo& bufferToFill);
+	void renderInputs();
+	void stopWorkers();
+
+	// message thread side of the graph handoff, same scheme as TrackSource
+	juce::CriticalSection graphLock;   // never taken by the audio thread
+	Graph::Ptr currentGraph;
+	juce::ReferenceCountedArray<Graph> heldGraphs;
+	std::atomic<Graph*> desiredGraph{ nullptr };
+	std::atomic<Graph*> activeGraph{ nullptr };
+
+	juce::AudioBuffer<float> serialBuffer;
+	juce::OwnedArray<Worker> workers;
+	double workerPeriodMs{ 0.0 };
+	int bufferSize{ 0 };
+	double sampleRate{ 0.0 };
+	bool prepared{ false };
+	std::atomic<int> parallelThreshold{ 128 };
+	std::atomic<bool> renderedInParallel{ false };
+	std::atomic<int> numActiveInputs{ 0 };
+
+	// the high half is the job's generation, the low half the next input to claim
+	std::atomic<juce::uint64> claim{ 0 };
+	Job jobs[2];
+	std::atomic<juce::int64> spinTicks{ 0 };
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParallelMixer)
+};
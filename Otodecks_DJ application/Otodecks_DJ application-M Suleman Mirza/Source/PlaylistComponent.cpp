@@ -1,473 +1,633 @@
-/*
-  ==============================================================================
-
-	PlaylistComponent.cpp
-	Created: 07th February 2023 - 11:54 PM
-	Author:  Muhammad Suleman Mirza
-
-  ==============================================================================
-*/
-
-#include <JuceHeader.h>
-#include "PlaylistComponent.h"
-using namespace juce;
-
-//==============================================================================
-/* component that displays the track playlist and handles functions related to parsing file data */
-
-PlaylistComponent::PlaylistComponent(DeckGUI* _deckGUI1,
-									 DeckGUI* _deckGUI2) :
-	deckGUI1{ _deckGUI1 },
-	deckGUI2{ _deckGUI2 }
-{
-	// toolbar GUI components
-	loadPlaylistButton.addListener(this);
-	addAndMakeVisible(loadPlaylistButton);
-	
-	customize.searchBox(&searchBox);
-	searchBox.addListener(this);
-	searchBox.onTextChange = [this] { searchPlaylist(searchBox.getText()); };
-
-	// modify table column headers
-	tableComponent.getHeader().addColumn("Deck 1", 1, 50); // load deck 1 button
-	tableComponent.getHeader().addColumn("Deck 2", 2, 50); // load deck 2 button
-	tableComponent.getHeader().addColumn("Track Title", 3, 300);
-	tableComponent.getHeader().addColumn("Length", 4, 350);
-	tableComponent.getHeader().addColumn("File Ext.", 5, 350);
-	tableComponent.getHeader().addColumn("Delete", 6, 50); // delete button
-
-	tableComponent.setModel(this);
-	tableComponent.getViewport()->setScrollBarsShown(true, false, false, false);
-	addAndMakeVisible(tableComponent);
-	loadLastSession();
-}
-
-PlaylistComponent::~PlaylistComponent()
-{
-	saveSession();
-}
-
-void PlaylistComponent::paint(Graphics& gfx)
-{
-	gfx.fillAll(getLookAndFeel().findColour(ResizableWindow::backgroundColourId));   // remove the background colour
-
-	gfx.setColour(Colours::firebrick);
-	gfx.drawRect(getLocalBounds(), 1);   // draw an outline around the component
-
-	gfx.setColour(Colours::white);
-	gfx.setFont(14.0f);
-	gfx.drawText("", getLocalBounds(), Justification::centred, true);   // Create some text to draw as a placeholder.
-}
-
-void PlaylistComponent::resized()
-{
-	int toolbarHeight = 40;
-	loadPlaylistButton.setBounds(0, 0, getWidth() / 2, toolbarHeight);
-	searchBox.setBounds(getWidth() / 2, 0, getWidth() / 2, toolbarHeight);
-
-	tableComponent.setBounds(0, toolbarHeight, getWidth(), getHeight() - toolbarHeight);
-	DBG("Height of playlist: " << getHeight());
-
-	// dynamically resize playlist cells
-	int colBlock = getWidth() / 16;
-	tableComponent.getHeader().setColumnWidth(1, colBlock); // load deck 1 button
-	tableComponent.getHeader().setColumnWidth(2, colBlock); // load deck 2 button
-	tableComponent.getHeader().setColumnWidth(3, colBlock * 6);
-	tableComponent.getHeader().setColumnWidth(4, colBlock * 5);
-	tableComponent.getHeader().setColumnWidth(5, colBlock * 2);
-	tableComponent.getHeader().setColumnWidth(6, colBlock); // delete button
-}
-
-/* returns the size of the current playlist, or if searching the search list */
-int PlaylistComponent::getNumRows()
-{
-	if (!searchBox.isEmpty())
-		return (int) searchHits.size();
-	else
-		return (int) tracks.size();
-}
-
-/* paint background colour of cells in the table class */
-void PlaylistComponent::paintRowBackground(Graphics& gfx, int rowNum, int width, int height, bool rowSelected)
-{
-	// alternating colour effect
-	if (rowSelected) {
-		gfx.fillAll(Colours::darkorange);
-	}
-	else {
-		if (fmod(rowNum, 2) == 0)
-		{
-			gfx.fillAll(Colours::grey.darker());
-		}
-		else {
-			gfx.fillAll(Colours::grey);
-		}
-	}
-}
-
-/* draws other items into each table cell ie. text, calls tableComponent.updateContent() to refresh appearance */
-void PlaylistComponent::paintCell(Graphics& gfx, int rowNum, int columnId, int width, int height, bool rowSelected)
-{
-		// performs different actions depending on column
-		if (columnId == 3)
-		{
-			// load deck 1 text
-			if (!searchBox.isEmpty())
-			{
-				if (rowNum < getNumRows()) // prevent vector out of range
-					gfx.drawText(searchHits[rowNum].title, 2, 0, width - 4, height, Justification::centredLeft, true);
-			}
-			else
-			{
-				if (rowNum < getNumRows())
-					gfx.drawText(tracks[rowNum].title, 2, 0, width - 4, height, Justification::centredLeft, true);
-			}
-		}
-		if (columnId == 4)
-		{
-			// load deck 2 text
-			if (!searchBox.isEmpty())
-			{
-				if (rowNum < getNumRows())
-					gfx.drawText(searchHits[rowNum].length, 2, 0, width - 4, height, Justification::centredLeft, true);
-			}
-			else
-			{
-				if (rowNum < getNumRows())
-					gfx.drawText(tracks[rowNum].length, 2, 0, width - 4, height, Justification::centredLeft, true);
-			}
-		}
-		if (columnId == 5)
-		{
-			// delete button text
-			if (!searchBox.isEmpty())
-			{
-				if (rowNum < getNumRows())
-					gfx.drawText(searchHits[rowNum].fileExtension, 2, 0, width - 4, height, Justification::centredLeft, true);
-			}
-			else
-			{
-				if (rowNum < getNumRows())
-					gfx.drawText(tracks[rowNum].fileExtension, 2, 0, width - 4, height, Justification::centredLeft, true);
-			}
-		}
-}
-
-/* draws buttons and listener objects for each cell in table list, also appends a unique buttonID */
-Component* PlaylistComponent::refreshComponentForCell(int rowNum, int columnId, bool isRowSelected, Component* UpdateExistingComponent)
-{
-	// row iterates starting 0, column iterates starting 1
-	if (columnId == 1 || columnId == 2)
-	{
-		// generate load deck 1 & deck 2 buttonID 
-		if (UpdateExistingComponent == nullptr)
-		{
-			TextButton* btn = new TextButton{ "Load" };
-			String id{ std::to_string(rowNum) + std::to_string(columnId) };
-			btn->setComponentID(id);
-
-			btn->addListener(this);
-			UpdateExistingComponent = btn;
-		}
-	}
-	if (columnId == 6)
-	{
-		// generate delete track buttonID 
-		if (UpdateExistingComponent == nullptr)
-		{
-			TextButton* btn = new TextButton{ "x" };
-			String id{ std::to_string(rowNum) + std::to_string(columnId) };
-			btn->setComponentID(id);
-
-			btn->addListener(this);
-			UpdateExistingComponent = btn;
-		}
-	}
-	return UpdateExistingComponent;
-}
-
-/* listener class to identify button interaction */
-void PlaylistComponent::buttonClicked(Button* button)
-{
-	if (button == &loadPlaylistButton)
-	{
-		// opens file browser to select multiple files
-		DBG("Load Playlist Button was clicked");
-		loadPlaylist();
-	}
-	else 
-	{
-		// buttons in playlist were clicked, indentify by ID
-		int buttonID = std::stoi(button->getComponentID().toStdString());
-		DBG("PlaylistComponent::buttonClicked: " << button->getComponentID());
-
-		handlePlaylistButtons(buttonID);
-	}
-}
-
-bool PlaylistComponent::isInterestedInFileDrag(const StringArray& files)
-{
-	// allows for dragging of files into player window
-	DBG("PlaylistComponent::isInterestedInFileDrag");
-	return true;
-}
-
-/* parses audio file data and adds them to the playlist */
-void PlaylistComponent::filesDropped(const StringArray& files, int x, int y)
-{
-	// list of selected items stored as str array "files"
-	if (files.size() >= 1)
-	{
-		for (const File& file : files)
-		{
-			juce::String fileName{ file.getFileNameWithoutExtension() };
-			if (!checkDupeTracks(fileName)) // check if duplicate file loaded
-			{
-				// create new track object, save file path, parse track length, append track to tracks list
-				Track createTrack{ file };
-				juce::URL audioURL{ file };
-				createTrack.length = getLengthMinutes(audioURL);
-				tracks.push_back(createTrack);
-				DBG("PlaylistComponent::filesDropped: dropped files loaded: " << createTrack.title);
-			}
-			else
-			{
-				// track already loaded
-				DBG("PlaylistComponent::filesDropped: Duplicate file already loaded: " << fileName);
-			}
-		}
-		// update library display after loading files
-		tableComponent.updateContent();
-	}
-}
-
-
-//==============================================================================
-/* searches through current playlist for matching substring, and highlights row */
-void PlaylistComponent::searchPlaylist(juce::String searchText)
-{
-	// search through Playlist, append search results to searchHits list to display
-	DBG("PlaylistComponent::searchPlaylist: Searching for: " << searchText);
-	if (searchText != "")
-	{
-		searchHits.clear();
-		for (Track& track : tracks)
-		{
-			if (track.title.toLowerCase().contains(searchText.toLowerCase().trim()))
-			{
-				searchHits.push_back(track);
-			}
-		}
-		int row = highlightTrack(searchText);
-		tableComponent.selectRow(row);
-		
-		DBG("searchHits.size() results: " << std::to_string(searchHits.size()));
-	}
-	else
-	{
-		tableComponent.deselectAllRows();
-	}
-	tableComponent.updateContent();
-	repaint();
-}
-
-/* returns index to highlight first row that matches search substring */
-int PlaylistComponent::highlightTrack(juce::String searchText)
-{
-	// locate the index with searchText in title track 
-	auto it = find_if(searchHits.begin(), searchHits.end(), [&searchText](const Track& obj) 
-		{return obj.title.toLowerCase().contains(searchText.toLowerCase().trim()); });
-	int i = -1;
-
-	if (it != searchHits.end())
-	{
-		i = (int) std::distance(searchHits.begin(), it);
-	}
-
-	return i;
-}
-
-/* opens file browser and parses selected file(s) into playlist */
-void PlaylistComponent::loadPlaylist()
-{
-	// opens file browser to select multiple files
-	FileChooser chooser{ "Select files..." };
-	if (chooser.browseForMultipleFilesToOpen())
-	{
-		for (const File& file : chooser.getResults())
-		{
-			juce::String fileName{ file.getFileNameWithoutExtension() };
-			if (!checkDupeTracks(fileName)) // check if duplicate file loaded
-			{
-				// create new track object, save file path, parse track length, append track to tracks list
-				Track createTrack{ file };
-				juce::URL audioURL{ file };
-				createTrack.length = getLengthMinutes(audioURL);
-				tracks.push_back(createTrack);
-				DBG("PlaylistComponent::buttonClicked: file loaded: " << createTrack.title);
-			}
-			else 
-			{
-				// track already loaded
-				DBG("PlaylistComponent::buttonClicked: Duplicate file already loaded: " << fileName);
-			}
-		}
-		// update library display after loading files
-		tableComponent.updateContent();
-	}
-}
-
-
-/* identify component buttons by parsing buttonId (in a 2 number format : row, col) */
-void PlaylistComponent::handlePlaylistButtons(int buttonID)
-{
-	int row = floor(buttonID / 10); // row is first digit
-	int col = fmod(buttonID, 10);   // column is second digit
-
-	// load deck 1
-	if (col == 1)
-	{
-		if (!searchBox.isEmpty()) // if there is a search query, read searchHits instead
-		{
-			if (deckGUI1->player->loadURL(searchHits[row].URL)) {
-				deckGUI1->togglePlayButton();
-			}
-			deckGUI1->waveformDisplay.loadURL(searchHits[row].URL);
-			deckGUI1->deckTitle.setText(searchHits[row].title, dontSendNotification);
-		}
-		else
-		{
-			if (deckGUI1->player->loadURL(tracks[row].URL)) {
-				deckGUI1->togglePlayButton();
-			}
-			deckGUI1->waveformDisplay.loadURL(tracks[row].URL);
-			deckGUI1->deckTitle.setText(tracks[row].title, dontSendNotification);
-		}
-	}
-
-	// load deck 2
-	if (col == 2)
-	{
-		if (!searchBox.isEmpty())
-		{
-			if (deckGUI2->player->loadURL(searchHits[row].URL)) {
-				deckGUI2->togglePlayButton();
-			}
-			deckGUI2->waveformDisplay.loadURL(searchHits[row].URL);
-			deckGUI2->deckTitle.setText(searchHits[row].title, dontSendNotification);
-		}
-		else
-		{
-			if (deckGUI2->player->loadURL(tracks[row].URL)) {
-				deckGUI2->togglePlayButton();
-			}
-			deckGUI2->waveformDisplay.loadURL(tracks[row].URL);
-			deckGUI2->deckTitle.setText(tracks[row].title, dontSendNotification);
-		}
-	}
-
-	// delete button
-	if (col == 6)
-	{
-		if (!searchBox.isEmpty())
-		{
-			DBG("PlaylistComponent::buttonClicked: searching for track, delete disabled");
-		}
-		else
-		{
-			tracks.erase(tracks.begin() + row);
-			DBG("PlaylistComponent::buttonClicked: track " << row << " deleted");
-		}
-		tableComponent.updateContent();
-	}
-}
-
-/* parse time from a double into minute string format : "00:00" */
-std::string PlaylistComponent::secondsToMinutes(double seconds)
-{
-	seconds = std::round(seconds);
-
-	std::string minString{ "" };
-	std::string secString{ "" };
-
-	int min{ int(seconds / 60) };
-	int sec{ int(std::fmod(seconds, 60)) };
-
-	std::cout << "min: " << min << ", sec: " << sec << std::endl;
-
-	// adds an extra 0 infront if digits are less than 10
-	if (min < 10)
-	{
-		minString = "0" + std::to_string(min);
-	}
-	else
-	{
-		minString = std::to_string(min);
-	}
-	if (sec < 10)
-	{
-		secString = "0" + std::to_string(sec);
-	}
-	else
-	{
-		secString = std::to_string(sec);
-	}
-
-	std::cout << "minString: " << minString << ", secString: " << secString << std::endl;
-
-	return std::string(minString + ":" + secString);
-}
-
-/* asks DJAudioplayer for audio length, then parses data calling by secondsToMinutes() */
-String PlaylistComponent::getLengthMinutes(juce::URL audioURL)
-{
-	double lengthInSeconds = deckGUI1->player->getLengthAudioURL(audioURL);
-	std::string lengthInMinutes = secondsToMinutes(lengthInSeconds);
-
-	DBG("PlaylistComponent::getLengthMinutes: track length: " << lengthInMinutes);
-	return juce::String(lengthInMinutes);
-}
-
-/* checks playlist if file name already exists in playlist */
-bool PlaylistComponent::checkDupeTracks(juce::String fileName)
-{
-	return (std::find(tracks.begin(), tracks.end(), fileName) != tracks.end());
-}
-
-
-//==============================================================================
-/* save playlist data when exiting program, uses fstream */
-void PlaylistComponent::saveSession()
-{
-	// Make a .csv file in order to store the playlist.
-	std::ofstream savedPlaylist("saved-playlist.csv");
-
-	// save the playlist to a file
-	for (Track& track : tracks)
-	{
-		savedPlaylist << track.file.getFullPathName() << "," << track.length << "\n";
-	}
-}
-
-/* load playlist data when opening program, reads specific .csv file in same directory */
-void PlaylistComponent::loadLastSession()
-{
-	// generate an input stream using a previously saved session
-	std::ifstream savedPlaylist("saved-playlist.csv");
-	std::string filePath;
-	std::string length;
-
-	// read the data, and then construct new objects line by line.
-	if (savedPlaylist.is_open())
-	{
-		while (getline(savedPlaylist, filePath, ',')) {
-			File file{ filePath };
-			Track newTrack{ file };
-
-			getline(savedPlaylist, length);
-			newTrack.length = length;
-			tracks.push_back(newTrack);
-		}
-	}
-	savedPlaylist.close();
+/*
+  ==============================================================================
+
+	PlaylistComponent.cpp
+	Created: 07th February 2023 - 11:54 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "PlaylistComponent.h"
+using namespace juce;
+
+//==============================================================================
+/* component that displays the track playlist and handles functions related to parsing file data */
+
+PlaylistComponent::PlaylistComponent(DeckRegistry& _deckRegistry,
+									 LibraryImporter& _importer,
+									 TrackAnalyser& _analyser,
+									 const File& sessionFile) :
+	session{ tracks, queryEngine, sessionFile },
+	deckRegistry{ _deckRegistry },
+	importer{ _importer },
+	analyser{ _analyser }
+{
+	// toolbar GUI components
+	loadPlaylistButton.addListener(this);
+	addAndMakeVisible(loadPlaylistButton);
+	addDeckButton.addListener(this);
+	addAndMakeVisible(addDeckButton);
+	removeDeckButton.addListener(this);
+	addAndMakeVisible(removeDeckButton);
+	
+	customize.searchBox(&searchBox);
+	searchBox.addListener(this);
+	searchBox.onTextChange = [this] { searchPlaylist(searchBox.getText()); };
+
+	// imports run on a thread pool and come back here a batch at a time
+	addChildComponent(importProgressBar);
+	importer.onBatchImported = [this](const std::vector<TrackMetadata>& batch) { addImportedTracks(batch); };
+	importer.onImportFinished = [this](bool wasCancelled) { importFinished(wasCancelled); };
+	importer.onTracksRefreshed = [this](const std::vector<LibraryImporter::RefreshedTrack>& batch) { tracksRefreshed(batch); };
+
+	// tempos, beat grids and keys are measured in the background once tracks are in the library
+	analyser.onTracksAnalysed = [this](const std::vector<TrackAnalyser::AnalysedTrack>& batch) { tracksAnalysed(batch); };
+
+	// the library is read in the background by loadLastSession(), until then it can be browsed but not changed
+	session.onStoreLoaded = [this] { lastSessionRowsLoaded(); };
+	session.onLoaded = [this](bool loaded) { lastSessionLoaded(loaded); };
+	loadPlaylistButton.setEnabled(false);
+	searchBox.setEnabled(false);
+
+	// modify table column headers, the deck load columns are added in front by updateDeckColumns()
+	tableComponent.getHeader().addColumn("Track Title", 3, 300);
+	tableComponent.getHeader().addColumn("Length", 4, 350);
+	tableComponent.getHeader().addColumn("BPM", 7, 100);
+	tableComponent.getHeader().addColumn("Key", 8, 100);
+	tableComponent.getHeader().addColumn("File Ext.", 5, 350);
+	tableComponent.getHeader().addColumn("Delete", 6, 50, 30, -1, TableHeaderComponent::notSortable); // delete button
+
+	tableComponent.setModel(this);
+	tableComponent.getViewport()->setScrollBarsShown(true, false, false, false);
+	addAndMakeVisible(tableComponent);
+
+	deckRegistry.addChangeListener(this);
+	updateDeckColumns();
+}
+
+PlaylistComponent::~PlaylistComponent()
+{
+	deckRegistry.removeChangeListener(this);
+	importer.onBatchImported = nullptr;
+	importer.onImportFinished = nullptr;
+	importer.onTracksRefreshed = nullptr;
+	analyser.onTracksAnalysed = nullptr;
+	saveSession();
+}
+
+void PlaylistComponent::paint(Graphics& gfx)
+{
+	gfx.fillAll(getLookAndFeel().findColour(ResizableWindow::backgroundColourId));   // remove the background colour
+
+	gfx.setColour(Colours::firebrick);
+	gfx.drawRect(getLocalBounds(), 1);   // draw an outline around the component
+
+	gfx.setColour(Colours::white);
+	gfx.setFont(14.0f);
+	gfx.drawText("", getLocalBounds(), Justification::centred, true);   // Create some text to draw as a placeholder.
+}
+
+void PlaylistComponent::resized()
+{
+	int toolbarHeight = 40;
+	loadPlaylistButton.setBounds(0, 0, getWidth() / 4, toolbarHeight);
+	addDeckButton.setBounds(getWidth() / 4, 0, getWidth() / 8, toolbarHeight);
+	removeDeckButton.setBounds(getWidth() * 3 / 8, 0, getWidth() / 8, toolbarHeight);
+	searchBox.setBounds(getWidth() / 2, 0, getWidth() / 2, toolbarHeight);
+
+	// the progress bar takes a strip off the top of the table while importing
+	if (importProgressBar.isVisible())
+	{
+		importProgressBar.setBounds(0, toolbarHeight, getWidth(), 20);
+		toolbarHeight += 20;
+	}
+
+	tableComponent.setBounds(0, toolbarHeight, getWidth(), getHeight() - toolbarHeight);
+	DBG("Height of playlist: " << getHeight());
+
+	// dynamically resize playlist cells
+	int numDecks = deckRegistry.getNumDecks();
+	int colBlock = getWidth() / (16 + numDecks);
+	for (int i = 0; i < numDecks; ++i)
+		tableComponent.getHeader().setColumnWidth(firstDeckColumn + i, colBlock); // load deck buttons
+	tableComponent.getHeader().setColumnWidth(3, colBlock * 6);
+	tableComponent.getHeader().setColumnWidth(4, colBlock * 3);
+	tableComponent.getHeader().setColumnWidth(7, colBlock * 2);
+	tableComponent.getHeader().setColumnWidth(8, colBlock * 2);
+	tableComponent.getHeader().setColumnWidth(5, colBlock * 2);
+	tableComponent.getHeader().setColumnWidth(6, colBlock); // delete button
+}
+
+/* returns the size of the current playlist, or if searching the search list */
+int PlaylistComponent::getNumRows()
+{
+	return view.getNumRows();
+}
+
+/* paint background colour of cells in the table class */
+void PlaylistComponent::paintRowBackground(Graphics& gfx, int rowNum, int width, int height, bool rowSelected)
+{
+	// a track's file is only checked once its row is drawn, the answer repaints the row a moment later
+	const int index{ view.getTrackIndex(rowNum) };
+	if (index >= 0 && tracks.getFileStatus(index) == TrackStore::unchecked)
+	{
+		tracks.setFileStatus(index, TrackStore::checking);
+		importer.refreshTrack(tracks.getId(index), tracks.getFile(index), tracks.getLengthInSeconds(index) <= 0.0);
+	}
+
+	// alternating colour effect
+	if (rowSelected) {
+		gfx.fillAll(Colours::darkorange);
+	}
+	else {
+		if (rowNum % 2 == 0)
+		{
+			gfx.fillAll(Colours::grey.darker());
+		}
+		else {
+			gfx.fillAll(Colours::grey);
+		}
+	}
+}
+
+/* draws other items into each table cell ie. text, calls tableComponent.updateContent() to refresh appearance */
+void PlaylistComponent::paintCell(Graphics& gfx, int rowNum, int columnId, int width, int height, bool rowSelected)
+{
+	// the view maps the row to a track whether or not a search is showing, -1 if the row has gone
+	const int index{ view.getTrackIndex(rowNum) };
+	if (index < 0)
+		return;
+
+	// files that have gone from disk stay in the playlist but are drawn dimmed
+	if (tracks.getFileStatus(index) == TrackStore::missing)
+		gfx.setColour(Colours::black.withAlpha(0.4f));
+
+	// performs different actions depending on column, text is only built for the cells on screen
+	if (columnId == 3)
+		gfx.drawText(tracks.getTitle(index), 2, 0, width - 4, height, Justification::centredLeft, true);
+	else if (columnId == 4 && tracks.getLengthInSeconds(index) > 0.0)   // blank until the file has been probed
+		gfx.drawText(secondsToMinutes(tracks.getLengthInSeconds(index)), 2, 0, width - 4, height, Justification::centredLeft, true);
+	else if (columnId == 5)
+		gfx.drawText(tracks.getExtension(index), 2, 0, width - 4, height, Justification::centredLeft, true);
+	else if (columnId == 7 && tracks.getBpm(index) > 0.0)   // blank until analysed, or if the track has no steady beat
+		gfx.drawText(String(tracks.getBpm(index), 1), 2, 0, width - 4, height, Justification::centredLeft, true);
+	else if (columnId == 8)   // blank until analysed, or if no key stands out
+		gfx.drawText(tracks.getKey(index), 2, 0, width - 4, height, Justification::centredLeft, true);
+}
+
+/* creates the load and delete buttons once per visible cell, then reuses them as rows scroll past */
+Component* PlaylistComponent::refreshComponentForCell(int rowNum, int columnId, bool isRowSelected, Component* UpdateExistingComponent)
+{
+	if (columnId != 6 && columnId < firstDeckColumn)
+		return nullptr;
+
+	auto* button = dynamic_cast<RowButton*>(UpdateExistingComponent);
+	if (button == nullptr)
+	{
+		// generate load deck or delete track button
+		button = new RowButton{ columnId == 6 ? "x" : "Load" };
+		button->addListener(this);
+	}
+
+	// a recycled button may have been showing another row, or another deck's column
+	button->row = rowNum;
+	button->column = columnId;
+	return button;
+}
+
+/* clicking a header sorts the view, the tracks themselves never move */
+void PlaylistComponent::sortOrderChanged(int newSortColumnId, bool isForwards)
+{
+	PlaylistViewModel::SortKey sortKey{ PlaylistViewModel::playlistOrder };
+	if (newSortColumnId == 3)
+		sortKey = PlaylistViewModel::title;
+	else if (newSortColumnId == 4)
+		sortKey = PlaylistViewModel::length;
+	else if (newSortColumnId == 5)
+		sortKey = PlaylistViewModel::format;
+	else if (newSortColumnId == 7)
+		sortKey = PlaylistViewModel::tempo;
+	else if (newSortColumnId == 8)
+		sortKey = PlaylistViewModel::key;
+
+	view.setSortOrder(sortKey, isForwards);
+	tableComponent.updateContent();
+	repaint();
+}
+
+/* listener class to identify button interaction */
+void PlaylistComponent::buttonClicked(Button* button)
+{
+	if (button == &loadPlaylistButton)
+	{
+		// doubles as the cancel button while an import runs
+		DBG("Load Playlist Button was clicked");
+		if (importer.isImporting())
+			importer.cancelImport();
+		else
+			loadPlaylist();
+	}
+	else if (button == &addDeckButton)
+	{
+		deckRegistry.addDeck();
+	}
+	else if (button == &removeDeckButton)
+	{
+		// the last deck added goes first
+		if (auto* deck = deckRegistry.getDeck(deckRegistry.getNumDecks() - 1))
+			deckRegistry.removeDeck(deck->id);
+	}
+	else if (auto* rowButton = dynamic_cast<RowButton*>(button))
+	{
+		// buttons in playlist were clicked, they know their own row and column
+		DBG("PlaylistComponent::buttonClicked: row " << rowButton->row << ", column " << rowButton->column);
+		handlePlaylistButtons(rowButton->row, rowButton->column);
+	}
+}
+
+bool PlaylistComponent::isInterestedInFileDrag(const StringArray& files)
+{
+	// allows for dragging of files into player window, once the saved library is in
+	DBG("PlaylistComponent::isInterestedInFileDrag");
+	return libraryLoaded;
+}
+
+/* imports dropped files and folders into the playlist */
+void PlaylistComponent::filesDropped(const StringArray& files, int x, int y)
+{
+	// list of selected items stored as str array "files"
+	Array<File> dropped;
+	for (auto& path : files)
+		dropped.add(File{ path });
+
+	if (!dropped.isEmpty())
+		startImport(dropped);
+}
+
+/* the registry added or removed a deck */
+void PlaylistComponent::changeListenerCallback(ChangeBroadcaster* source)
+{
+	updateDeckColumns();
+}
+
+/* keeps one load column per deck in front of the track columns, titled after the deck it loads */
+void PlaylistComponent::updateDeckColumns()
+{
+	auto& header = tableComponent.getHeader();
+	int numDecks = deckRegistry.getNumDecks();
+	int numColumns = header.getNumColumns(false) - 6;   // title, length, bpm, key, ext. and delete are always there
+
+	for (int i = numColumns; i < numDecks; ++i)
+		header.addColumn("", firstDeckColumn + i, 50, 30, -1, TableHeaderComponent::notSortable, i);
+	for (int i = numColumns; --i >= numDecks;)
+		header.removeColumn(firstDeckColumn + i);
+
+	for (int i = 0; i < numDecks; ++i)
+		header.setColumnName(firstDeckColumn + i, "Deck " + String(deckRegistry.getDeck(i)->id));
+
+	// a deck can only be removed while another is left to play on
+	addDeckButton.setEnabled(numDecks < DeckRegistry::maxDecks);
+	removeDeckButton.setEnabled(numDecks > 1);
+
+	resized();
+	tableComponent.updateContent();
+}
+
+
+//==============================================================================
+/* searches the playlist with the query engine, and highlights the best match */
+void PlaylistComponent::searchPlaylist(juce::String searchText)
+{
+	// words can have typos and fields can be filtered, the view shows only the matching tracks
+	DBG("PlaylistComponent::searchPlaylist: Searching for: " << searchText);
+	if (searchText != "")
+	{
+		view.setFilter(queryEngine.search(searchText));
+
+		// results come back best first, so the first row is the closest match unless a column is sorted
+		tableComponent.selectRow(view.getNumRows() == 0 ? -1 : 0);
+		
+		DBG("search results: " << view.getNumRows());
+	}
+	else
+	{
+		view.clearFilter();
+		tableComponent.deselectAllRows();
+	}
+	tableComponent.updateContent();
+	repaint();
+}
+
+/* opens file browser and imports selected files and folders into playlist */
+void PlaylistComponent::loadPlaylist()
+{
+	// opens file browser to select multiple files or whole folders
+	FileChooser chooser{ "Select files or folders..." };
+	if (chooser.browseForMultipleFilesOrDirectories())
+		startImport(chooser.getResults());
+}
+
+/* hands files to the importer, folders are walked on its threads */
+void PlaylistComponent::startImport(const Array<File>& files)
+{
+	importer.importFiles(files);
+	importProgress = importer.getProgress();
+	loadPlaylistButton.setButtonText("Cancel Import");
+	importProgressBar.setVisible(true);
+	resized();
+}
+
+/* adds a batch of probed files to the playlist, skipping duplicates */
+void PlaylistComponent::addImportedTracks(const std::vector<TrackMetadata>& batch)
+{
+	for (const TrackMetadata& metadata : batch)
+	{
+		// create new track object, length comes from the metadata index
+		Track createTrack{ File{ metadata.path } };
+		createTrack.lengthInSeconds = metadata.lengthInSeconds;
+		createTrack.sampleRate = metadata.sampleRate;
+		createTrack.fingerprint = metadata.fingerprint;
+		createTrack.tags = metadata.tags.getAllValues().joinIntoString(" ");
+
+		if (!checkDupeTracks(createTrack)) // check if duplicate file loaded
+		{
+			addTrack(createTrack);
+			if (metadata.readable)
+				analyser.analyse(tracks.getId(tracks.size() - 1), createTrack.file);
+		}
+		else
+		{
+			// track already loaded
+			DBG("PlaylistComponent::addImportedTracks: Duplicate file already loaded: " << metadata.path);
+		}
+	}
+
+	// update library display after each batch, a running search picks up the new tracks too
+	importProgress = importer.getProgress();
+	if (!searchBox.isEmpty())
+		searchPlaylist(searchBox.getText());
+	else
+		tableComponent.updateContent();
+	DBG("PlaylistComponent::addImportedTracks: " << importer.getNumImported() << " of " << importer.getNumFound());
+}
+
+/* marks the rows whose files were checked, and fills in lengths that were not known yet */
+void PlaylistComponent::tracksRefreshed(const std::vector<LibraryImporter::RefreshedTrack>& batch)
+{
+	for (auto& refreshed : batch)
+	{
+		const int index{ tracks.getIndexOf(refreshed.trackId) };
+		if (index < 0)
+			continue;
+
+		tracks.setFileStatus(index, refreshed.exists ? TrackStore::present : TrackStore::missing);
+		if (refreshed.metadata.readable && tracks.getLengthInSeconds(index) <= 0.0)
+		{
+			tracks.setAudioDetails(index, refreshed.metadata.lengthInSeconds, refreshed.metadata.sampleRate);
+			session.trackDetailsChanged(refreshed.trackId);
+		}
+	}
+
+	// only rows on screen were asked about, so only they need drawing again
+	tableComponent.repaint();
+}
+
+/* fills in the tempos, beat grids, keys and loudness the analyser measured, for tracks still in the library */
+void PlaylistComponent::tracksAnalysed(const std::vector<TrackAnalyser::AnalysedTrack>& batch)
+{
+	for (auto& analysed : batch)
+	{
+		const int index{ tracks.getIndexOf(analysed.trackId) };
+		if (index < 0)
+			continue;
+
+		tracks.setBeatGrid(index, analysed.analysis.bpm, analysed.analysis.firstBeat);
+		tracks.setKey(index, analysed.analysis.key);
+		tracks.setLoudness(index, analysed.analysis.loudness, analysed.analysis.truePeak);
+		tracks.setAnalysed(index, analysed.analysis.measured);
+		session.trackDetailsChanged(analysed.trackId);
+	}
+
+	// a sorted or filtered view keeps its order until it is next sorted or searched
+	tableComponent.repaint();
+}
+
+/* a deck set or cleared a cue on a library track, it may have been removed from the library since it was loaded */
+void PlaylistComponent::hotCuesChanged(TrackStore::TrackId id, const HotCues& hotCues)
+{
+	const int index{ tracks.getIndexOf(id) };
+	if (index < 0)
+		return;
+
+	tracks.setHotCues(index, hotCues);
+	session.hotCuesChanged(id);
+}
+
+/* queues every track missing one of the analyser's measurements, ones whose files have gone are simply dropped by it */
+void PlaylistComponent::analyseUnmeasuredTracks()
+{
+	for (int i = 0; i < tracks.size(); ++i)
+		if ((tracks.getAnalysed(i) & TrackAnalysis::allMeasured) != TrackAnalysis::allMeasured)
+			analyser.analyse(tracks.getId(i), tracks.getFile(i));
+}
+
+/* puts the toolbar back once the importer has finished or been cancelled */
+void PlaylistComponent::importFinished(bool wasCancelled)
+{
+	DBG("PlaylistComponent::importFinished: " << (wasCancelled ? "cancelled" : "done") << ", " << tracks.size() << " tracks");
+	loadPlaylistButton.setButtonText("Load Playlist");
+	importProgressBar.setVisible(false);
+	resized();
+}
+
+
+/* handles a load or delete button, the view says which track the row is showing */
+void PlaylistComponent::handlePlaylistButtons(int row, int column)
+{
+	const int index{ view.getTrackIndex(row) };
+	if (index < 0)
+		return;
+
+	// load deck, the column says which one
+	if (column >= firstDeckColumn)
+	{
+		auto* deck = deckRegistry.getDeck(column - firstDeckColumn);
+		if (deck == nullptr)
+		{
+			DBG("PlaylistComponent::handlePlaylistButtons: no deck for column " << column);
+		}
+		else
+		{
+			// the deck gets the track's beat grid so it can sync to the others, and its loudness to normalise it
+			TrackAnalysis analysis;
+			analysis.bpm = tracks.getBpm(index);
+			analysis.firstBeat = tracks.getFirstBeat(index);
+			analysis.loudness = tracks.getLoudness(index);
+			analysis.truePeak = tracks.getTruePeak(index);
+			analysis.measured = tracks.getAnalysed(index);
+
+			// and its hot cues, any set or cleared on the deck are written back here
+			const TrackStore::TrackId id{ tracks.getId(index) };
+			Component::SafePointer<PlaylistComponent> safeThis{ this };
+			deck->gui->loadTrack(URL{ tracks.getFile(index) }, tracks.getTitle(index), true, analysis, tracks.getHotCues(index),
+				[safeThis, id](const HotCues& hotCues)
+				{
+					if (safeThis != nullptr)
+						safeThis->hotCuesChanged(id, hotCues);
+				});
+		}
+	}
+
+	// delete button, works on search results too since the view keeps them in step
+	if (column == 6 && libraryLoaded)
+	{
+		removeTrack(index);
+		DBG("PlaylistComponent::buttonClicked: track " << index << " deleted");
+		tableComponent.updateContent();
+		repaint();
+	}
+}
+
+/* parse time from a double into minute string format : "00:00" */
+std::string PlaylistComponent::secondsToMinutes(double seconds)
+{
+	seconds = std::round(seconds);
+
+	std::string minString{ "" };
+	std::string secString{ "" };
+
+	int min{ int(seconds / 60) };
+	int sec{ int(std::fmod(seconds, 60)) };
+
+	// adds an extra 0 infront if digits are less than 10
+	if (min < 10)
+	{
+		minString = "0" + std::to_string(min);
+	}
+	else
+	{
+		minString = std::to_string(min);
+	}
+	if (sec < 10)
+	{
+		secString = "0" + std::to_string(sec);
+	}
+	else
+	{
+		secString = std::to_string(sec);
+	}
+
+	return std::string(minString + ":" + secString);
+}
+
+/* checks playlist if the file, or a copy with the same fingerprint, is already in the playlist */
+bool PlaylistComponent::checkDupeTracks(const Track& track)
+{
+	const uint64 fingerprint{ TrackStore::parseFingerprint(track.fingerprint) };
+	return trackPaths.count(TrackStore::hashPath(track.path)) > 0
+		|| (fingerprint != 0 && trackFingerprints.count(fingerprint) > 0);
+}
+
+/* appends a track to the store and records it for duplicate checks */
+void PlaylistComponent::addTrack(const Track& track)
+{
+	const int index{ tracks.add(track) };
+	trackPaths.insert(tracks.getPathHash(index));
+	if (tracks.getFingerprint(index) != 0)
+		trackFingerprints.insert(tracks.getFingerprint(index));
+	queryEngine.addTrack(track);
+	view.trackAdded();
+	session.trackAdded(track);
+}
+
+/* removes a track and forgets it, so the file can be imported again */
+void PlaylistComponent::removeTrack(int index)
+{
+	session.trackRemoved(tracks.getId(index));
+	trackPaths.erase(tracks.getPathHash(index));
+	trackFingerprints.erase(tracks.getFingerprint(index));
+	queryEngine.removeTrack(index);
+	tracks.remove(index);
+	view.trackRemoved(index);
+}
+
+
+//==============================================================================
+/* writes the library snapshot when exiting program, changes before then are already in the session's journal */
+void PlaylistComponent::saveSession()
+{
+	session.save();
+}
+
+/* reads the binary session on a background thread, rows show as soon as the store is in */
+void PlaylistComponent::loadLastSession()
+{
+	session.loadInBackground();
+}
+
+bool PlaylistComponent::isLibraryLoaded() const
+{
+	return libraryLoaded;
+}
+
+/* the store was filled without addTrack(), the rows can be drawn but searching waits for the index */
+void PlaylistComponent::lastSessionRowsLoaded()
+{
+	view.rebuild();
+	tableComponent.updateContent();
+	DBG("PlaylistComponent::lastSessionRowsLoaded: " << tracks.size() << " tracks");
+
+	if (onRowsLoaded != nullptr)
+		onRowsLoaded();
+}
+
+/* the index is in and the journal replayed, so the duplicate sets catch up and the library can be changed.
+   the old csv playlist is only read if there was no session yet */
+void PlaylistComponent::lastSessionLoaded(bool loaded)
+{
+	trackPaths.clear();
+	trackFingerprints.clear();
+	for (int i = 0; i < tracks.size(); ++i)
+	{
+		trackPaths.insert(tracks.getPathHash(i));
+		if (tracks.getFingerprint(i) != 0)
+			trackFingerprints.insert(tracks.getFingerprint(i));
+	}
+	view.rebuild();
+	tableComponent.updateContent();
+
+	libraryLoaded = true;
+	loadPlaylistButton.setEnabled(true);
+	searchBox.setEnabled(true);
+
+	if (!loaded)
+		importLegacySession(File::getCurrentWorkingDirectory().getChildFile("saved-playlist.csv"));
+
+	if (onLibraryLoaded != nullptr)
+		onLibraryLoaded();
+
+	// tracks imported before they could be analysed, or before a kind of measurement was added
+	analyseUnmeasuredTracks();
+}
+
+/* reads a saved-playlist.csv written by earlier versions, each line a path and its length as m:ss.
+   the files go through the importer like any other, so the rows stream in with lengths read from the files */
+void PlaylistComponent::importLegacySession(const File& csvFile)
+{
+	StringArray lines;
+	csvFile.readLines(lines);
+
+	Array<File> files;
+	for (auto& line : lines)
+	{
+		// the length never has a comma in it but the path can, so split at the last one
+		const String filePath{ line.upToLastOccurrenceOf(",", false, false) };
+		if (filePath.isNotEmpty())
+			files.add(File{ filePath });
+	}
+
+	if (!files.isEmpty())
+		startImport(files);
 }
\ No newline at end of file
@@ -1,82 +1,140 @@
-/*
-  ==============================================================================
-
-	PlaylistComponent.h
-	Created: 07th February 2023 - 01:04 PM
-	Author:  Muhammad Suleman Mirza
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include "DeckGUI.h"
-#include "Track.h"
-#include "Customize.h"
-#include <vector>
-#include <string>
-#include <string.h>
-#include <cmath>
-#include <algorithm>
-#include <fstream>
-
-//==============================================================================
-/* component that displays the track playlist and handles functions related to parsing file data */
-
-class PlaylistComponent : public juce::Component,
-	   					  public juce::TableListBoxModel,
-						  public juce::Button::Listener,
-						  public juce::TextEditor::Listener,
-						  public juce::FileDragAndDropTarget
-{
-public:
-	PlaylistComponent(DeckGUI* _deckGUI1,
-					  DeckGUI* _deckGUI2);
-	~PlaylistComponent() override;
-
-	void paint(juce::Graphics&) override;
-	void resized() override;
-
-	// implement TableListBoxModel
-	int getNumRows() override;
-	void paintRowBackground(juce::Graphics& gfx, int rowNum, int width, int height, bool rowSelected) override;
-	void paintCell(juce::Graphics& gfx, int rowNum, int columnId, int width, int height, bool rowSelected) override;
-	juce::Component* refreshComponentForCell(int rowNum, int columnId, bool isRowSelected, juce::Component* UpdateExistingComponent) override;
-
-	// implement Button::Listener
-	void buttonClicked(juce::Button* button) override;
-
-	// implement FileDragAndDropTarget
-	bool isInterestedInFileDrag(const juce::StringArray& files) override;
-	void filesDropped(const juce::StringArray& files, int x, int y) override;
-
-private:
-	std::vector<Track> tracks{};
-	std::vector<Track> searchHits{};
-	
-	DeckGUI* deckGUI1;
-	DeckGUI* deckGUI2;
-	
-	juce::FileChooser fChooser{ "Select a file..." };
-	juce::TextButton loadPlaylistButton{ "Load Playlist" };
-	juce::TextEditor searchBox;
-	juce::TableListBox tableComponent;
-
-	Customize customize { this };
-
-	// playlist function operations
-	void searchPlaylist(juce::String searchText);
-	int highlightTrack(juce::String searchText);
-	void loadPlaylist();
-	void handlePlaylistButtons(int buttonID);
-	std::string secondsToMinutes(double seconds);
-	juce::String getLengthMinutes(juce::URL audioURL);
-	bool checkDupeTracks(juce::String fileName);
-
-	// save session data when exiting program
-	void saveSession();
-	void loadLastSession();
-	
-	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PlaylistComponent)
-};
+/*
+  ==============================================================================
+
+	PlaylistComponent.h
+	Created: 07th February 2023 - 01:04 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DeckRegistry.h"
+#include "Track.h"
+#include "TrackStore.h"
+#include "LibraryImporter.h"
+#include "LibraryQueryEngine.h"
+#include "LibrarySession.h"
+#include "TrackAnalyser.h"
+#include "PlaylistViewModel.h"
+#include "Customize.h"
+#include <functional>
+#include <vector>
+#include <unordered_set>
+#include <string>
+#include <string.h>
+#include <cmath>
+#include <algorithm>
+
+//==============================================================================
+/* component that displays the track playlist and handles functions related to parsing file data */
+
+class PlaylistComponent : public juce::Component,
+	   					  public juce::TableListBoxModel,
+						  public juce::Button::Listener,
+						  public juce::TextEditor::Listener,
+						  public juce::FileDragAndDropTarget,
+						  public juce::ChangeListener
+{
+public:
+	PlaylistComponent(DeckRegistry& _deckRegistry,
+					  LibraryImporter& _importer,
+					  TrackAnalyser& _analyser,
+					  const juce::File& sessionFile = LibrarySession::getDefaultSessionFile());
+	~PlaylistComponent() override;
+
+	// streams the saved library in, rows show before the library can be searched or edited
+	void loadLastSession();
+	bool isLibraryLoaded() const;
+
+	// called on the message thread when the saved rows are showing, and once the library can be searched and edited
+	std::function<void()> onRowsLoaded;
+	std::function<void()> onLibraryLoaded;
+
+	void paint(juce::Graphics&) override;
+	void resized() override;
+
+	// implement TableListBoxModel
+	int getNumRows() override;
+	void paintRowBackground(juce::Graphics& gfx, int rowNum, int width, int height, bool rowSelected) override;
+	void paintCell(juce::Graphics& gfx, int rowNum, int columnId, int width, int height, bool rowSelected) override;
+	juce::Component* refreshComponentForCell(int rowNum, int columnId, bool isRowSelected, juce::Component* UpdateExistingComponent) override;
+	void sortOrderChanged(int newSortColumnId, bool isForwards) override;
+
+	// implement Button::Listener
+	void buttonClicked(juce::Button* button) override;
+
+	// implement FileDragAndDropTarget
+	bool isInterestedInFileDrag(const juce::StringArray& files) override;
+	void filesDropped(const juce::StringArray& files, int x, int y) override;
+
+	// implement ChangeListener, adds or removes a load column when decks come and go
+	void changeListenerCallback(juce::ChangeBroadcaster* source) override;
+
+private:
+	// load and delete buttons are recycled as the table scrolls, so each refresh tells them their row again
+	class RowButton : public juce::TextButton
+	{
+	public:
+		RowButton(const juce::String& text) : juce::TextButton{ text } {}
+		int row{ 0 };
+		int column{ 0 };
+	};
+
+	TrackStore tracks;
+	PlaylistViewModel view{ tracks };   // table rows to track indices, sorted or filtered
+	LibraryQueryEngine queryEngine{ tracks };
+	LibrarySession session;   // saves the library as it changes
+	bool libraryLoaded{ false };
+
+	// kept in step with tracks by addTrack() and removeTrack(), so duplicate checks and searches never scan the list
+	std::unordered_set<juce::uint64> trackPaths;          // TrackStore::hashPath of each canonical path
+	std::unordered_set<juce::uint64> trackFingerprints;
+	
+	DeckRegistry& deckRegistry;
+	LibraryImporter& importer;
+	TrackAnalyser& analyser;
+
+	// load buttons for deck n live in column firstDeckColumn + n
+	static constexpr int firstDeckColumn{ 10 };
+	
+	juce::FileChooser fChooser{ "Select a file..." };
+	juce::TextButton loadPlaylistButton{ "Load Playlist" };
+	juce::TextButton addDeckButton{ "Add Deck" };
+	juce::TextButton removeDeckButton{ "Remove Deck" };
+	juce::TextEditor searchBox;
+
+	// shown under the toolbar while an import runs
+	double importProgress{ 0.0 };
+	juce::ProgressBar importProgressBar{ importProgress };
+	juce::TableListBox tableComponent;
+
+	Customize customize { this };
+
+	// playlist function operations
+	void searchPlaylist(juce::String searchText);
+	void loadPlaylist();
+	void startImport(const juce::Array<juce::File>& files);
+	void addImportedTracks(const std::vector<TrackMetadata>& batch);
+	void importFinished(bool wasCancelled);
+	void tracksRefreshed(const std::vector<LibraryImporter::RefreshedTrack>& batch);
+	void tracksAnalysed(const std::vector<TrackAnalyser::AnalysedTrack>& batch);
+	void analyseUnmeasuredTracks();
+	void hotCuesChanged(TrackStore::TrackId id, const HotCues& hotCues);
+	void handlePlaylistButtons(int row, int column);
+	void updateDeckColumns();
+	std::string secondsToMinutes(double seconds);
+	bool checkDupeTracks(const Track& track);
+	void addTrack(const Track& track);
+	void removeTrack(int index);
+
+	// save session data when exiting program
+	void saveSession();
+	void lastSessionRowsLoaded();
+	void lastSessionLoaded(bool loaded);
+	void importLegacySession(const juce::File& csvFile);
+	
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PlaylistComponent)
+};
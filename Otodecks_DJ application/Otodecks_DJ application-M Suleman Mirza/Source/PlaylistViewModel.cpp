@@ -0,0 +1,181 @@
+/*
+  ==============================================================================
+
+	PlaylistViewModel.cpp
+	Created: 18th October 2026 - 07:35 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#include "PlaylistViewModel.h"
+#include <algorithm>
+#include <cctype>
+using namespace juce;
+
+//==============================================================================
+/* maps the playlist table's rows onto the track store without copying tracks */
+
+PlaylistViewModel::PlaylistViewModel(const TrackStore& _tracks) :
+	tracks{ _tracks }
+{
+}
+
+/* slots the newest track into the sorted order, the search results are rebuilt by the next search */
+void PlaylistViewModel::trackAdded()
+{
+	const int index{ tracks.size() - 1 };
+	order.insert(std::upper_bound(order.begin(), order.end(), index,
+		[this](int a, int b) { return isBefore(a, b); }), index);
+}
+
+/* forgets a removed track and shifts every later index down to match the store */
+void PlaylistViewModel::trackRemoved(int index)
+{
+	for (auto* indices : { &order, &matches, &sortedMatches })
+	{
+		indices->erase(std::remove(indices->begin(), indices->end(), index), indices->end());
+		for (int& i : *indices)
+			if (i > index)
+				--i;
+	}
+}
+
+void PlaylistViewModel::rebuild()
+{
+	clearFilter();
+	setSortOrder(sortKey, sortForwards);
+}
+
+void PlaylistViewModel::setSortOrder(SortKey newSortKey, bool forwards)
+{
+	sortKey = newSortKey;
+	sortForwards = forwards;
+
+	// playlist order is just the indices counting up, or down
+	order.resize((size_t) tracks.size());
+	for (size_t i = 0; i < order.size(); ++i)
+		order[i] = (int) i;
+	sortIndices(order);
+
+	if (filtered)
+		setFilter(matches);
+}
+
+void PlaylistViewModel::setFilter(const std::vector<int>& trackIndices)
+{
+	matches = trackIndices;
+	filtered = true;
+
+	// ranked results stay ranked until the user picks a column to sort on
+	if (sortKey == playlistOrder)
+	{
+		rows = &matches;
+	}
+	else
+	{
+		sortedMatches = matches;
+		sortIndices(sortedMatches);
+		rows = &sortedMatches;
+	}
+}
+
+void PlaylistViewModel::clearFilter()
+{
+	matches.clear();
+	sortedMatches.clear();
+	filtered = false;
+	rows = &order;
+}
+
+bool PlaylistViewModel::isFiltered() const
+{
+	return filtered;
+}
+
+int PlaylistViewModel::getNumRows() const
+{
+	return (int) rows->size();
+}
+
+int PlaylistViewModel::getTrackIndex(int row) const
+{
+	return isPositiveAndBelow(row, getNumRows()) ? (*rows)[(size_t) row] : -1;
+}
+
+//==============================================================================
+/* the sort comparison, ties fall back to the index so every order is total and repeatable */
+bool PlaylistViewModel::isBefore(int a, int b) const
+{
+	if (!sortForwards)
+		std::swap(a, b);
+
+	int comparison{ 0 };
+
+	switch (sortKey)
+	{
+	case title:
+		comparison = compareNames(tracks.getName(a), tracks.getName(b));
+		break;
+	case length:
+	{
+		const double first{ tracks.getLengthInSeconds(a) };
+		const double second{ tracks.getLengthInSeconds(b) };
+		comparison = first < second ? -1 : (first > second ? 1 : 0);
+		break;
+	}
+	case format:
+		comparison = tracks.getExtension(a).compareIgnoreCase(tracks.getExtension(b));
+		break;
+	case tempo:
+	{
+		const double first{ tracks.getBpm(a) };
+		const double second{ tracks.getBpm(b) };
+		comparison = first < second ? -1 : (first > second ? 1 : 0);
+		break;
+	}
+	case key:
+		comparison = compareKeys(tracks.getKey(a), tracks.getKey(b));
+		break;
+	case playlistOrder:
+	default:
+		break;
+	}
+
+	return comparison != 0 ? comparison < 0 : a < b;
+}
+
+/* titles compared straight from the store's UTF-8 bytes, no strings are built while sorting.
+   only ASCII letters are case folded, which is all the ordering needs to look right */
+int PlaylistViewModel::compareNames(std::string_view first, std::string_view second)
+{
+	// leading spaces are trimmed from titles, so they do not count here either
+	auto trimStart = [](std::string_view text) { return text.substr(jmin(text.size(), text.find_first_not_of(' '))); };
+	first = trimStart(first);
+	second = trimStart(second);
+
+	const size_t length{ jmin(first.size(), second.size()) };
+	for (size_t i = 0; i < length; ++i)
+	{
+		const int a{ std::tolower((unsigned char) first[i]) };
+		const int b{ std::tolower((unsigned char) second[i]) };
+		if (a != b)
+			return a < b ? -1 : 1;
+	}
+	return first.size() < second.size() ? -1 : (first.size() > second.size() ? 1 : 0);
+}
+
+/* camelot keys go round the wheel, 1A, 1B, 2A and so on, tracks with no key yet first */
+int PlaylistViewModel::compareKeys(const String& first, const String& second)
+{
+	const int a{ first.getIntValue() };
+	const int b{ second.getIntValue() };
+	if (a != b)
+		return a < b ? -1 : 1;
+	return first.compareIgnoreCase(second);
+}
+
+void PlaylistViewModel::sortIndices(std::vector<int>& indices) const
+{
+	std::sort(indices.begin(), indices.end(), [this](int a, int b) { return isBefore(a, b); });
+}
@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+	PlaylistViewModel.h
+	Created: 18th October 2026 - 07:20 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "TrackStore.h"
+#include <vector>
+
+//==============================================================================
+/* maps the playlist table's rows onto the track store without copying anything out of it.
+   the rows are a span of indices, either every track in sort order or the current search results,
+   so painting a cell is one lookup and sorting only moves ints around */
+
+class PlaylistViewModel
+{
+public:
+	enum SortKey
+	{
+		playlistOrder = 0,
+		title,
+		length,
+		format,
+		tempo,
+		key
+	};
+
+	PlaylistViewModel(const TrackStore& _tracks);
+
+	// called after the store changes, the last track is the one just added
+	void trackAdded();
+	void trackRemoved(int index);
+	void rebuild();   // after the whole store was loaded at once
+
+	// sorts every track and the search results, playlistOrder puts results back in ranked order
+	void setSortOrder(SortKey newSortKey, bool forwards);
+
+	// shows only these tracks, best match first unless a column is sorted
+	void setFilter(const std::vector<int>& trackIndices);
+	void clearFilter();
+	bool isFiltered() const;
+
+	int getNumRows() const;
+	int getTrackIndex(int row) const;   // -1 for a row that no longer exists
+
+private:
+	bool isBefore(int a, int b) const;
+	static int compareNames(std::string_view first, std::string_view second);
+	static int compareKeys(const juce::String& first, const juce::String& second);
+	void sortIndices(std::vector<int>& indices) const;
+
+	const TrackStore& tracks;
+	std::vector<int> order;     // every track, sorted
+	std::vector<int> matches;   // search results in their ranked order
+	std::vector<int> sortedMatches;
+	const std::vector<int>* rows{ &order };
+
+	SortKey sortKey{ playlistOrder };
+	bool sortForwards{ true };
+	bool filtered{ false };
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PlaylistViewModel)
+};
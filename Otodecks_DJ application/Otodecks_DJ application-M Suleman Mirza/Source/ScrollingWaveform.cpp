@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+	ScrollingWaveform.cpp
+	Created: 19th October 2026 - 01:35 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#include "ScrollingWaveform.h"
+using namespace juce;
+
+//==============================================================================
+/* a zoomed in waveform that scrolls past a playhead fixed in the middle */
+
+ScrollingWaveform::ScrollingWaveform(std::function<double()> _getPosition) :
+	getPosition{ std::move(_getPosition) }
+{
+	// the strip covers every pixel, nothing behind needs drawing each frame
+	setOpaque(true);
+}
+
+ScrollingWaveform::~ScrollingWaveform()
+{
+}
+
+/* one image copy and the playhead, the strip was drawn beforehand */
+void ScrollingWaveform::paint(Graphics& gfx)
+{
+	if (!stripValid)
+	{
+		gfx.fillAll(Colours::black);
+		return;
+	}
+
+	gfx.drawImageAt(strip, -scrollOffset, 0);
+
+	gfx.setColour(Colours::darkorange);
+	gfx.fillRect(getWidth() / 2 - 1, 0, 2, getHeight());
+}
+
+void ScrollingWaveform::resized()
+{
+	stripValid = false;
+	updateFrame();
+}
+
+void ScrollingWaveform::mouseWheelMove(const MouseEvent& event, const MouseWheelDetails& wheel)
+{
+	setVisibleSeconds(visibleSeconds * (wheel.deltaY > 0 ? 0.8 : 1.25));
+}
+
+void ScrollingWaveform::setWaveform(WaveformPyramid::Ptr newWaveform)
+{
+	waveform = newWaveform;
+	stripValid = false;
+	updateFrame();
+}
+
+void ScrollingWaveform::setVisibleSeconds(double seconds)
+{
+	seconds = jlimit(minVisibleSeconds, maxVisibleSeconds, seconds);
+	if (seconds == visibleSeconds)
+		return;
+
+	visibleSeconds = seconds;
+	stripValid = false;
+	updateFrame();
+}
+
+double ScrollingWaveform::getVisibleSeconds() const
+{
+	return visibleSeconds;
+}
+
+double ScrollingWaveform::getSamplesPerPixel() const
+{
+	return waveform != nullptr && getWidth() > 0 ? visibleSeconds * waveform->sampleRate / getWidth() : 0.0;
+}
+
+//==============================================================================
+/* called on every vertical blank, repaints only if the playhead moved a whole pixel since the last frame */
+void ScrollingWaveform::updateFrame()
+{
+	if (waveform == nullptr || getWidth() <= 0 || getHeight() <= 0)
+	{
+		if (stripValid)
+		{
+			strip = {};
+			stripValid = false;
+			repaint();
+		}
+		return;
+	}
+
+	const double samplesPerPixel{ getSamplesPerPixel() };
+	const int64 playhead{ (int64) (getPosition() * waveform->sampleRate) };
+
+	// the strip is redrawn around the playhead once the view would run off either end of it
+	int offset{ (int) ((playhead - stripStartSample) / samplesPerPixel) - getWidth() / 2 };
+	if (!stripValid || offset < 0 || offset + getWidth() > strip.getWidth())
+	{
+		renderStrip(playhead);
+		offset = (int) ((playhead - stripStartSample) / samplesPerPixel) - getWidth() / 2;
+		scrollOffset = offset;
+		repaint();
+		return;
+	}
+
+	if (offset != scrollOffset)
+	{
+		scrollOffset = offset;
+		repaint();
+	}
+}
+
+/* draws three widths of waveform with the playhead in the middle, the part before or after the track left blank */
+void ScrollingWaveform::renderStrip(int64 centreSample)
+{
+	const int width{ getWidth() * 3 };
+	const double samplesPerPixel{ getSamplesPerPixel() };
+	stripStartSample = centreSample - (int64) (samplesPerPixel * width / 2);
+
+	strip = Image{ Image::RGB, width, getHeight(), false };
+	Graphics gfx{ strip };
+	gfx.fillAll(Colours::black);
+	waveform->draw(gfx, strip.getBounds(), stripStartSample, stripStartSample + (int64) (samplesPerPixel * width),
+				   Colours::blue, Colours::lightblue);
+	stripValid = true;
+}
@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+	ScrollingWaveform.h
+	Created: 19th October 2026 - 01:10 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "WaveformCache.h"
+#include <functional>
+
+//==============================================================================
+/* a zoomed in waveform that scrolls past a playhead fixed in the middle, moved on every vertical blank.
+   the waveform is drawn into a strip three views wide, and each frame only copies the visible part of
+   it, so scrolling costs one image copy. the strip is drawn again when the playhead gets near one of
+   its ends or the zoom changes, and nothing is painted at all while the position stands still */
+
+class ScrollingWaveform : public juce::Component
+{
+public:
+	// getPosition returns the playhead in seconds, it is asked once per frame
+	ScrollingWaveform(std::function<double()> _getPosition);
+	~ScrollingWaveform() override;
+
+	void paint(juce::Graphics&) override;
+	void resized() override;
+
+	// the mouse wheel zooms in and out
+	void mouseWheelMove(const juce::MouseEvent& event, const juce::MouseWheelDetails& wheel) override;
+
+	void setWaveform(WaveformPyramid::Ptr newWaveform);
+
+	// how much of the track is visible across the whole width
+	void setVisibleSeconds(double seconds);
+	double getVisibleSeconds() const;
+
+	static constexpr double minVisibleSeconds{ 2.0 };
+	static constexpr double maxVisibleSeconds{ 60.0 };
+
+private:
+	void updateFrame();
+	void renderStrip(juce::int64 centreSample);
+	double getSamplesPerPixel() const;
+
+	std::function<double()> getPosition;
+	WaveformPyramid::Ptr waveform;
+	double visibleSeconds{ 8.0 };
+
+	juce::Image strip;                  // three widths of waveform, the middle one centred where it was drawn
+	juce::int64 stripStartSample{ 0 };
+	int scrollOffset{ 0 };              // the strip's x at the left edge of the view
+	bool stripValid{ false };
+
+	juce::VBlankAttachment vBlank{ this, [this] { updateFrame(); } };
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ScrollingWaveform)
+};
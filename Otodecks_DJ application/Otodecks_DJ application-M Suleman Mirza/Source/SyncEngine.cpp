@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+	SyncEngine.cpp
+	Created: 19th October 2026 - 05:20 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#include "SyncEngine.h"
+using namespace juce;
+
+//==============================================================================
+/* the master tempo clock that synced decks lock to */
+
+SyncEngine::SyncEngine()
+{
+}
+
+SyncEngine::~SyncEngine()
+{
+}
+
+/* the master's published beat is exact for this block's start, without one the clock runs on at its tempo */
+void SyncEngine::beginBlock(int numSamples)
+{
+	const int64 start{ blockStart.load() + blockLength.load() };
+	double beat{ clockBeat.load() + clockTempo.load() * blockLength.load() };
+	double tempo{ clockTempo.load() };
+
+	if (publishedTime.load() == start)
+	{
+		beat = publishedBeat.load();
+		tempo = publishedTempo.load();
+	}
+
+	clockBeat.store(beat);
+	clockTempo.store(tempo);
+	blockStart.store(start);
+	blockLength.store(numSamples);
+}
+
+double SyncEngine::getBeat() const
+{
+	return clockBeat.load();
+}
+
+/* beats per device sample */
+double SyncEngine::getBeatsPerSample() const
+{
+	return clockTempo.load();
+}
+
+/* stamped with the end of the current block, which is where the next beginBlock starts */
+void SyncEngine::publishMasterBeat(double beat, double beatsPerSample)
+{
+	publishedBeat.store(beat);
+	publishedTempo.store(beatsPerSample);
+	publishedTime.store(blockStart.load() + blockLength.load());
+}
+
+void SyncEngine::setMaster(const void* deck)
+{
+	masterDeck.store(deck);
+	DBG("SyncEngine::setMaster: " << (deck != nullptr ? "new master deck" : "no master"));
+}
+
+const void* SyncEngine::getMaster() const
+{
+	return masterDeck.load();
+}
@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+	SyncEngine.h
+	Created: 19th October 2026 - 05:20 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+
+//==============================================================================
+/* the master tempo clock that synced decks lock to.
+
+   the clock counts beats of the master deck's grid in device samples. it is moved on once per audio
+   callback before any deck renders, to exactly where the master deck said its beat would be at the end of
+   the block it rendered last. while the master is stopped, or there is none, it carries on at the last tempo.
+   followers read it at the start of each block and pick their speed for that block from it, so nothing
+   is left to the GUI timer and a follower can never drift further than one block's correction */
+
+class SyncEngine
+{
+public:
+	enum Mode
+	{
+		off = 0,
+		follower,
+		master
+	};
+
+	SyncEngine();
+	~SyncEngine();
+
+	// audio thread, before any deck renders the block
+	void beginBlock(int numSamples);
+
+	// the clock at the start of the block being rendered, the tempo is zero until a master has played
+	double getBeat() const;
+	double getBeatsPerSample() const;
+
+	// audio thread, the master deck's beat at the end of the block it has just rendered
+	void publishMasterBeat(double beat, double beatsPerSample);
+
+	// any deck can be master, setting a new one turns the last one into a follower. decks are only compared
+	void setMaster(const void* deck);
+	const void* getMaster() const;
+
+private:
+	std::atomic<const void*> masterDeck{ nullptr };
+
+	// written in beginBlock only
+	std::atomic<juce::int64> blockStart{ 0 };
+	std::atomic<int> blockLength{ 0 };
+	std::atomic<double> clockBeat{ 0.0 };
+	std::atomic<double> clockTempo{ 0.0 };
+
+	// written by the master deck, the time is the device sample its beat is for
+	std::atomic<juce::int64> publishedTime{ -1 };
+	std::atomic<double> publishedBeat{ 0.0 };
+	std::atomic<double> publishedTempo{ 0.0 };
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SyncEngine)
+};
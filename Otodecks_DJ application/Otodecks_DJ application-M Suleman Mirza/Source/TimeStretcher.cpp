@@ -0,0 +1,325 @@
+/*
+  ==============================================================================
+
+	TimeStretcher.cpp
+	Created: 17th October 2026 - 06:40 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#include "TimeStretcher.h"
+#include <cstring>
+using namespace juce;
+
+//==============================================================================
+/* key lock, changes the tempo of its input without changing pitch using WSOLA (waveform similarity overlap-add).
+   each output frame is cut from the input near where the tempo says it should be, at the offset that best
+   lines up with the end of the previous frame, then cross-faded in */
+
+TimeStretcher::TimeStretcher(AudioSource* _input) :
+	input{ _input }
+{
+}
+
+TimeStretcher::~TimeStretcher()
+{
+}
+
+/* frame length, search range and search resolution for each quality setting */
+TimeStretcher::Settings TimeStretcher::getSettings(int quality)
+{
+	if (quality == fast)
+		return { 1024, 96, 256, 4 };
+	if (quality == high)
+		return { 4096, 512, 1024, 1 };
+	return { 2048, 256, 512, 2 };
+}
+
+String TimeStretcher::getQualityName(int quality)
+{
+	if (quality == fast)
+		return "Fast";
+	if (quality == high)
+		return "High";
+	return "Normal";
+}
+
+void TimeStretcher::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+	input->prepareToPlay(samplesPerBlockExpected, sampleRate);
+
+	// big enough for a frame at the fastest tempo plus the search range either side
+	const int capacity{ maxFrameSize * 8 };
+	inputBuffer.setSize(2, capacity);
+	monoBuffer.setSize(1, capacity);
+	overlapBuffer.setSize(2, maxFrameSize);
+	outputBuffer.setSize(2, maxFrameSize / 2);
+	window.setSize(1, maxFrameSize);
+
+	reset(quality.load());
+}
+
+void TimeStretcher::releaseResources()
+{
+	input->releaseResources();
+}
+
+/* passes the input straight through when disabled, otherwise plays out stretched frames */
+void TimeStretcher::getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill)
+{
+	const bool shouldBeActive{ enabled.load() };
+	if (shouldBeActive != active || (shouldBeActive && quality.load() != activeQuality))
+	{
+		active = shouldBeActive;
+		reset(quality.load());
+	}
+
+	if (!active)
+	{
+		input->getNextAudioBlock(bufferToFill);
+		return;
+	}
+
+	const int numChannels{ jmin(bufferToFill.buffer->getNumChannels(), 2) };
+	for (int ch = numChannels; ch < bufferToFill.buffer->getNumChannels(); ++ch)
+		bufferToFill.buffer->clear(ch, bufferToFill.startSample, bufferToFill.numSamples);
+
+	int written{ 0 };
+	while (written < bufferToFill.numSamples)
+	{
+		if (outputRead >= outputAvailable)
+			processFrame();
+
+		const int numSamples{ jmin(outputAvailable - outputRead, bufferToFill.numSamples - written) };
+		for (int ch = 0; ch < numChannels; ++ch)
+			bufferToFill.buffer->copyFrom(ch, bufferToFill.startSample + written, outputBuffer, ch, outputRead, numSamples);
+
+		outputRead += numSamples;
+		written += numSamples;
+	}
+}
+
+//==============================================================================
+void TimeStretcher::setEnabled(bool shouldBeEnabled)
+{
+	enabled.store(shouldBeEnabled);
+}
+
+bool TimeStretcher::isEnabled() const
+{
+	return enabled.load();
+}
+
+/* tempo as a ratio, 1 plays at the original speed */
+void TimeStretcher::setTempo(double newTempo)
+{
+	tempo.store(jlimit(1.0 / maxTempo, maxTempo, newTempo));
+}
+
+void TimeStretcher::setQuality(int newQuality)
+{
+	quality.store(jlimit(0, numQualities - 1, newQuality));
+}
+
+int TimeStretcher::getQuality() const
+{
+	return quality.load();
+}
+
+/* output samples not played yet stand for tempo times as much input, the rest is input beyond the next frame's start */
+double TimeStretcher::getBufferedInput(double outputAhead) const
+{
+	if (!active)
+		return outputAhead;
+
+	const double playedTo{ analysisPosition - (outputAvailable - outputRead + outputAhead) * frameTempo };
+	return (inputOrigin + inputFill) - playedTo;
+}
+
+/* nothing is buffered while passing straight through. otherwise stretching starts again from the next input,
+   without the fade in so a hot cue's first sample is heard at full level */
+void TimeStretcher::flush()
+{
+	if (!active)
+		return;
+
+	reset(activeQuality);
+	flushed = true;
+}
+
+//==============================================================================
+/* starts stretching from scratch, the first frame fades in under the window */
+void TimeStretcher::reset(int newQuality)
+{
+	activeQuality = newQuality;
+	settings = getSettings(newQuality);
+
+	// periodic hann, two of them overlapped by half sum to exactly one
+	float* w = window.getWritePointer(0);
+	for (int i = 0; i < settings.frameSize; ++i)
+		w[i] = 0.5f - 0.5f * std::cos(MathConstants<float>::twoPi * (float) i / (float) settings.frameSize);
+
+	overlapBuffer.clear();
+	inputOrigin = 0;
+	inputFill = 0;
+	analysisPosition = 0.0;
+	naturalPosition = 0;
+	primed = false;
+	flushed = false;
+	outputAvailable = 0;
+	outputRead = 0;
+}
+
+/* cuts the next frame out of the input, overlap-adds it and makes one hop of output available */
+void TimeStretcher::processFrame()
+{
+	const int frameSize{ settings.frameSize };
+	const int hopSize{ frameSize / 2 };
+	const int64 nominal{ (int64) std::floor(analysisPosition + 0.5) };
+
+	fillInput(jmin(naturalPosition, nominal - settings.searchRange),
+		jmax(nominal + settings.searchRange + frameSize, naturalPosition + settings.correlationLength));
+
+	// the very first frame has nothing to line up with
+	const int start{ primed ? findBestCandidate(nominal) : (int) (nominal - inputOrigin) };
+	const bool unfaded{ !primed && flushed };
+	primed = true;
+	flushed = false;
+
+	const float* w = window.getReadPointer(0);
+	for (int ch = 0; ch < 2; ++ch)
+	{
+		const float* in = inputBuffer.getReadPointer(ch, start);
+		float* ola = overlapBuffer.getWritePointer(ch);
+		for (int i = 0; i < frameSize; ++i)
+			ola[i] += in[i] * w[i];
+
+		// after a flush the first half also gets the rest of the window, as if a frame had come before it
+		if (unfaded)
+			for (int i = 0; i < hopSize; ++i)
+				ola[i] += in[i] * (1.0f - w[i]);
+
+		// the first half is finished, the second half waits for the next frame to be added on top
+		outputBuffer.copyFrom(ch, 0, overlapBuffer, ch, 0, hopSize);
+		std::memmove(ola, ola + hopSize, sizeof(float) * (size_t) hopSize);
+		FloatVectorOperations::clear(ola + hopSize, hopSize);
+	}
+
+	outputAvailable = hopSize;
+	outputRead = 0;
+
+	naturalPosition = inputOrigin + start + hopSize;
+	frameTempo = tempo.load();
+	analysisPosition += hopSize * frameTempo;
+}
+
+/* drops input before keepFrom and reads until the buffer reaches needUpTo, both absolute input positions */
+void TimeStretcher::fillInput(int64 keepFrom, int64 needUpTo)
+{
+	const int capacity{ inputBuffer.getNumSamples() };
+	keepFrom = jmax(keepFrom, inputOrigin);
+
+	int64 toDrop{ keepFrom - inputOrigin };
+	if (toDrop >= inputFill)
+	{
+		// fast tempos can skip past everything buffered, the skipped input still has to be pulled through
+		int64 toSkip{ toDrop - inputFill };
+		while (toSkip > 0)
+		{
+			const int numSamples{ (int) jmin((int64) capacity, toSkip) };
+			readInput(0, numSamples);
+			toSkip -= numSamples;
+		}
+		inputFill = 0;
+	}
+	else if (toDrop > 0)
+	{
+		const int remaining{ inputFill - (int) toDrop };
+		for (int ch = 0; ch < 2; ++ch)
+		{
+			float* data = inputBuffer.getWritePointer(ch);
+			std::memmove(data, data + toDrop, sizeof(float) * (size_t) remaining);
+		}
+		float* mono = monoBuffer.getWritePointer(0);
+		std::memmove(mono, mono + toDrop, sizeof(float) * (size_t) remaining);
+		inputFill = remaining;
+	}
+	inputOrigin = keepFrom;
+
+	const int needed{ (int) jmin((int64) capacity, needUpTo - inputOrigin) };
+	if (needed > inputFill)
+	{
+		readInput(inputFill, needed - inputFill);
+		inputFill = needed;
+	}
+}
+
+/* pulls input into inputBuffer and keeps the mono mixdown in step */
+void TimeStretcher::readInput(int startIndex, int numSamples)
+{
+	AudioSourceChannelInfo info{ &inputBuffer, startIndex, numSamples };
+	input->getNextAudioBlock(info);
+
+	float* mono = monoBuffer.getWritePointer(0, startIndex);
+	FloatVectorOperations::copy(mono, inputBuffer.getReadPointer(0, startIndex), numSamples);
+	FloatVectorOperations::add(mono, inputBuffer.getReadPointer(1, startIndex), numSamples);
+}
+
+/* returns the buffer index of the candidate frame around nominal that best continues the previous frame */
+int TimeStretcher::findBestCandidate(int64 nominal) const
+{
+	const int templateStart{ (int) (naturalPosition - inputOrigin) };
+	const int lastStart{ inputFill - settings.frameSize };
+	const int first{ jlimit(0, lastStart, (int) (nominal - settings.searchRange - inputOrigin)) };
+	const int last{ jlimit(0, lastStart, (int) (nominal + settings.searchRange - inputOrigin)) };
+	const int stride{ settings.stride };
+
+	// coarse pass over every stride-th offset, comparing every stride-th sample. ties, as in silence, stay
+	// at the nominal position so the output never settles somewhere behind or ahead of where the tempo puts it
+	int best{ jlimit(first, last, (int) (nominal - inputOrigin)) };
+	float bestScore{ getSimilarity(best, templateStart, stride) };
+	for (int candidate = first; candidate <= last; candidate += stride)
+	{
+		const float score{ getSimilarity(candidate, templateStart, stride) };
+		if (score > bestScore)
+		{
+			bestScore = score;
+			best = candidate;
+		}
+	}
+
+	// then refine around the winner at full resolution
+	if (stride > 1)
+	{
+		const int coarseBest{ best };
+		bestScore = getSimilarity(coarseBest, templateStart, 1);
+		for (int candidate = jmax(first, coarseBest - stride + 1); candidate <= jmin(last, coarseBest + stride - 1); ++candidate)
+		{
+			const float score{ getSimilarity(candidate, templateStart, 1) };
+			if (score > bestScore)
+			{
+				bestScore = score;
+				best = candidate;
+			}
+		}
+	}
+	return best;
+}
+
+/* cross-correlation normalised by the candidate's energy, so loud passages are not favoured */
+float TimeStretcher::getSimilarity(int candidate, int templateStart, int step) const
+{
+	const float* mono = monoBuffer.getReadPointer(0);
+	const float* a = mono + templateStart;
+	const float* b = mono + candidate;
+
+	float correlation{ 0.0f };
+	float energy{ 0.0f };
+	for (int i = 0; i < settings.correlationLength; i += step)
+	{
+		correlation += a[i] * b[i];
+		energy += b[i] * b[i];
+	}
+	return correlation / std::sqrt(energy + 1.0e-9f);
+}
@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+	TimeStretcher.h
+	Created: 17th October 2026 - 06:10 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+
+//==============================================================================
+/* key lock, changes the tempo of its input without changing pitch using WSOLA (waveform similarity overlap-add).
+   each output frame is cut from the input near where the tempo says it should be, at the offset that best
+   lines up with the end of the previous frame, then cross-faded in */
+
+class TimeStretcher : public juce::AudioSource
+{
+public:
+	// higher quality searches a wider range with longer frames, costing more CPU
+	enum Quality
+	{
+		fast = 0,
+		normal,
+		high,
+		numQualities
+	};
+
+	TimeStretcher(juce::AudioSource* _input);
+	~TimeStretcher() override;
+
+	void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+	void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+	void releaseResources() override;
+
+	// safe to call from any thread, picked up by the audio thread at the next frame
+	void setEnabled(bool shouldBeEnabled);
+	bool isEnabled() const;
+	void setTempo(double newTempo);   // limited to between a quarter and four times the original speed
+	void setQuality(int newQuality);
+	int getQuality() const;
+
+	// audio thread only, input samples read but not heard yet, counting outputAhead samples of this
+	// stretcher's output that are still buffered further down the chain
+	double getBufferedInput(double outputAhead) const;
+
+	// audio thread only, drops everything read ahead so the next input sample is the next one stretched, for jumps
+	void flush();
+
+	static juce::String getQualityName(int quality);
+
+private:
+	struct Settings
+	{
+		int frameSize;   // output hop is half of this
+		int searchRange;   // candidate offsets either side of the nominal position
+		int correlationLength;   // samples compared per candidate
+		int stride;   // coarse search step, refined at full resolution afterwards
+	};
+
+	static Settings getSettings(int quality);
+	static constexpr int maxFrameSize{ 4096 };
+	static constexpr double maxTempo{ 4.0 };
+
+	void reset(int newQuality);
+	void processFrame();
+	void fillInput(juce::int64 keepFrom, juce::int64 needUpTo);
+	void readInput(int startIndex, int numSamples);
+	int findBestCandidate(juce::int64 nominal) const;
+	float getSimilarity(int candidate, int templateStart, int step) const;
+
+	juce::AudioSource* input;
+
+	// written by the GUI, read by the audio thread
+	std::atomic<bool> enabled{ false };
+	std::atomic<double> tempo{ 1.0 };
+	std::atomic<int> quality{ normal };
+
+	// audio thread only
+	bool active{ false };
+	int activeQuality{ -1 };
+	Settings settings{ getSettings(normal) };
+	juce::AudioBuffer<float> inputBuffer;   // input from inputOrigin onwards
+	juce::AudioBuffer<float> monoBuffer;   // mixdown of inputBuffer used for the similarity search
+	juce::AudioBuffer<float> overlapBuffer;
+	juce::AudioBuffer<float> outputBuffer;
+	juce::AudioBuffer<float> window;
+	juce::int64 inputOrigin{ 0 };
+	int inputFill{ 0 };
+	double analysisPosition{ 0.0 };   // where the next frame nominally starts in the input
+	double frameTempo{ 1.0 };   // the tempo the latest frame was cut at
+	juce::int64 naturalPosition{ 0 };   // where the previous frame would have continued
+	bool primed{ false };
+	bool flushed{ false };   // the next first frame starts at full level instead of fading in
+	int outputAvailable{ 0 };
+	int outputRead{ 0 };
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TimeStretcher)
+};
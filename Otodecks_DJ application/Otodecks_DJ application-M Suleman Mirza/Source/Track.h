@@ -1,28 +1,54 @@
-/*
-  ==============================================================================
-
-	Track.h
-	Created: 18th February 2023 - 12:25 AM
-	Author:  Muhammad Suleman Mirza
-
-  ==============================================================================
-*/
-
-#pragma once
-#include <JuceHeader.h>
-
-/* class to handle the track object */
-
-class Track
-{
-public:
-	Track(juce::File _file);
-	juce::File file;
-	juce::URL URL;
-	juce::String title;
-	juce::String length;
-	juce::String fileExtension;
-
-	// enable comparison search operations
-	bool operator==(const juce::String& other) const;
+/*
+  ==============================================================================
+
+	Track.h
+	Created: 18th February 2023 - 12:25 AM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+
+/* a track as it is imported, the playlist keeps its tracks column by column in a TrackStore */
+
+class Track
+{
+public:
+	Track(juce::File _file);
+	juce::File file;
+	juce::String title;
+	juce::String fileExtension;
+	juce::String path;          // canonical, the key for duplicate checks
+	juce::String fingerprint;   // content fingerprint, empty unless the import computed one
+	juce::String tags;          // tag values from the file, searched alongside the title
+	double lengthInSeconds{ 0.0 };
+	double sampleRate{ 0.0 };
+	double bpm{ 0.0 };          // zero until the track has been analysed
+	double firstBeat{ 0.0 };    // seconds, the beat grid runs every 60 / bpm seconds from here
+	juce::String key;
+	double loudness{ 0.0 };     // integrated LUFS and true peak dBTP, only meaningful once measured
+	double truePeak{ 0.0 };
+	juce::uint8 analysed{ 0 };  // which TrackAnalysis measurements have been taken
+
+	// same file however it was reached, symlinks resolved and case folded where the file system ignores case
+	static juce::String getCanonicalPath(const juce::File& file);
+
+	// enable comparison search operations
+	bool operator==(const juce::String& other) const;
+};
+
+/* a track's hot cues, kept in the library and handed to the deck with the track */
+
+struct HotCues
+{
+	static constexpr int numSlots{ 8 };
+	static constexpr juce::int64 empty{ -1 };
+
+	// sample positions at the file's own rate, so a jump lands on the same sample whatever rate the device runs at
+	std::array<juce::int64, numSlots> positions{ empty, empty, empty, empty, empty, empty, empty, empty };
+
+	bool isEmpty() const;
 };
\ No newline at end of file
@@ -0,0 +1,883 @@
+/*
+  ==============================================================================
+
+	TrackAnalyser.cpp
+	Created: 19th October 2026 - 03:40 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#include "TrackAnalyser.h"
+#include "TrackMetadataIndex.h"
+#include <algorithm>
+#include <cmath>
+using namespace juce;
+
+namespace
+{
+	using Lanes = dsp::SIMDRegister<float>;
+	constexpr int numLanes{ (int) Lanes::SIMDNumElements };
+
+	// magnitudes are log compressed as log(1 + compression * magnitude)
+	const float compression{ 100.0f };
+
+	// the autocorrelation at the beat has to reach this fraction of its value at zero lag to count as a beat
+	const float minBeatStrength{ 0.1f };
+
+	// tempos are weighted by a bell this many octaves wide around 120 BPM
+	const double tempoPriorWidth{ 0.9 };
+
+	// the autocorrelation covers at most the first 2^18 onset frames, about fifty minutes
+	const int maxCorrelationFrames{ 1 << 18 };
+
+	// how much each degree of the scale is heard in major and minor music, from the tonic up (krumhansl and kessler)
+	const float majorProfile[12]{ 6.35f, 2.23f, 3.48f, 2.33f, 4.38f, 4.09f, 2.52f, 5.19f, 2.39f, 3.66f, 2.29f, 2.88f };
+	const float minorProfile[12]{ 6.33f, 2.68f, 3.52f, 5.38f, 2.60f, 3.53f, 2.54f, 4.75f, 3.98f, 2.69f, 3.34f, 3.17f };
+
+	// the best key has to correlate at least this well with a track's chroma, drums and noise fit every key about as badly
+	const float minKeyCorrelation{ 0.5f };
+
+	// bumped whenever a detector changes, so every track is measured again
+	const int analysisMagic{ (int) ByteOrder::littleEndianInt("OTAN") };
+	const int analysisVersion{ 2 };
+
+	/* adds up num values a register at a time, the vectors are copied through an aligned buffer like the query engine's columns */
+	float sumOf(const float* values, int num)
+	{
+		alignas(Lanes::SIMDRegisterSize) float aligned[numLanes];
+		Lanes total{ Lanes::expand(0.0f) };
+
+		int i{ 0 };
+		for (; i + numLanes <= num; i += numLanes)
+		{
+			std::copy(values + i, values + i + numLanes, aligned);
+			total += Lanes::fromRawArray(aligned);
+		}
+
+		float sum{ total.sum() };
+		for (; i < num; ++i)
+			sum += values[i];
+		return sum;
+	}
+}
+
+//==============================================================================
+/* finds a track's tempo and where its beats fall, fed the decoded audio a block at a time */
+
+TempoDetector::TempoDetector(double _sampleRate) :
+	sampleRate{ _sampleRate },
+	decimation{ jmax(1, (int) (_sampleRate / 20000.0)) }
+{
+	frameRate = sampleRate / decimation / hopSize;
+	numBassBins = jmax(1, roundToInt(150.0 * fftSize * decimation / sampleRate));
+
+	window.resize((size_t) fftSize);
+	dsp::WindowingFunction<float>::fillWindowingTables(window.data(), (size_t) fftSize, dsp::WindowingFunction<float>::hann, false);
+
+	frame.resize((size_t) fftSize * 2);
+	magnitudes.resize((size_t) numBins);
+	previousMagnitudes.resize((size_t) numBins);
+	samples.resize((size_t) fftSize);
+}
+
+/* mixes the block to mono, averages it down and takes a frame every hop */
+void TempoDetector::addBlock(const AudioBuffer<float>& block, int startSample, int num)
+{
+	const int numChannels{ block.getNumChannels() };
+	if (numChannels == 0 || num <= 0)
+		return;
+
+	const float gain{ 1.0f / numChannels };
+	mono.resize((size_t) num);
+	FloatVectorOperations::copyWithMultiply(mono.data(), block.getReadPointer(0, startSample), gain, num);
+	for (int ch = 1; ch < numChannels; ++ch)
+		FloatVectorOperations::addWithMultiply(mono.data(), block.getReadPointer(ch, startSample), gain, num);
+
+	for (int i = 0; i < num; ++i)
+	{
+		decimationSum += mono[(size_t) i];
+		if (++decimationCount < decimation)
+			continue;
+
+		samples[(size_t) numSamples++] = decimationSum / decimation;
+		decimationSum = 0.0f;
+		decimationCount = 0;
+
+		if (numSamples == fftSize)
+		{
+			addFrame();
+
+			// frames overlap by half, the second half becomes the next frame's first
+			std::copy(samples.begin() + hopSize, samples.end(), samples.begin());
+			numSamples = fftSize - hopSize;
+		}
+	}
+}
+
+/* the spectral flux of one frame, summed over the bins that got louder since the last */
+void TempoDetector::addFrame()
+{
+	FloatVectorOperations::multiply(frame.data(), samples.data(), window.data(), fftSize);
+	FloatVectorOperations::clear(frame.data() + fftSize, fftSize);
+	fft.performFrequencyOnlyForwardTransform(frame.data(), true);
+
+	// log compressed, so a quiet hi-hat still counts for something next to a loud bass line
+	for (int bin = 0; bin < numBins; ++bin)
+		magnitudes[(size_t) bin] = std::log1p(compression * frame[(size_t) bin]);
+
+	// max(now, before) - before is how much each bin rose, and nothing for those that fell
+	FloatVectorOperations::max(frame.data(), magnitudes.data(), previousMagnitudes.data(), numBins);
+	FloatVectorOperations::subtract(frame.data(), previousMagnitudes.data(), numBins);
+	onsets.push_back(sumOf(frame.data(), numBins));
+	bassOnsets.push_back(sumOf(frame.data() + 1, numBassBins));
+
+	magnitudes.swap(previousMagnitudes);
+}
+
+TrackAnalysis TempoDetector::finish()
+{
+	TrackAnalysis result;
+	const std::vector<float> envelope{ toEnvelope(onsets) };
+	const std::vector<float> bassEnvelope{ toEnvelope(bassOnsets) };
+
+	bool beatInBass{ false };
+	double period{ findPeriod(envelope, bassEnvelope, beatInBass) };
+	if (period <= 0.0)
+		return result;
+
+	double phase{ 0.0 };
+	refineGrid(beatInBass ? bassEnvelope : envelope, period, phase);
+
+	// hi-hats often have more flux than the kicks, so the beat is the quarter with the most bass.
+	// a track with no bass keeps the phase it had, ties go to the first candidate
+	float bestBass{ gridScore(bassEnvelope, period, phase) };
+	const double firstPhase{ phase };
+	for (int quarter = 1; quarter < 4; ++quarter)
+	{
+		const double candidate{ std::fmod(firstPhase + quarter * period / 4.0, period) };
+		const float bass{ gridScore(bassEnvelope, period, candidate) };
+		if (bass > bestBass)
+		{
+			bestBass = bass;
+			phase = candidate;
+		}
+	}
+
+	// frame k holds the flux of the hop starting half a frame after it
+	result.bpm = 60.0 * frameRate / period;
+	result.firstBeat = std::fmod((phase * hopSize + fftSize / 2) * decimation / sampleRate, 60.0 / result.bpm);
+	return result;
+}
+
+/* the flux above its running mean over half a second, so loud passages do not drown out the quiet ones,
+   smoothed a little so a grid line falling between two frames still lands on the onset */
+std::vector<float> TempoDetector::toEnvelope(const std::vector<float>& flux) const
+{
+	const size_t numFrames{ flux.size() };
+	const size_t halfWidth{ (size_t) jmax(1, roundToInt(frameRate * 0.25)) };
+
+	std::vector<double> runningSum(numFrames + 1, 0.0);
+	for (size_t i = 0; i < numFrames; ++i)
+		runningSum[i + 1] = runningSum[i] + flux[i];
+
+	std::vector<float> envelope(numFrames);
+	for (size_t i = 0; i < numFrames; ++i)
+	{
+		const size_t low{ i > halfWidth ? i - halfWidth : 0 };
+		const size_t high{ std::min(numFrames, i + halfWidth + 1) };
+		const double mean{ (runningSum[high] - runningSum[low]) / (double) (high - low) };
+		envelope[i] = (float) jmax(0.0, flux[i] - mean);
+	}
+
+	std::vector<float> smoothed(numFrames);
+	for (size_t i = 0; i < numFrames; ++i)
+		smoothed[i] = 0.5f * envelope[i] + 0.25f * (envelope[i > 0 ? i - 1 : i] + envelope[i + 1 < numFrames ? i + 1 : i]);
+	return smoothed;
+}
+
+/* the autocorrelation of an envelope through an FFT, with its mean taken off first so a busy envelope
+   with no pattern correlates with nothing. scaled so lag zero is one, and empty if the envelope is flat */
+std::vector<float> TempoDetector::autocorrelate(const std::vector<float>& envelope, int numFrames)
+{
+	// zero padded to twice the length so the correlation does not wrap round
+	int order{ 1 };
+	while ((1 << order) < numFrames * 2)
+		++order;
+	const int size{ 1 << order };
+
+	std::vector<float> correlation((size_t) size * 2, 0.0f);
+	FloatVectorOperations::copy(correlation.data(), envelope.data(), numFrames);
+	FloatVectorOperations::add(correlation.data(), -sumOf(envelope.data(), numFrames) / numFrames, numFrames);
+
+	dsp::FFT correlationFft{ order };
+	correlationFft.performRealOnlyForwardTransform(correlation.data(), true);
+
+	// the power spectrum, whose inverse transform is the autocorrelation
+	for (size_t bin = 0; bin <= (size_t) size / 2; ++bin)
+	{
+		const float re{ correlation[bin * 2] };
+		const float im{ correlation[bin * 2 + 1] };
+		correlation[bin * 2] = re * re + im * im;
+		correlation[bin * 2 + 1] = 0.0f;
+	}
+	correlationFft.performRealOnlyInverseTransform(correlation.data());
+
+	const float energy{ correlation[0] };
+	if (energy <= 0.0f)
+		return {};
+
+	correlation.resize((size_t) numFrames);
+	FloatVectorOperations::multiply(correlation.data(), 1.0f / energy, numFrames);
+	return correlation;
+}
+
+/* scores every lag a beat could repeat at on the autocorrelations of the whole envelope and the bass */
+double TempoDetector::findPeriod(const std::vector<float>& envelope, const std::vector<float>& bassEnvelope, bool& beatInBass) const
+{
+	const double shortestLag{ 60.0 * frameRate / maxBpm };
+	const int longestLag{ (int) std::ceil(60.0 * frameRate / minBpm) };
+
+	// anything shorter than four of the slowest beats has no tempo worth giving
+	const int numFrames{ jmin((int) envelope.size(), maxCorrelationFrames) };
+	if (numFrames < longestLag * 4 + 2)
+		return 0.0;
+
+	const std::vector<float> correlation{ autocorrelate(envelope, numFrames) };
+	const std::vector<float> bassCorrelation{ autocorrelate(bassEnvelope, numFrames) };
+	if (correlation.empty())
+		return 0.0;
+
+	// the bass has a say, so hi-hats between the kicks do not get a track read at two thirds of its tempo.
+	// weighted towards 120 BPM for tracks whose beat and half beat correlate about as well
+	auto score = [&](int lag)
+	{
+		const double octaves{ std::log2(60.0 * frameRate / lag / 120.0) / tempoPriorWidth };
+		const float bass{ bassCorrelation.empty() ? 0.0f : bassCorrelation[(size_t) lag] };
+		return (correlation[(size_t) lag] + bass) * std::exp(-0.5 * octaves * octaves);
+	};
+
+	int bestLag{ 0 };
+	double bestScore{ 0.0 };
+	for (int lag = (int) std::floor(shortestLag); lag <= longestLag; ++lag)
+	{
+		const double lagScore{ score(lag) };
+		if (lagScore > bestScore)
+		{
+			bestScore = lagScore;
+			bestLag = lag;
+		}
+	}
+
+	// either the whole spectrum or the bass alone has to repeat clearly, kicks under a dense mix may only show in the bass
+	const float bassAtBest{ bassCorrelation.empty() ? 0.0f : bassCorrelation[(size_t) bestLag] };
+	if (bestLag == 0 || jmax(correlation[(size_t) bestLag], bassAtBest) < minBeatStrength)
+		return 0.0;
+	beatInBass = bassAtBest > correlation[(size_t) bestLag];
+
+	// a parabola through the best lag and its neighbours puts the peak between frames
+	const double before{ score(bestLag - 1) };
+	const double after{ score(bestLag + 1) };
+	const double curvature{ before - 2.0 * bestScore + after };
+	const double offset{ curvature < 0.0 ? 0.5 * (before - after) / curvature : 0.0 };
+	return bestLag + jlimit(-0.5, 0.5, offset);
+}
+
+/* tries periods around the rough one and every phase within a beat, keeping the grid whose lines land on the most onset.
+   a coarse pass a percent either side first, then a fine one around its best */
+void TempoDetector::refineGrid(const std::vector<float>& envelope, double& period, double& phase) const
+{
+	struct Pass
+	{
+		double spread;      // fraction of the period either side
+		int steps;          // periods tried either side
+		double phaseStep;   // frames
+	};
+
+	float bestScore{ -1.0f };
+	for (auto pass : { Pass{ 0.01, 20, 0.5 }, Pass{ 0.001, 20, 0.25 } })
+	{
+		const double centre{ period };
+		for (int step = -pass.steps; step <= pass.steps; ++step)
+		{
+			const double beatLength{ centre * (1.0 + pass.spread * step / pass.steps) };
+			for (double offset = 0.0; offset < beatLength; offset += pass.phaseStep)
+			{
+				const float candidateScore{ gridScore(envelope, beatLength, offset) };
+				if (candidateScore > bestScore)
+				{
+					bestScore = candidateScore;
+					period = beatLength;
+					phase = offset;
+				}
+			}
+		}
+	}
+}
+
+/* the mean of the envelope under every line of the grid */
+float TempoDetector::gridScore(const std::vector<float>& envelope, double period, double phase)
+{
+	const double lastFrame{ (double) envelope.size() - 1.0 };
+	float total{ 0.0f };
+	int numBeats{ 0 };
+	for (double position = phase; position < lastFrame; position += period, ++numBeats)
+		total += envelope[(size_t) (position + 0.5)];
+	return numBeats > 0 ? total / numBeats : 0.0f;
+}
+
+//==============================================================================
+/* finds a track's musical key from its chroma */
+
+KeyDetector::KeyDetector(double _sampleRate) :
+	decimation{ jmax(1, (int) (_sampleRate / 10000.0)) }
+{
+	window.resize((size_t) fftSize);
+	dsp::WindowingFunction<float>::fillWindowingTables(window.data(), (size_t) fftSize, dsp::WindowingFunction<float>::hann, false);
+
+	frame.resize((size_t) fftSize * 2);
+	samples.resize((size_t) fftSize);
+
+	// one more edge than there are notes, note n covers bins firstBins[n] up to firstBins[n + 1]
+	const double binsPerHz{ fftSize * decimation / _sampleRate };
+	for (int note = lowestNote; note <= highestNote + 1; ++note)
+	{
+		const double edge{ 440.0 * std::pow(2.0, (note - 69.5) / 12.0) };
+		firstBins.push_back(jlimit(1, fftSize / 2, roundToInt(edge * binsPerHz)));
+	}
+}
+
+/* mixes the block to mono, averages it down and takes a frame every hop, the same way the tempo detector does */
+void KeyDetector::addBlock(const AudioBuffer<float>& block, int startSample, int num)
+{
+	const int numChannels{ block.getNumChannels() };
+	if (numChannels == 0 || num <= 0)
+		return;
+
+	const float gain{ 1.0f / numChannels };
+	mono.resize((size_t) num);
+	FloatVectorOperations::copyWithMultiply(mono.data(), block.getReadPointer(0, startSample), gain, num);
+	for (int ch = 1; ch < numChannels; ++ch)
+		FloatVectorOperations::addWithMultiply(mono.data(), block.getReadPointer(ch, startSample), gain, num);
+
+	for (int i = 0; i < num; ++i)
+	{
+		decimationSum += mono[(size_t) i];
+		if (++decimationCount < decimation)
+			continue;
+
+		samples[(size_t) numSamples++] = decimationSum / decimation;
+		decimationSum = 0.0f;
+		decimationCount = 0;
+
+		if (numSamples == fftSize)
+		{
+			addFrame();
+			std::copy(samples.begin() + hopSize, samples.end(), samples.begin());
+			numSamples = fftSize - hopSize;
+		}
+	}
+}
+
+/* the loudest bin of every semitone goes to its pitch class, so a note counts the same in every octave
+   however many bins it spans there */
+void KeyDetector::addFrame()
+{
+	FloatVectorOperations::multiply(frame.data(), samples.data(), window.data(), fftSize);
+	FloatVectorOperations::clear(frame.data() + fftSize, fftSize);
+	fft.performFrequencyOnlyForwardTransform(frame.data(), true);
+
+	// scaled so a full scale sine has a magnitude of one
+	FloatVectorOperations::multiply(frame.data(), 4.0f / fftSize, fftSize / 2 + 1);
+
+	float frameChroma[12]{};
+	for (int note = lowestNote; note <= highestNote; ++note)
+	{
+		const int first{ firstBins[(size_t) (note - lowestNote)] };
+		const int last{ jmax(first + 1, firstBins[(size_t) (note - lowestNote + 1)]) };
+		frameChroma[note % 12] += std::log1p(compression * FloatVectorOperations::findMaximum(frame.data() + first, last - first));
+	}
+
+	// silence says nothing about the key
+	const float peak{ *std::max_element(std::begin(frameChroma), std::end(frameChroma)) };
+	if (peak < 0.01f)
+		return;
+
+	for (int pitchClass = 0; pitchClass < 12; ++pitchClass)
+		chroma[pitchClass] += frameChroma[pitchClass] / peak;
+}
+
+String KeyDetector::finish()
+{
+	int bestTonic{ 0 };
+	bool bestMinor{ false };
+	float bestCorrelation{ minKeyCorrelation };
+	bool found{ false };
+
+	for (int tonic = 0; tonic < 12; ++tonic)
+	{
+		for (bool minor : { false, true })
+		{
+			const float correlation{ correlate(minor ? minorProfile : majorProfile, tonic) };
+			if (correlation > bestCorrelation)
+			{
+				bestCorrelation = correlation;
+				bestTonic = tonic;
+				bestMinor = minor;
+				found = true;
+			}
+		}
+	}
+	return found ? toCamelot(bestTonic, bestMinor) : String();
+}
+
+/* pearson correlation of the chroma with a profile moved up to the tonic, zero for a flat chroma */
+float KeyDetector::correlate(const float* profile, int tonic) const
+{
+	float chromaMean{ 0.0f }, profileMean{ 0.0f };
+	for (int i = 0; i < 12; ++i)
+	{
+		chromaMean += chroma[(tonic + i) % 12] / 12.0f;
+		profileMean += profile[i] / 12.0f;
+	}
+
+	float products{ 0.0f }, chromaSquares{ 0.0f }, profileSquares{ 0.0f };
+	for (int i = 0; i < 12; ++i)
+	{
+		const float c{ chroma[(tonic + i) % 12] - chromaMean };
+		const float p{ profile[i] - profileMean };
+		products += c * p;
+		chromaSquares += c * c;
+		profileSquares += p * p;
+	}
+	return chromaSquares > 0.0f ? products / std::sqrt(chromaSquares * profileSquares) : 0.0f;
+}
+
+/* the wheel goes round the circle of fifths from C major at 8B, a minor key shares its number with its relative major */
+String KeyDetector::toCamelot(int tonic, bool minor)
+{
+	const int major{ minor ? (tonic + 3) % 12 : tonic };
+	return String((major * 7 + 7) % 12 + 1) + (minor ? "A" : "B");
+}
+
+//==============================================================================
+/* measures a track's integrated loudness and true peak the way EBU R128 and ITU-R BS.1770 do */
+
+LoudnessMeter::LoudnessMeter(double sampleRate) :
+	samplesPerStep{ jmax(1, roundToInt(sampleRate * 0.1)) }
+{
+	// the K-weighting filters are given for 48kHz, these are the same analogue prototypes at the track's rate
+	{
+		const double f0{ 1681.974450955533 }, q{ 0.7071752369554196 };
+		const double k{ std::tan(MathConstants<double>::pi * f0 / sampleRate) };
+		const double vh{ std::pow(10.0, 3.999843853973347 / 20.0) };
+		const double vb{ std::pow(vh, 0.4996667741545416) };
+		const double a0{ 1.0 + k / q + k * k };
+		shelf.b0 = (vh + vb * k / q + k * k) / a0;
+		shelf.b1 = 2.0 * (k * k - vh) / a0;
+		shelf.b2 = (vh - vb * k / q + k * k) / a0;
+		shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+		shelf.a2 = (1.0 - k / q + k * k) / a0;
+	}
+	{
+		const double f0{ 38.13547087602444 }, q{ 0.5003270373238773 };
+		const double k{ std::tan(MathConstants<double>::pi * f0 / sampleRate) };
+		const double a0{ 1.0 + k / q + k * k };
+		highPass.b0 = 1.0;
+		highPass.b1 = -2.0;
+		highPass.b2 = 1.0;
+		highPass.a1 = 2.0 * (k * k - 1.0) / a0;
+		highPass.a2 = (1.0 - k / q + k * k) / a0;
+	}
+
+	// a 48 tap windowed sinc split into its four phases, each scaled to unity gain at DC
+	const int numTaps{ oversampling * tapsPerPhase };
+	for (int phase = 0; phase < oversampling; ++phase)
+	{
+		double total{ 0.0 };
+		for (int k = 0; k < tapsPerPhase; ++k)
+		{
+			const double x{ (phase + oversampling * k - (numTaps - 1) / 2.0) / oversampling };
+			const double arg{ MathConstants<double>::pi * x };
+			const double sincValue{ std::abs(arg) < 1.0e-9 ? 1.0 : std::sin(arg) / arg };
+			const double halfWidth{ tapsPerPhase / 2.0 };
+			const double w{ 0.42 + 0.5 * std::cos(MathConstants<double>::pi * x / halfWidth)
+				+ 0.08 * std::cos(MathConstants<double>::twoPi * x / halfWidth) };
+			coefficients[phase][k] = (float) (sincValue * jmax(0.0, w));
+			total += coefficients[phase][k];
+		}
+		for (int k = 0; k < tapsPerPhase; ++k)
+			coefficients[phase][k] = (float) (coefficients[phase][k] / total);
+	}
+}
+
+double LoudnessMeter::Biquad::process(double x, int channel)
+{
+	const double y{ b0 * x + z1[channel] };
+	z1[channel] = b1 * x - a1 * y + z2[channel];
+	z2[channel] = b2 * x - a2 * y;
+	return y;
+}
+
+/* the true peak a block at a time, then the K-weighted squares a sample at a time into 100ms steps */
+void LoudnessMeter::addBlock(const AudioBuffer<float>& block, int startSample, int num)
+{
+	const int numChannels{ jmin(block.getNumChannels(), 2) };
+	if (numChannels == 0 || num <= 0)
+		return;
+
+	const float* in[2]{};
+	for (int ch = 0; ch < numChannels; ++ch)
+	{
+		in[ch] = block.getReadPointer(ch, startSample);
+		addTruePeak(in[ch], ch, num);
+	}
+
+	for (int i = 0; i < num; ++i)
+	{
+		for (int ch = 0; ch < numChannels; ++ch)
+		{
+			const double weighted{ highPass.process(shelf.process(in[ch][i], ch), ch) };
+			stepSquares += weighted * weighted;
+		}
+
+		if (++stepSamples == samplesPerStep)
+		{
+			stepPowers.push_back(stepSquares / samplesPerStep);
+			stepSquares = 0.0;
+			stepSamples = 0;
+		}
+	}
+}
+
+/* every phase of the upsampled block is built with one multiply-add over the block per tap */
+void LoudnessMeter::addTruePeak(const float* samples, int channel, int num)
+{
+	const int numHistory{ tapsPerPhase - 1 };
+	auto& padded = history[channel];
+	padded.resize((size_t) (numHistory + num));   // starts with silence before the first block
+	FloatVectorOperations::copy(padded.data() + numHistory, samples, num);
+	const float* current{ padded.data() + numHistory };
+
+	// the samples themselves, the phases all fall between them
+	const auto sampleRange = FloatVectorOperations::findMinAndMax(current, num);
+	peak = jmax(peak, -sampleRange.getStart(), sampleRange.getEnd());
+
+	interpolated.resize((size_t) num);
+	for (int phase = 0; phase < oversampling; ++phase)
+	{
+		FloatVectorOperations::copyWithMultiply(interpolated.data(), current, coefficients[phase][0], num);
+		for (int k = 1; k < tapsPerPhase; ++k)
+			FloatVectorOperations::addWithMultiply(interpolated.data(), current - k, coefficients[phase][k], num);
+
+		const auto range = FloatVectorOperations::findMinAndMax(interpolated.data(), num);
+		peak = jmax(peak, -range.getStart(), range.getEnd());
+	}
+
+	std::copy(padded.end() - numHistory, padded.end(), padded.begin());
+}
+
+/* gates the 400ms blocks twice and takes the loudness of what passes both */
+void LoudnessMeter::finish(TrackAnalysis& result) const
+{
+	std::vector<double> blockPowers;
+	for (size_t i = 0; i + 4 <= stepPowers.size(); ++i)
+		blockPowers.push_back((stepPowers[i] + stepPowers[i + 1] + stepPowers[i + 2] + stepPowers[i + 3]) / 4.0);
+
+	// anything shorter than a block is measured whole
+	if (blockPowers.empty())
+	{
+		double squares{ stepSquares };
+		int numSamples{ stepSamples };
+		for (double power : stepPowers)
+		{
+			squares += power * samplesPerStep;
+			numSamples += samplesPerStep;
+		}
+		if (numSamples > 0)
+			blockPowers.push_back(squares / numSamples);
+	}
+
+	auto toLoudness = [](double power) { return -0.691 + 10.0 * std::log10(power); };
+	auto meanAbove = [&](double gate)
+	{
+		double total{ 0.0 };
+		int numBlocks{ 0 };
+		for (double power : blockPowers)
+		{
+			if (power > 0.0 && toLoudness(power) > gate)
+			{
+				total += power;
+				++numBlocks;
+			}
+		}
+		return numBlocks > 0 ? total / numBlocks : 0.0;
+	};
+
+	const double ungated{ meanAbove(absoluteGate) };
+	const double gated{ ungated > 0.0 ? meanAbove(toLoudness(ungated) - 10.0) : 0.0 };
+	result.loudness = gated > 0.0 ? toLoudness(gated) : absoluteGate;
+	result.truePeak = Decibels::gainToDecibels((double) peak);
+}
+
+//==============================================================================
+/* analysis results kept by a hash of each file's contents */
+
+AnalysisCache::AnalysisCache(const File& _cacheFile) :
+	cacheFile{ _cacheFile }
+{
+	load();
+}
+
+AnalysisCache::~AnalysisCache()
+{
+	save();
+}
+
+File AnalysisCache::getDefaultCacheFile()
+{
+	return File::getSpecialLocation(File::userApplicationDataDirectory)
+		.getChildFile("OtoDecks")
+		.getChildFile("analysis-cache.bin");
+}
+
+bool AnalysisCache::find(const String& contentHash, TrackAnalysis& result) const
+{
+	if (contentHash.isEmpty())
+		return false;
+
+	const ScopedLock sl(lock);
+	auto it = entries.find(contentHash);
+	if (it == entries.end() || (it->second.measured & TrackAnalysis::allMeasured) != TrackAnalysis::allMeasured)
+		return false;
+
+	result = it->second;
+	return true;
+}
+
+void AnalysisCache::store(const String& contentHash, const TrackAnalysis& analysis)
+{
+	if (contentHash.isEmpty())
+		return;
+
+	const ScopedLock sl(lock);
+	entries[contentHash] = analysis;
+	changed = true;
+}
+
+int AnalysisCache::getNumEntries() const
+{
+	const ScopedLock sl(lock);
+	return (int) entries.size();
+}
+
+/* reads the cache written by a previous session, a missing or outdated file just starts empty */
+void AnalysisCache::load()
+{
+	FileInputStream in{ cacheFile };
+	if (!in.openedOk() || in.readInt() != analysisMagic || in.readInt() != analysisVersion)
+		return;
+
+	const ScopedLock sl(lock);
+	const int numEntries{ in.readInt() };
+	for (int i = 0; i < numEntries && !in.isExhausted(); ++i)
+	{
+		const String contentHash{ in.readString() };
+		TrackAnalysis analysis;
+		analysis.bpm = in.readDouble();
+		analysis.firstBeat = in.readDouble();
+		analysis.key = in.readString();
+		analysis.loudness = in.readDouble();
+		analysis.truePeak = in.readDouble();
+		analysis.measured = (uint8) in.readByte();
+		entries[contentHash] = analysis;
+	}
+	DBG("AnalysisCache::load: " << (int) entries.size() << " entries from " << cacheFile.getFullPathName());
+}
+
+/* writes to a temporary file and swaps it in, so a crash mid-save never leaves a broken cache */
+void AnalysisCache::save()
+{
+	const ScopedLock sl(lock);
+	if (!changed)
+		return;
+
+	cacheFile.getParentDirectory().createDirectory();
+	TemporaryFile temp{ cacheFile };
+	{
+		FileOutputStream out{ temp.getFile() };
+		if (!out.openedOk())
+			return;
+
+		out.writeInt(analysisMagic);
+		out.writeInt(analysisVersion);
+		out.writeInt((int) entries.size());
+		for (auto& entry : entries)
+		{
+			out.writeString(entry.first);
+			out.writeDouble(entry.second.bpm);
+			out.writeDouble(entry.second.firstBeat);
+			out.writeString(entry.second.key);
+			out.writeDouble(entry.second.loudness);
+			out.writeDouble(entry.second.truePeak);
+			out.writeByte((char) entry.second.measured);
+		}
+		out.flush();
+		if (out.getStatus().failed())
+			return;
+	}
+
+	if (temp.overwriteTargetFileWithTemporary())
+		changed = false;
+}
+
+//==============================================================================
+/* analyses library tracks in the background on every core */
+
+TrackAnalyser::TrackAnalyser(AudioFormatManager& _formatManager, WaveformCache& _waveformCache, AnalysisCache& _analysisCache) :
+	formatManager{ _formatManager },
+	waveformCache{ _waveformCache },
+	analysisCache{ _analysisCache }
+{
+}
+
+TrackAnalyser::~TrackAnalyser()
+{
+	stopTimer();
+	{
+		const ScopedLock sl(queueLock);
+		queue.clear();
+	}
+	pool.removeAllJobs(true, 5000);
+}
+
+/* starts another worker while there are idle threads, each one drains the queue until it is empty */
+void TrackAnalyser::analyse(uint32 trackId, const File& file)
+{
+	{
+		const ScopedLock sl(queueLock);
+		if (!queuedIds.insert(trackId).second)
+			return;
+
+		queue.push_back({ trackId, file });
+		++numQueued;
+
+		if (numWorkers < pool.getNumThreads())
+		{
+			++numWorkers;
+			pool.addJob([this] { runWorker(); });
+		}
+	}
+
+	if (!isTimerRunning())
+		startTimer(250);
+}
+
+int TrackAnalyser::getNumQueued() const
+{
+	return numQueued.load();
+}
+
+/* pool thread, analyses queued tracks one after another, stopping early if the pool is shutting down */
+void TrackAnalyser::runWorker()
+{
+	for (;;)
+	{
+		Request request;
+		{
+			const ScopedLock sl(queueLock);
+			auto* job = ThreadPoolJob::getCurrentThreadPoolJob();
+			if (queue.empty() || (job != nullptr && job->shouldExit()))
+			{
+				--numWorkers;
+				return;
+			}
+
+			request = std::move(queue.front());
+			queue.pop_front();
+		}
+
+		// a file whose contents were measured before is not decoded again
+		TrackAnalysis analysis;
+		const String contentHash{ TrackMetadataIndex::computeFingerprint(request.file) };
+		bool analysed{ analysisCache.find(contentHash, analysis) };
+		if (!analysed && analyseFile(request.file, analysis))
+		{
+			analysisCache.store(contentHash, analysis);
+			analysed = true;
+		}
+
+		{
+			const ScopedLock sl(queueLock);
+			queuedIds.erase(request.trackId);
+			if (analysed)
+				finished.push_back({ request.trackId, analysis });
+		}
+		--numQueued;
+	}
+}
+
+/* one decode feeds the tempo and key detectors, the loudness meter and, if the cache has none yet, the waveform builder */
+bool TrackAnalyser::analyseFile(const File& file, TrackAnalysis& result) const
+{
+	std::unique_ptr<AudioFormatReader> reader{ formatManager.createReaderFor(file) };
+	if (reader == nullptr || reader->sampleRate <= 0 || reader->lengthInSamples <= 0)
+		return false;
+
+	std::unique_ptr<WaveformPyramid::Builder> waveformBuilder;
+	if (!waveformCache.contains(file))
+		waveformBuilder = std::make_unique<WaveformPyramid::Builder>(reader->sampleRate, reader->lengthInSamples);
+
+	TempoDetector tempoDetector{ reader->sampleRate };
+	KeyDetector keyDetector{ reader->sampleRate };
+	LoudnessMeter loudnessMeter{ reader->sampleRate };
+
+	const int blockSize{ 65536 };
+	AudioBuffer<float> block{ jmin((int) reader->numChannels, 2), blockSize };
+
+	for (int64 pos = 0; pos < reader->lengthInSamples; pos += blockSize)
+	{
+		if (auto* job = ThreadPoolJob::getCurrentThreadPoolJob())
+			if (job->shouldExit())
+				return false;
+
+		const int numSamples{ (int) jmin((int64) blockSize, reader->lengthInSamples - pos) };
+		reader->read(&block, 0, numSamples, pos, true, true);
+
+		tempoDetector.addBlock(block, 0, numSamples);
+		keyDetector.addBlock(block, 0, numSamples);
+		loudnessMeter.addBlock(block, 0, numSamples);
+		if (waveformBuilder != nullptr)
+			waveformBuilder->addBlock(block, 0, numSamples);
+	}
+
+	result = tempoDetector.finish();
+	result.key = keyDetector.finish();
+	loudnessMeter.finish(result);
+	result.measured = TrackAnalysis::allMeasured;
+	if (waveformBuilder != nullptr)
+		waveformCache.store(file, waveformBuilder->finish());
+	return true;
+}
+
+/* hands every track finished since the last tick to the library in one go */
+void TrackAnalyser::timerCallback()
+{
+	// read before draining, so results pushed by the last worker are never left behind
+	const bool allDone{ numQueued.load() <= 0 };
+
+	std::vector<AnalysedTrack> batch;
+	{
+		const ScopedLock sl(queueLock);
+		batch.swap(finished);
+	}
+
+	if (!batch.empty() && onTracksAnalysed != nullptr)
+		onTracksAnalysed(batch);
+
+	if (allDone)
+	{
+		stopTimer();
+		analysisCache.save();
+	}
+}
@@ -0,0 +1,302 @@
+/*
+  ==============================================================================
+
+	TrackAnalyser.h
+	Created: 19th October 2026 - 03:10 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "WaveformCache.h"
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+//==============================================================================
+/* what analysing a track found out about it */
+
+struct TrackAnalysis
+{
+	// which measurements a track has had, kept in the library so tracks analysed before a new kind was added are caught up
+	enum Measurements : juce::uint8
+	{
+		tempoMeasured = 1,
+		keyMeasured = 2,
+		loudnessMeasured = 4,
+		allMeasured = tempoMeasured | keyMeasured | loudnessMeasured
+	};
+
+	double bpm{ 0.0 };         // zero if the track has no steady beat
+	double firstBeat{ 0.0 };   // seconds, the grid has a beat every 60 / bpm seconds from here
+	juce::String key;          // camelot notation like "8A", empty if no key stands out
+	double loudness{ 0.0 };    // integrated loudness in LUFS
+	double truePeak{ 0.0 };    // dBTP
+	juce::uint8 measured{ 0 };   // the Measurements this holds
+};
+
+//==============================================================================
+/* finds a track's tempo and where its beats fall, fed the decoded audio a block at a time.
+
+   the audio is mixed to mono and averaged down to around 22kHz, then onset envelopes are taken from
+   the spectral flux of short FFT frames, how much louder each frequency got since the frame before,
+   over the whole spectrum and over the bass alone. their autocorrelations, worked out with a second
+   FFT, peak at the lags where the beat repeats, and the strongest lag between minBpm and maxBpm gives
+   a rough period. the period and the grid's phase are then refined together against whichever
+   envelope repeats more clearly, so the tempo is right to a few hundredths of a BPM over a full
+   track, and the grid is moved onto the quarter of the beat with the most bass so it sits on the
+   kicks rather than the hi-hats.
+   the grid assumes the tempo is steady, as it is in nearly all dance music */
+
+class TempoDetector
+{
+public:
+	TempoDetector(double _sampleRate);
+
+	void addBlock(const juce::AudioBuffer<float>& block, int startSample, int numSamples);
+
+	// bpm is left at zero if nothing repeats strongly enough to call a beat
+	TrackAnalysis finish();
+
+	static constexpr double minBpm{ 70.0 };
+	static constexpr double maxBpm{ 180.0 };
+
+private:
+	void addFrame();
+	std::vector<float> toEnvelope(const std::vector<float>& flux) const;
+	// in frames, zero if there is no clear beat. beatInBass says which envelope repeats more clearly
+	double findPeriod(const std::vector<float>& envelope, const std::vector<float>& bassEnvelope, bool& beatInBass) const;
+	void refineGrid(const std::vector<float>& envelope, double& period, double& phase) const;   // both in frames
+	static std::vector<float> autocorrelate(const std::vector<float>& envelope, int numFrames);
+	static float gridScore(const std::vector<float>& envelope, double period, double phase);
+
+	static constexpr int fftOrder{ 9 };
+	static constexpr int fftSize{ 1 << fftOrder };
+	static constexpr int hopSize{ fftSize / 2 };
+	static constexpr int numBins{ fftSize / 2 + 1 };
+
+	double sampleRate;
+	int decimation{ 1 };       // input samples averaged into each analysed one
+	double frameRate{ 0.0 };   // onset frames per second
+	int numBassBins{ 1 };      // bins above DC up to about 150Hz
+
+	juce::dsp::FFT fft{ fftOrder };
+	std::vector<float> window, frame, magnitudes, previousMagnitudes;
+
+	std::vector<float> mono;      // the current block mixed down
+	std::vector<float> samples;   // decimated samples waiting to fill a frame
+	int numSamples{ 0 };
+	float decimationSum{ 0.0f };
+	int decimationCount{ 0 };
+
+	std::vector<float> onsets;       // spectral flux, one per hop
+	std::vector<float> bassOnsets;   // the same over the bass bins only
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TempoDetector)
+};
+
+//==============================================================================
+/* finds a track's musical key from its chroma, how strongly each of the twelve pitch classes is heard.
+
+   the audio is mixed to mono and averaged down to around 10kHz, and long FFT frames are taken so
+   even the bass notes fall in bins of their own. each frame's loudest bin within every semitone from
+   C2 to B6 is log compressed and folded into its pitch class, and frames are scaled to the same peak
+   so quiet passages count as much as loud ones. the chroma of the whole track is then correlated
+   with the krumhansl-kessler major and minor profiles in all twelve keys, and the best fit wins.
+   a track that modulates gets the key it spends most time in, and one mistaken for its relative major or
+   minor still gets the right number on the camelot wheel, which is what matters for mixing in key */
+
+class KeyDetector
+{
+public:
+	KeyDetector(double _sampleRate);
+
+	void addBlock(const juce::AudioBuffer<float>& block, int startSample, int numSamples);
+
+	// camelot notation, empty if no key fits well enough, as with drum tracks
+	juce::String finish();
+
+	// the camelot wheel number and letter for a key, tonic 0 is C
+	static juce::String toCamelot(int tonic, bool minor);
+
+private:
+	void addFrame();
+	float correlate(const float* profile, int tonic) const;
+
+	static constexpr int fftOrder{ 13 };
+	static constexpr int fftSize{ 1 << fftOrder };
+	static constexpr int hopSize{ fftSize / 2 };
+	static constexpr int lowestNote{ 36 };    // midi note numbers, C2 and B6
+	static constexpr int highestNote{ 95 };
+
+	int decimation{ 1 };
+
+	juce::dsp::FFT fft{ fftOrder };
+	std::vector<float> window, frame;
+	std::vector<int> firstBins;   // the bins each note covers, from a quarter tone below it to a quarter tone above
+
+	std::vector<float> mono;
+	std::vector<float> samples;
+	int numSamples{ 0 };
+	float decimationSum{ 0.0f };
+	int decimationCount{ 0 };
+
+	float chroma[12]{};
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(KeyDetector)
+};
+
+//==============================================================================
+/* measures a track's integrated loudness and true peak the way EBU R128 and ITU-R BS.1770 do.
+
+   the first two channels are K-weighted, a high shelf for the head's effect on sound followed by a
+   high pass, and their mean square is summed every 100ms. at the end the 400ms blocks four of those
+   make, overlapping by three quarters, are gated, first at -70 LUFS to drop silence and then at 10 LU
+   under the loudness of what is left, and the loudness of the blocks that pass is the result.
+
+   the true peak is the highest sample once the audio is upsampled four times, so peaks between the
+   samples that a DAC or a lossy encoder would bring out are caught. the upsampling filter runs a
+   whole block at a time, each of its taps one vectorised multiply-add over the block, so it costs
+   far less than decoding the file. the K-weighting filters are recursive and stay scalar */
+
+class LoudnessMeter
+{
+public:
+	LoudnessMeter(double _sampleRate);
+
+	void addBlock(const juce::AudioBuffer<float>& block, int startSample, int numSamples);
+
+	// fills in loudness and truePeak, silence reads as the absolute gate
+	void finish(TrackAnalysis& result) const;
+
+	static constexpr double absoluteGate{ -70.0 };   // LUFS
+
+private:
+	struct Biquad
+	{
+		double b0{ 1.0 }, b1{ 0.0 }, b2{ 0.0 }, a1{ 0.0 }, a2{ 0.0 };
+		double z1[2]{}, z2[2]{};   // transposed direct form II state for each channel
+
+		double process(double x, int channel);
+	};
+
+	void addTruePeak(const float* samples, int channel, int num);
+
+	static constexpr int oversampling{ 4 };
+	static constexpr int tapsPerPhase{ 12 };
+
+	Biquad shelf, highPass;
+
+	int samplesPerStep{ 1 };   // 100ms
+	int stepSamples{ 0 };
+	double stepSquares{ 0.0 };
+	std::vector<double> stepPowers;   // mean square of each 100ms, summed over the channels
+
+	float coefficients[oversampling][tapsPerPhase]{};   // tap k of a phase multiplies the sample k before the current one
+	std::vector<float> history[2];   // the last tapsPerPhase - 1 samples of each channel, then the block
+	std::vector<float> interpolated;
+	float peak{ 0.0f };
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoudnessMeter)
+};
+
+//==============================================================================
+/* analysis results kept by a hash of each file's contents, so a track is only ever decoded for analysis
+   once, even if it is renamed, copied or removed from the library and imported again.
+   the whole cache is one file in the app data folder, loaded at startup and written with a write-then-rename */
+
+class AnalysisCache
+{
+public:
+	AnalysisCache(const juce::File& _cacheFile = getDefaultCacheFile());
+	~AnalysisCache();
+
+	// any thread. false unless the contents were analysed with every measurement the analyser makes now
+	bool find(const juce::String& contentHash, TrackAnalysis& result) const;
+	void store(const juce::String& contentHash, const TrackAnalysis& analysis);
+
+	// writes the cache if anything was stored since the last save
+	void save();
+
+	int getNumEntries() const;
+
+	static juce::File getDefaultCacheFile();
+
+private:
+	void load();
+
+	juce::File cacheFile;
+
+	juce::CriticalSection lock;
+	std::unordered_map<juce::String, TrackAnalysis> entries;
+	bool changed{ false };
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalysisCache)
+};
+
+//==============================================================================
+/* analyses library tracks in the background on every core, at low priority so playback never notices.
+   each file is decoded once and the decoded blocks go to every detector, and to the waveform cache's
+   builder too if the track has no waveform yet, so a freshly imported track costs one decode for everything.
+   results are kept in the analysis cache by the file's contents, so a track that has been measured
+   before, under any name, is not decoded at all.
+
+   tracks are queued by id as they join the library, and any the library has not fully measured are
+   queued again when it loads. results come back to the message thread in batches */
+
+class TrackAnalyser : private juce::Timer
+{
+public:
+	TrackAnalyser(juce::AudioFormatManager& _formatManager, WaveformCache& _waveformCache, AnalysisCache& _analysisCache);
+	~TrackAnalyser() override;
+
+	// message thread. a track still waiting in the queue is not queued twice
+	void analyse(juce::uint32 trackId, const juce::File& file);
+
+	// tracks queued or being analysed
+	int getNumQueued() const;
+
+	// any thread. decodes the whole file on the calling thread whether or not it is cached, false if it cannot be read
+	bool analyseFile(const juce::File& file, TrackAnalysis& result) const;
+
+	struct AnalysedTrack
+	{
+		juce::uint32 trackId;
+		TrackAnalysis analysis;
+	};
+
+	// called on the message thread with the tracks finished since the last call, unreadable files are left out
+	std::function<void(const std::vector<AnalysedTrack>&)> onTracksAnalysed;
+
+private:
+	struct Request
+	{
+		juce::uint32 trackId{ 0 };
+		juce::File file;
+	};
+
+	void runWorker();
+	void timerCallback() override;
+
+	juce::AudioFormatManager& formatManager;
+	WaveformCache& waveformCache;
+	AnalysisCache& analysisCache;
+
+	juce::ThreadPool pool{ juce::jmax(1, juce::SystemStats::getNumCpus()), 0, juce::Thread::Priority::low };
+
+	// a few pool jobs drain one queue, so queueing a whole library is cheap
+	juce::CriticalSection queueLock;
+	std::deque<Request> queue;
+	std::unordered_set<juce::uint32> queuedIds;
+	std::vector<AnalysedTrack> finished;
+	int numWorkers{ 0 };
+	std::atomic<int> numQueued{ 0 };
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrackAnalyser)
+};
@@ -0,0 +1,399 @@
+/*
+  ==============================================================================
+
+	TrackLoader.cpp
+	Created: 17th October 2026 - 10:40 AM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#include "TrackLoader.h"
+#include <algorithm>
+using namespace juce;
+
+//==============================================================================
+/* the audio from a hot cue on, decoded ahead so jumping to the cue never waits on the decoder */
+
+CueAudio::CueAudio(const LoadedTrack* _track, int64 _position, int numSamples) :
+	track{ _track },
+	position{ _position },
+	buffer{ 2, numSamples }
+{
+}
+
+//==============================================================================
+/* an opened audio file ready to be handed over to a deck, shared between the player and the waveform */
+
+LoadedTrack::LoadedTrack(URL _url, AudioFormatReader* reader) :
+	url{ _url },
+	sampleRate{ reader->sampleRate },
+	lengthInSamples{ reader->lengthInSamples },
+	numChannels{ (int) reader->numChannels },
+	readerSource{ new AudioFormatReaderSource(reader, true) }
+{
+}
+
+LoadedTrack::LoadedTrack(URL _url, DecodedAudio::Ptr decoded) :
+	url{ _url },
+	sampleRate{ decoded->sampleRate },
+	lengthInSamples{ decoded->buffer.getNumSamples() },
+	numChannels{ decoded->buffer.getNumChannels() },
+	decodedAudio{ decoded },
+	memorySource{ new MemoryAudioSource(decoded->buffer, false) },
+	waveform{ decoded->waveform }
+{
+}
+
+/* returns the source the deck reads from, RAM or the read-ahead buffer when there is one */
+PositionableAudioSource* LoadedTrack::getPlaybackSource() const
+{
+	if (memorySource != nullptr)
+		return memorySource.get();
+	if (bufferedSource != nullptr)
+		return bufferedSource.get();
+	return readerSource.get();
+}
+
+/* looping is set on the innermost source, the read-ahead buffer follows it */
+void LoadedTrack::setLooping(bool shouldLoop)
+{
+	if (memorySource != nullptr)
+		memorySource->setLooping(shouldLoop);
+	if (readerSource != nullptr)
+		readerSource->setLooping(shouldLoop);
+}
+
+/* the newest audio decoded for a cue at position */
+CueAudio::Ptr LoadedTrack::getCueAudio(int64 position) const
+{
+	for (int i = cueAudio.size(); --i >= 0;)
+		if (cueAudio.getUnchecked(i)->position == position)
+			return cueAudio.getUnchecked(i);
+	return nullptr;
+}
+
+/* drops audio for cues that have been cleared or moved, a deck still playing one holds its own reference */
+void LoadedTrack::pruneCueAudio()
+{
+	for (int i = cueAudio.size(); --i >= 0;)
+		if (std::find(hotCues.positions.begin(), hotCues.positions.end(), cueAudio.getUnchecked(i)->position) == hotCues.positions.end())
+			cueAudio.remove(i);
+}
+
+/* returns length of the track in seconds, using the file's own sample rate */
+double LoadedTrack::getLengthInSeconds() const
+{
+	return sampleRate > 0 ? lengthInSamples / sampleRate : 0.0;
+}
+
+//==============================================================================
+/* background thread that opens and pre-buffers audio files so the message thread never blocks on decoding */
+
+TrackLoader::TrackLoader(AudioFormatManager& _formatManager,
+						 TimeSliceThread& _readAheadThread,
+						 DecodedTrackCache& _decodedCache,
+						 WaveformCache& _waveformCache) :
+	Thread{ "Track loader" },
+	formatManager{ _formatManager },
+	readAheadThread{ _readAheadThread },
+	decodedCache{ _decodedCache },
+	waveformCache{ _waveformCache }
+{
+	startThread();
+}
+
+TrackLoader::~TrackLoader()
+{
+	stopThread(4000);
+}
+
+/* queues a file to be opened, onLoaded is called on the message thread when done */
+void TrackLoader::loadAsync(URL audioURL, LoadOptions options, Callback onLoaded)
+{
+	{
+		const ScopedLock sl(jobLock);
+		jobs.push_back({ audioURL, options, std::move(onLoaded) });
+	}
+	notify();
+}
+
+/* a track in RAM seeks instantly, so its cues need nothing decoded. cues go ahead of any queued loads,
+   a deck is already playing the track and may jump to one at any moment */
+void TrackLoader::decodeCuesAsync(LoadedTrack::Ptr track, Array<int64> positions)
+{
+	if (track == nullptr || track->memorySource != nullptr || positions.isEmpty())
+		return;
+
+	{
+		const ScopedLock sl(jobLock);
+		jobs.push_front({ {}, {}, nullptr, track, positions });
+	}
+	notify();
+}
+
+/* a track that already has a waveform needs nothing built */
+void TrackLoader::buildWaveformAsync(LoadedTrack::Ptr track, Callback onBuilt)
+{
+	if (track == nullptr || track->waveform != nullptr)
+		return;
+
+	waveformPool.addJob(new WaveformJob(*this, track, std::move(onBuilt)), true);
+}
+
+/* a queued build is dropped and a running one stops at its next block, its completion is still posted */
+void TrackLoader::cancelWaveform(const LoadedTrack* track)
+{
+	struct TrackSelector : public ThreadPool::JobSelector
+	{
+		explicit TrackSelector(const LoadedTrack* _track) : track{ _track } {}
+
+		bool isJobSuitable(ThreadPoolJob* job) override
+		{
+			auto* waveformJob = dynamic_cast<WaveformJob*>(job);
+			return waveformJob != nullptr && waveformJob->track.get() == track;
+		}
+
+		const LoadedTrack* track;
+	};
+
+	TrackSelector selector{ track };
+	waveformPool.removeAllJobs(true, 0, &selector);
+}
+
+/* returns the cache of fully decoded tracks shared by every deck */
+DecodedTrackCache& TrackLoader::getDecodedCache()
+{
+	return decodedCache;
+}
+
+/* worker loop, opens one queued file at a time */
+void TrackLoader::run()
+{
+	while (!threadShouldExit())
+	{
+		Job job;
+		bool hasJob{ false };
+		{
+			const ScopedLock sl(jobLock);
+			if (!jobs.empty())
+			{
+				job = std::move(jobs.front());
+				jobs.pop_front();
+				hasJob = true;
+			}
+		}
+
+		if (!hasJob)
+		{
+			wait(-1);
+			continue;
+		}
+
+		if (job.cueTrack != nullptr)
+		{
+			decodeCues(job.cueTrack, job.cuePositions);
+			continue;
+		}
+
+		LoadedTrack::Ptr track = openTrack(job.url, job.options);
+		if (threadShouldExit())
+			return;
+
+		// hand the result back to the GUI, the deck swaps it in from there
+		auto onLoaded = std::move(job.onLoaded);
+		MessageManager::callAsync([onLoaded, track] { onLoaded(track); });
+	}
+}
+
+/* opens the track in RAM when asked to and possible, streaming from disk otherwise */
+LoadedTrack::Ptr TrackLoader::openTrack(const URL& audioURL, const LoadOptions& options)
+{
+	if (options.decodeToRam && audioURL.isLocalFile())
+	{
+		if (auto track = openDecodedTrack(audioURL))
+			return track;
+	}
+	return openStreamingTrack(audioURL, options);
+}
+
+/* opens the file once and pre-buffers the start. the waveform comes from the cache, a missing one is
+   left for buildWaveformAsync so the deck never waits for the whole file to be decoded */
+LoadedTrack::Ptr TrackLoader::openStreamingTrack(const URL& audioURL, const LoadOptions& options)
+{
+	auto* reader = formatManager.createReaderFor(audioURL.createInputStream(false));
+	if (reader == nullptr)
+	{
+		DBG("TrackLoader::openStreamingTrack: unable to load file");
+		return nullptr;
+	}
+
+	LoadedTrack::Ptr track{ new LoadedTrack(audioURL, reader) };
+	track->waveform = waveformCache.find(getWaveformFile(audioURL));
+
+	track->readerSource->setNextReadPosition(0);
+	if (options.readAheadSamples > 0)
+	{
+		// decoding moves to the shared read-ahead thread, prepareToPlay waits for the first fill
+		track->bufferedSource.reset(new BufferingAudioSource(track->readerSource.get(), readAheadThread, false,
+															 options.readAheadSamples, jmax(2, track->numChannels)));
+		track->bufferedSource->prepareToPlay(options.blockSize, options.sampleRate);
+	}
+	else
+	{
+		// decode the first block again so the deck starts without waiting on the decoder
+		AudioBuffer<float> primer{ 2, 4096 };
+		reader->read(&primer, 0, primer.getNumSamples(), 0, true, true);
+	}
+
+	DBG("TrackLoader::openStreamingTrack: file successfully loaded");
+	return track;
+}
+
+/* serves the track from the decoded cache, decoding and caching it on a miss */
+LoadedTrack::Ptr TrackLoader::openDecodedTrack(const URL& audioURL)
+{
+	const File file{ audioURL.getLocalFile() };
+	const String key{ DecodedTrackCache::makeKey(file) };
+
+	DecodedAudio::Ptr decoded = decodedCache.get(key);
+	if (decoded == nullptr)
+	{
+		decoded = decodeFile(file);
+		if (decoded == nullptr)
+			return nullptr;
+		decodedCache.add(key, decoded);
+	}
+
+	DBG("TrackLoader::openDecodedTrack: track loaded into RAM");
+	return new LoadedTrack(audioURL, decoded);
+}
+
+/* reads a little of the track from each position with a reader of its own, the deck's is busy playing.
+   the audio is added to the track on the message thread, where cues cleared in the meantime are dropped again */
+void TrackLoader::decodeCues(LoadedTrack::Ptr track, const Array<int64>& positions)
+{
+	std::unique_ptr<AudioFormatReader> reader{ formatManager.createReaderFor(track->url.createInputStream(false)) };
+	if (reader == nullptr)
+	{
+		DBG("TrackLoader::decodeCues: unable to open file");
+		return;
+	}
+
+	ReferenceCountedArray<CueAudio> decoded;
+	for (auto position : positions)
+	{
+		if (threadShouldExit())
+			return;
+
+		const int64 numSamples{ jlimit((int64) 0, (int64) (CueAudio::lengthInSeconds * reader->sampleRate), reader->lengthInSamples - position) };
+		CueAudio::Ptr cue{ new CueAudio(track.get(), position, (int) numSamples) };
+		reader->read(&cue->buffer, 0, (int) numSamples, position, true, true);
+		decoded.add(cue);
+	}
+
+	MessageManager::callAsync([track, decoded]
+		{
+			for (auto* cue : decoded)
+				track->cueAudio.add(cue);
+			track->pruneCueAudio();
+		});
+}
+
+//==============================================================================
+/* builds a streaming track's waveform with a reader of its own, the deck's belongs to the read-ahead thread */
+
+TrackLoader::WaveformJob::WaveformJob(TrackLoader& _owner, LoadedTrack::Ptr _track, Callback _onBuilt) :
+	ThreadPoolJob{ "Waveform" },
+	owner{ _owner },
+	track{ std::move(_track) },
+	onBuilt{ std::move(_onBuilt) }
+{
+}
+
+/* another deck loading the same file may have built it since this was queued, then the cache already has it */
+ThreadPoolJob::JobStatus TrackLoader::WaveformJob::runJob()
+{
+	const File file{ owner.getWaveformFile(track->url) };
+	WaveformPyramid::Ptr waveform = owner.waveformCache.find(file);
+	if (waveform == nullptr && file != File{})
+	{
+		waveform = owner.waveformCache.generate(file);
+		if (waveform != nullptr)
+			owner.waveformCache.store(file, waveform);
+	}
+
+	if (waveform == nullptr)
+		DBG("TrackLoader::WaveformJob: no waveform for " << track->url.toString(false));
+
+	auto builtTrack = track;
+	auto callback = onBuilt;
+	MessageManager::callAsync([builtTrack, waveform, callback]
+		{
+			builtTrack->waveform = waveform;
+			if (callback != nullptr)
+				callback(builtTrack);
+		});
+	return jobHasFinished;
+}
+
+//==============================================================================
+/* decodes a whole file to floats, memory-mapped readers skip the decoder for uncompressed formats */
+DecodedAudio::Ptr TrackLoader::decodeFile(const File& file)
+{
+	std::unique_ptr<AudioFormatReader> reader;
+	if (auto* format = formatManager.findFormatForFileExtension(file.getFileExtension()))
+	{
+		std::unique_ptr<MemoryMappedAudioFormatReader> mapped{ format->createMemoryMappedReader(file) };
+		if (mapped != nullptr && mapped->mapEntireFile())
+			reader = std::move(mapped);
+	}
+	if (reader == nullptr)
+		reader.reset(formatManager.createReaderFor(file));
+	if (reader == nullptr)
+		return nullptr;
+
+	// tracks that would not fit in the cache at all are streamed instead
+	const int numChannels{ jmin((int) reader->numChannels, 2) };
+	const size_t bytesNeeded{ (size_t) numChannels * (size_t) reader->lengthInSamples * sizeof(float) };
+	if (reader->lengthInSamples > std::numeric_limits<int>::max() || bytesNeeded > decodedCache.getBudget())
+		return nullptr;
+
+	// the file is decoded whole anyway, so a missing waveform is built on the way and saved
+	DecodedAudio::Ptr decoded{ new DecodedAudio(numChannels, (int) reader->lengthInSamples, reader->sampleRate) };
+	decoded->waveform = waveformCache.find(file);
+	if (decoded->waveform != nullptr)
+		return readWholeFile(*reader, nullptr, decoded->buffer) ? decoded : nullptr;
+
+	WaveformPyramid::Builder builder{ reader->sampleRate, reader->lengthInSamples };
+	if (!readWholeFile(*reader, &builder, decoded->buffer))
+		return nullptr;
+
+	decoded->waveform = builder.finish();
+	waveformCache.store(file, decoded->waveform);
+	return decoded;
+}
+
+/* waveforms are only cached for local files, anything else gets a file the cache never matches */
+File TrackLoader::getWaveformFile(const URL& audioURL) const
+{
+	return audioURL.isLocalFile() ? audioURL.getLocalFile() : File{};
+}
+
+/* decodes the whole file into decodeInto once, feeding the waveform builder when there is one */
+bool TrackLoader::readWholeFile(AudioFormatReader& reader, WaveformPyramid::Builder* waveform, AudioBuffer<float>& decodeInto)
+{
+	const int blockSize{ 65536 };
+
+	for (int64 pos = 0; pos < reader.lengthInSamples; pos += blockSize)
+	{
+		if (threadShouldExit())
+			return false;
+
+		const int numSamples{ (int) jmin((int64) blockSize, reader.lengthInSamples - pos) };
+		reader.read(&decodeInto, (int) pos, numSamples, pos, true, true);
+		if (waveform != nullptr)
+			waveform->addBlock(decodeInto, (int) pos, numSamples);
+	}
+	return true;
+}
@@ -0,0 +1,174 @@
+/*
+  ==============================================================================
+
+	TrackLoader.h
+	Created: 17th October 2026 - 10:05 AM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DecodedTrackCache.h"
+#include "WaveformCache.h"
+#include "TrackAnalyser.h"
+#include "Track.h"
+#include <deque>
+#include <functional>
+
+class LoadedTrack;
+
+//==============================================================================
+/* the audio from a hot cue on, decoded ahead so jumping to the cue never waits on the decoder.
+   a deck plays from it while its read-ahead buffer catches up from where it ends */
+
+class CueAudio : public juce::ReferenceCountedObject
+{
+public:
+	using Ptr = juce::ReferenceCountedObjectPtr<CueAudio>;
+
+	// long enough for the read-ahead thread to refill from the end of it with every deck busy
+	static constexpr double lengthInSeconds{ 2.0 };
+
+	CueAudio(const LoadedTrack* _track, juce::int64 _position, int numSamples);
+
+	const LoadedTrack* const track;   // only compared, the deck checks the cue is for the track it is reading
+	const juce::int64 position;
+	juce::AudioBuffer<float> buffer;  // empty when nothing was decoded, the jump is then a seek at the block start
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CueAudio)
+};
+
+//==============================================================================
+/* an opened audio file ready to be handed over to a deck, shared between the player and the waveform */
+
+class LoadedTrack : public juce::ReferenceCountedObject
+{
+public:
+	using Ptr = juce::ReferenceCountedObjectPtr<LoadedTrack>;
+
+	LoadedTrack(juce::URL _url, juce::AudioFormatReader* reader);
+	LoadedTrack(juce::URL _url, DecodedAudio::Ptr decoded);
+
+	juce::URL url;
+	double sampleRate;
+	juce::int64 lengthInSamples;
+	int numChannels;
+
+	// playback source, owns the reader
+	std::unique_ptr<juce::AudioFormatReaderSource> readerSource;
+
+	// optional read-ahead buffer in front of readerSource, decoded on the shared read-ahead thread
+	std::unique_ptr<juce::BufferingAudioSource> bufferedSource;
+
+	// fully decoded mode, seeks never go back through the decoder
+	DecodedAudio::Ptr decodedAudio;
+	std::unique_ptr<juce::MemoryAudioSource> memorySource;
+
+	// the whole track's waveform, from the waveform cache or built while decoding. a streaming track that
+	// the cache did not have gets it once buildWaveformAsync is done
+	WaveformPyramid::Ptr waveform;
+
+	// tempo and beat grid from the library, set before the track goes to a deck. bpm is zero if it has none
+	TrackAnalysis analysis;
+
+	// hot cues from the library or set on the deck, and the audio decoded from each. message thread only
+	HotCues hotCues;
+	juce::ReferenceCountedArray<CueAudio> cueAudio;
+
+	CueAudio::Ptr getCueAudio(juce::int64 position) const;   // nullptr until the track loader has decoded it
+	void pruneCueAudio();
+
+	double getLengthInSeconds() const;
+	juce::PositionableAudioSource* getPlaybackSource() const;
+	void setLooping(bool shouldLoop);
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoadedTrack)
+};
+
+//==============================================================================
+/* background thread that opens and pre-buffers audio files so the message thread never blocks on decoding.
+   a streaming track is ready as soon as its start is buffered. a waveform that is not in the waveform
+   cache yet is built after the track has been handed over, by reading the file through on a low priority
+   thread of its own, so loads and cue decodes never wait behind it */
+
+class TrackLoader : private juce::Thread
+{
+public:
+	// called on the message thread, track is nullptr if the file could not be opened
+	using Callback = std::function<void(LoadedTrack::Ptr)>;
+
+	// per deck settings used when preparing the track for playback
+	struct LoadOptions
+	{
+		int readAheadSamples{ 0 };   // 0 decodes directly on the audio thread
+		int blockSize{ 512 };
+		double sampleRate{ 44100.0 };
+		bool decodeToRam{ false };   // decode the whole file and keep it in the shared cache
+	};
+
+	TrackLoader(juce::AudioFormatManager& _formatManager,
+				juce::TimeSliceThread& _readAheadThread,
+				DecodedTrackCache& _decodedCache,
+				WaveformCache& _waveformCache);
+	~TrackLoader() override;
+
+	void loadAsync(juce::URL audioURL, LoadOptions options, Callback onLoaded);
+	DecodedTrackCache& getDecodedCache();
+
+	// decodes the audio at each position into the track's cue audio, ahead of any loads already queued
+	void decodeCuesAsync(LoadedTrack::Ptr track, juce::Array<juce::int64> positions);
+
+	// builds the waveform of a track handed over without one, onBuilt is called once it is set on the track.
+	// it is always called, with the waveform still nullptr if the file could not be read through
+	void buildWaveformAsync(LoadedTrack::Ptr track, Callback onBuilt);
+
+	// stops building the track's waveform, for a deck that has moved on to another track. never waits
+	void cancelWaveform(const LoadedTrack* track);
+
+private:
+	struct Job
+	{
+		juce::URL url;
+		LoadOptions options;
+		Callback onLoaded;
+		LoadedTrack::Ptr cueTrack;   // set for a job that decodes cues instead of opening a file
+		juce::Array<juce::int64> cuePositions;
+	};
+
+	// reads a streaming track's file through for its waveform, on the waveform pool
+	class WaveformJob : public juce::ThreadPoolJob
+	{
+	public:
+		WaveformJob(TrackLoader& _owner, LoadedTrack::Ptr _track, Callback _onBuilt);
+		JobStatus runJob() override;
+
+		TrackLoader& owner;
+		const LoadedTrack::Ptr track;
+		const Callback onBuilt;
+	};
+
+	void run() override;
+	LoadedTrack::Ptr openTrack(const juce::URL& audioURL, const LoadOptions& options);
+	LoadedTrack::Ptr openStreamingTrack(const juce::URL& audioURL, const LoadOptions& options);
+	LoadedTrack::Ptr openDecodedTrack(const juce::URL& audioURL);
+	void decodeCues(LoadedTrack::Ptr track, const juce::Array<juce::int64>& positions);
+	DecodedAudio::Ptr decodeFile(const juce::File& file);
+	juce::File getWaveformFile(const juce::URL& audioURL) const;
+	bool readWholeFile(juce::AudioFormatReader& reader, WaveformPyramid::Builder* waveform, juce::AudioBuffer<float>& decodeInto);
+
+	juce::AudioFormatManager& formatManager;
+	juce::TimeSliceThread& readAheadThread;
+	DecodedTrackCache& decodedCache;
+	WaveformCache& waveformCache;
+
+	juce::CriticalSection jobLock;
+	std::deque<Job> jobs;
+
+	// one thread is enough, it only has work when a track without a cached waveform is loaded
+	juce::ThreadPool waveformPool{ 1, 0, juce::Thread::Priority::low };
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrackLoader)
+};
@@ -0,0 +1,226 @@
+/*
+  ==============================================================================
+
+	TrackMetadataIndex.cpp
+	Created: 18th October 2026 - 09:40 AM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#include "TrackMetadataIndex.h"
+using namespace juce;
+
+namespace
+{
+	// bumped whenever the entry layout changes, older files are ignored and rebuilt
+	const int indexMagic{ (int) ByteOrder::littleEndianInt("OTIX") };
+	const int indexVersion{ 2 };
+}
+
+//==============================================================================
+/* what the library needs to know about an audio file without opening it again */
+
+bool TrackMetadata::matches(const File& file) const
+{
+	return file.getSize() == fileSize
+		&& file.getLastModificationTime().toMilliseconds() == modificationTime;
+}
+
+//==============================================================================
+/* persistent index of track metadata keyed by path, modification time and size */
+
+TrackMetadataIndex::TrackMetadataIndex(AudioFormatManager& _formatManager) :
+	formatManager{ _formatManager },
+	indexFile{ getDefaultIndexFile() }
+{
+	load();
+}
+
+TrackMetadataIndex::~TrackMetadataIndex()
+{
+	save();
+}
+
+File TrackMetadataIndex::getDefaultIndexFile()
+{
+	return File::getSpecialLocation(File::userApplicationDataDirectory)
+		.getChildFile("OtoDecks")
+		.getChildFile("track-index.bin");
+}
+
+/* returns the cached entry if the file has not changed, otherwise opens the file once to read it */
+TrackMetadata TrackMetadataIndex::getMetadata(const File& file, bool withFingerprint)
+{
+	const String path{ file.getFullPathName() };
+	TrackMetadata metadata;
+	bool upToDate{ false };
+	{
+		const ScopedLock sl(lock);
+		auto it = entries.find(path);
+		if (it != entries.end() && it->second.matches(file))
+		{
+			metadata = it->second;
+			upToDate = true;
+			if (!withFingerprint || metadata.fingerprint.isNotEmpty())
+				return metadata;
+		}
+	}
+
+	// probed outside the lock so other threads can keep hitting the index
+	if (!upToDate)
+		metadata = probe(file);
+	if (withFingerprint)
+		metadata.fingerprint = computeFingerprint(file);
+
+	const ScopedLock sl(lock);
+	entries[path] = metadata;
+	changed = true;
+	++numProbes;
+	return metadata;
+}
+
+int TrackMetadataIndex::getNumEntries() const
+{
+	const ScopedLock sl(lock);
+	return (int) entries.size();
+}
+
+/* returns how many files had to be opened since startup, a re-import of unchanged files adds none */
+int TrackMetadataIndex::getNumProbes() const
+{
+	const ScopedLock sl(lock);
+	return numProbes;
+}
+
+/* opens the file's header with whichever registered format claims it */
+TrackMetadata TrackMetadataIndex::probe(const File& file)
+{
+	TrackMetadata metadata;
+	metadata.path = file.getFullPathName();
+	metadata.modificationTime = file.getLastModificationTime().toMilliseconds();
+	metadata.fileSize = file.getSize();
+
+	std::unique_ptr<AudioFormatReader> reader{ formatManager.createReaderFor(file) };
+	if (reader != nullptr && reader->sampleRate > 0)
+	{
+		metadata.sampleRate = reader->sampleRate;
+		metadata.lengthInSeconds = reader->lengthInSamples / reader->sampleRate;
+		metadata.numChannels = (int) reader->numChannels;
+		metadata.format = reader->getFormatName();
+		metadata.tags = reader->metadataValues;
+		metadata.readable = true;
+	}
+	else
+	{
+		DBG("TrackMetadataIndex::probe: could not open " << metadata.path);
+	}
+	return metadata;
+}
+
+/* FNV-1a over the size and both ends of the file, reading 128 KB at most however long the track is */
+String TrackMetadataIndex::computeFingerprint(const File& file)
+{
+	FileInputStream in{ file };
+	if (!in.openedOk())
+		return {};
+
+	const int64 size{ in.getTotalLength() };
+	uint64 hash{ 14695981039346656037ull };
+	auto mix = [&hash](const void* data, size_t numBytes)
+	{
+		auto* bytes = static_cast<const uint8*>(data);
+		for (size_t i = 0; i < numBytes; ++i)
+			hash = (hash ^ bytes[i]) * 1099511628211ull;
+	};
+	mix(&size, sizeof(size));
+
+	const int chunkSize{ 65536 };
+	HeapBlock<char> chunk{ (size_t) chunkSize };
+	mix(chunk.get(), (size_t) in.read(chunk.get(), chunkSize));
+	if (size > chunkSize * 2)
+		in.setPosition(size - chunkSize);
+	mix(chunk.get(), (size_t) in.read(chunk.get(), chunkSize));
+
+	return String::toHexString((int64) hash);
+}
+
+//==============================================================================
+/* reads the index written by a previous session, a missing or outdated file just starts empty */
+void TrackMetadataIndex::load()
+{
+	FileInputStream in{ indexFile };
+	if (!in.openedOk() || in.readInt() != indexMagic || in.readInt() != indexVersion)
+		return;
+
+	const ScopedLock sl(lock);
+	const int numEntries{ in.readInt() };
+	for (int i = 0; i < numEntries && !in.isExhausted(); ++i)
+	{
+		TrackMetadata metadata;
+		metadata.path = in.readString();
+		metadata.modificationTime = in.readInt64();
+		metadata.fileSize = in.readInt64();
+		metadata.lengthInSeconds = in.readDouble();
+		metadata.sampleRate = in.readDouble();
+		metadata.numChannels = in.readInt();
+		metadata.format = in.readString();
+		metadata.readable = in.readBool();
+		metadata.fingerprint = in.readString();
+
+		const int numTags{ in.readInt() };
+		for (int t = 0; t < numTags; ++t)
+		{
+			const String key{ in.readString() };
+			metadata.tags.set(key, in.readString());
+		}
+		entries[metadata.path] = metadata;
+	}
+	DBG("TrackMetadataIndex::load: " << (int) entries.size() << " entries from " << indexFile.getFullPathName());
+}
+
+/* writes to a temporary file and swaps it in, so a crash mid-save never leaves a broken index */
+void TrackMetadataIndex::save()
+{
+	const ScopedLock sl(lock);
+	if (!changed)
+		return;
+
+	indexFile.getParentDirectory().createDirectory();
+	TemporaryFile temp{ indexFile };
+	{
+		FileOutputStream out{ temp.getFile() };
+		if (!out.openedOk())
+			return;
+
+		out.writeInt(indexMagic);
+		out.writeInt(indexVersion);
+		out.writeInt((int) entries.size());
+		for (auto& entry : entries)
+		{
+			const TrackMetadata& metadata = entry.second;
+			out.writeString(metadata.path);
+			out.writeInt64(metadata.modificationTime);
+			out.writeInt64(metadata.fileSize);
+			out.writeDouble(metadata.lengthInSeconds);
+			out.writeDouble(metadata.sampleRate);
+			out.writeInt(metadata.numChannels);
+			out.writeString(metadata.format);
+			out.writeBool(metadata.readable);
+			out.writeString(metadata.fingerprint);
+
+			out.writeInt(metadata.tags.size());
+			for (int t = 0; t < metadata.tags.size(); ++t)
+			{
+				out.writeString(metadata.tags.getAllKeys()[t]);
+				out.writeString(metadata.tags.getAllValues()[t]);
+			}
+		}
+		out.flush();
+		if (out.getStatus().failed())
+			return;
+	}
+
+	if (temp.overwriteTargetFileWithTemporary())
+		changed = false;
+}
@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+	TrackMetadataIndex.h
+	Created: 18th October 2026 - 09:15 AM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <unordered_map>
+
+//==============================================================================
+/* what the library needs to know about an audio file without opening it again */
+
+struct TrackMetadata
+{
+	juce::String path;
+	juce::int64 modificationTime{ 0 };   // milliseconds since 1970
+	juce::int64 fileSize{ 0 };
+	double lengthInSeconds{ 0.0 };
+	double sampleRate{ 0.0 };
+	int numChannels{ 0 };
+	juce::String format;
+	juce::StringPairArray tags;          // the reader's metadataValues
+	juce::String fingerprint;            // empty unless asked for, see computeFingerprint()
+	bool readable{ false };              // false if no registered format could open the file
+
+	// true if the file on disk is still the one this was read from
+	bool matches(const juce::File& file) const;
+};
+
+//==============================================================================
+/* persistent index of track metadata keyed by path, modification time and size.
+   files are only opened when they are new or have changed since they were last probed,
+   the index lives in the app data folder and is written with a write-then-rename */
+
+class TrackMetadataIndex
+{
+public:
+	TrackMetadataIndex(juce::AudioFormatManager& _formatManager);
+	~TrackMetadataIndex();
+
+	// returns the cached entry, or probes the file and remembers it. safe from any thread
+	TrackMetadata getMetadata(const juce::File& file, bool withFingerprint = false);
+
+	// writes the index if anything was probed since the last save
+	void save();
+
+	int getNumEntries() const;
+	int getNumProbes() const;
+
+	static juce::File getDefaultIndexFile();
+
+	// hash of the size and the first and last 64 KB, catches the same audio copied under another name
+	static juce::String computeFingerprint(const juce::File& file);
+
+private:
+	TrackMetadata probe(const juce::File& file);
+	void load();
+
+	juce::AudioFormatManager& formatManager;
+	juce::File indexFile;
+
+	juce::CriticalSection lock;
+	std::unordered_map<juce::String, TrackMetadata> entries;
+	bool changed{ false };
+	int numProbes{ 0 };
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrackMetadataIndex)
+};
@@ -0,0 +1,268 @@
+/*
+  ==============================================================================
+
+	TrackSearchIndex.cpp
+	Created: 18th October 2026 - 02:55 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#include "TrackSearchIndex.h"
+#include <algorithm>
+using namespace juce;
+
+//==============================================================================
+/* substring search over the playlist's titles and tags, backed by an index of short grams */
+
+TrackSearchIndex::TrackSearchIndex()
+{
+}
+
+/* lowercases and indexes a track appended to the playlist */
+void TrackSearchIndex::addTrack(const Track& track)
+{
+	texts += normalise(track.title + " " + track.tags);
+	offsets.push_back((uint32) texts.size());
+	indexGrams(getNumTracks() - 1);
+
+	// the new track may match the current query, so the next search starts over
+	resultsValid = false;
+}
+
+/* takes the track out of every gram list, and moves the tracks after it down one */
+void TrackSearchIndex::removeTrack(int index)
+{
+	if (!isPositiveAndBelow(index, getNumTracks()))
+		return;
+
+	const size_t length{ offsets[(size_t) index + 1] - offsets[(size_t) index] };
+	texts.erase(offsets[(size_t) index], length);
+	offsets.erase(offsets.begin() + index + 1);
+	for (size_t i = (size_t) index + 1; i < offsets.size(); ++i)
+		offsets[i] -= (uint32) length;
+
+	for (auto& gram : grams)
+	{
+		auto& list = gram.second;
+		auto it = std::lower_bound(list.begin(), list.end(), index);
+		if (it != list.end() && *it == index)
+			it = list.erase(it);
+		for (; it != list.end(); ++it)
+			--*it;
+	}
+	resultsValid = false;
+}
+
+void TrackSearchIndex::clear()
+{
+	texts.clear();
+	offsets.assign(1, 0);
+	grams.clear();
+	resultsValid = false;
+}
+
+int TrackSearchIndex::getNumTracks() const
+{
+	return (int) offsets.size() - 1;
+}
+
+/* the cached results go too, they belong to the other texts */
+void TrackSearchIndex::swapWith(TrackSearchIndex& other) noexcept
+{
+	texts.swap(other.texts);
+	offsets.swap(other.offsets);
+	grams.swap(other.grams);
+	lastQuery.swap(other.lastQuery);
+	results.swap(other.results);
+	std::swap(resultsValid, other.resultsValid);
+}
+
+/* returns the tracks containing query, refining the last results when the user has only typed more */
+const std::vector<int>& TrackSearchIndex::search(const String& query)
+{
+	const std::string normalised{ normalise(query.trim()) };
+
+	if (normalised.empty())
+	{
+		results.resize((size_t) getNumTracks());
+		for (int i = 0; i < getNumTracks(); ++i)
+			results[(size_t) i] = i;
+	}
+	else if (resultsValid && lastQuery.size() >= 3 && normalised.size() > lastQuery.size()
+		&& normalised.compare(0, lastQuery.size(), lastQuery) == 0)
+	{
+		// anything matching the longer query also matched the shorter one, and has the trigram just typed
+		auto it = grams.find(getGram(normalised.data() + normalised.size() - 3, 3));
+		if (it == grams.end())
+			results.clear();
+		else
+			intersectResults(results, it->second);
+		refineResults(results, normalised);
+	}
+	else
+	{
+		// up to three letters a gram's list is already the exact answer
+		searchGrams(normalised, results);
+	}
+
+	lastQuery = normalised;
+	resultsValid = true;
+	return results;
+}
+
+/* a search from scratch into results of its own, for queries made up along the way rather than typed */
+const std::vector<int>& TrackSearchIndex::lookup(const String& query)
+{
+	const std::string normalised{ normalise(query.trim()) };
+
+	if (normalised.empty())
+	{
+		lookupResults.resize((size_t) getNumTracks());
+		for (int i = 0; i < getNumTracks(); ++i)
+			lookupResults[(size_t) i] = i;
+	}
+	else
+	{
+		searchGrams(normalised, lookupResults);
+	}
+	return lookupResults;
+}
+
+//==============================================================================
+std::string TrackSearchIndex::normalise(const String& text)
+{
+	return text.toLowerCase().toStdString();
+}
+
+TrackSearchIndex::Gram TrackSearchIndex::getGram(const char* text, int length)
+{
+	Gram gram{ (Gram) length << 24 };
+	for (int i = 0; i < length; ++i)
+		gram |= (Gram) (uint8) text[i] << (8 * (2 - i));
+	return gram;
+}
+
+std::string_view TrackSearchIndex::getText(int index) const
+{
+	return std::string_view{ texts.data() + offsets[(size_t) index], offsets[(size_t) index + 1] - offsets[(size_t) index] };
+}
+
+/* gram lists are flattened into one column of grams, one of list ends and one of every list's indices */
+void TrackSearchIndex::writeTo(ColumnWriter& writer) const
+{
+	std::vector<Gram> keys;
+	std::vector<uint32> ends;
+	std::vector<int> lists;
+	keys.reserve(grams.size());
+	ends.reserve(grams.size());
+	for (auto& gram : grams)
+	{
+		keys.push_back(gram.first);
+		lists.insert(lists.end(), gram.second.begin(), gram.second.end());
+		ends.push_back((uint32) lists.size());
+	}
+
+	writer.writeText(texts);
+	writer.writeColumn(offsets);
+	writer.writeColumn(keys);
+	writer.writeColumn(ends);
+	writer.writeColumn(lists);
+}
+
+bool TrackSearchIndex::readFrom(ColumnReader& reader)
+{
+	clear();
+
+	// the lists are the bulk of the file, so they are copied straight from it into each gram
+	std::vector<Gram> keys;
+	std::vector<uint32> ends;
+	size_t numListed{ 0 };
+	const int* lists{ nullptr };
+	if (!reader.readText(texts) || !reader.readColumn(offsets) || !reader.readColumn(keys)
+		|| !reader.readColumn(ends) || (lists = reader.readSpan<int>(numListed)) == nullptr
+		|| offsets.empty() || offsets.front() != 0 || offsets.back() != texts.size()
+		|| keys.size() != ends.size() || (!ends.empty() && ends.back() != numListed))
+	{
+		clear();
+		return false;
+	}
+
+	// the texts and lists are used as indices later, so a damaged file is caught here rather than in a search
+	const int numTracks{ getNumTracks() };
+	bool ok{ std::is_sorted(offsets.begin(), offsets.end()) };
+	for (size_t i = 0; ok && i < numListed; ++i)
+		ok = isPositiveAndBelow(lists[i], numTracks);
+
+	grams.reserve(keys.size());
+	uint32 start{ 0 };
+	for (size_t i = 0; ok && i < keys.size(); ++i)
+	{
+		ok = ends[i] >= start;
+		if (ok)
+			grams[keys[i]].assign(lists + start, lists + ends[i]);
+		start = ends[i];
+	}
+
+	if (!ok)
+		clear();
+	return ok;
+}
+
+/* adds index to the list of every distinct gram in its text, indices arrive in order so the lists stay sorted */
+void TrackSearchIndex::indexGrams(int index)
+{
+	const std::string_view text{ getText(index) };
+
+	std::vector<Gram> found;
+	found.reserve(text.size() * 3);
+	for (size_t i = 0; i < text.size(); ++i)
+		for (int length = 1; length <= 3 && i + (size_t) length <= text.size(); ++length)
+			found.push_back(getGram(text.data() + i, length));
+
+	std::sort(found.begin(), found.end());
+	found.erase(std::unique(found.begin(), found.end()), found.end());
+	for (Gram gram : found)
+		grams[gram].push_back(index);
+}
+
+/* up to three letters the gram's list is the answer, longer queries intersect every trigram's list and check what is left */
+void TrackSearchIndex::searchGrams(const std::string& query, std::vector<int>& into)
+{
+	into.clear();
+	const int gramLength{ (int) jmin((size_t) 3, query.size()) };
+
+	// rarest list first, so the intersections stay small
+	std::vector<const std::vector<int>*> lists;
+	for (size_t i = 0; i + (size_t) gramLength <= query.size(); ++i)
+	{
+		auto it = grams.find(getGram(query.data() + i, gramLength));
+		if (it == grams.end())
+			return;   // no track has this gram, so none can match
+		lists.push_back(&it->second);
+	}
+	std::sort(lists.begin(), lists.end(), [](auto* a, auto* b) { return a->size() < b->size(); });
+
+	into = *lists[0];
+	for (size_t i = 1; i < lists.size() && !into.empty(); ++i)
+		intersectResults(into, *lists[i]);
+
+	// every trigram being there does not mean they are in the right order
+	if (query.size() > 3)
+		refineResults(into, query);
+}
+
+/* keeps the results that are also on list, both are sorted */
+void TrackSearchIndex::intersectResults(std::vector<int>& into, const std::vector<int>& list)
+{
+	scratch.clear();
+	std::set_intersection(into.begin(), into.end(), list.begin(), list.end(), std::back_inserter(scratch));
+	into.swap(scratch);
+}
+
+/* drops results that do not contain the whole query, in place */
+void TrackSearchIndex::refineResults(std::vector<int>& into, const std::string& query)
+{
+	into.erase(std::remove_if(into.begin(), into.end(),
+		[this, &query](int index) { return getText(index).find(query) == std::string_view::npos; }), into.end());
+}
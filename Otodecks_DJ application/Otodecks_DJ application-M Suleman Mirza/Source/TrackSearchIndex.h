@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+	TrackSearchIndex.h
+	Created: 18th October 2026 - 02:30 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Track.h"
+#include "ColumnStream.h"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+//==============================================================================
+/* substring search over the playlist's titles and tags.
+   every track's text is lowercased once when it is added and its distinct one, two and three
+   letter grams are indexed, so short queries are answered straight from a gram's list and longer
+   ones only check the tracks on every one of their trigrams' lists. a query that extends the
+   previous one only re-checks the previous results that have its last trigram. results are indices into the playlist, never copies */
+
+class TrackSearchIndex
+{
+public:
+	TrackSearchIndex();
+
+	// kept in step with the playlist, index n is the playlist's track n
+	void addTrack(const Track& track);
+	void removeTrack(int index);
+	void clear();
+	int getNumTracks() const;
+	void swapWith(TrackSearchIndex& other) noexcept;
+
+	// returns the matching track indices in playlist order, an empty query matches every track
+	const std::vector<int>& search(const juce::String& query);
+
+	// the same answer without replacing the previous query, so the next search can still refine that
+	const std::vector<int>& lookup(const juce::String& query);
+
+	// the lowercased title and tags of track index
+	std::string_view getText(int index) const;
+
+	// the texts and every gram list, so a saved library is searchable without indexing it again
+	void writeTo(ColumnWriter& writer) const;
+	bool readFrom(ColumnReader& reader);
+
+private:
+	// up to three bytes of text plus the gram's length in the top byte
+	using Gram = juce::uint32;
+
+	static std::string normalise(const juce::String& text);
+	static Gram getGram(const char* text, int length);
+	void indexGrams(int index);
+	void searchGrams(const std::string& query, std::vector<int>& into);
+	void intersectResults(std::vector<int>& into, const std::vector<int>& list);
+	void refineResults(std::vector<int>& into, const std::string& query);
+
+	// every track's lowercased title and tags back to back, track n starts at offsets[n]
+	std::string texts;
+	std::vector<juce::uint32> offsets{ 0 };
+	std::unordered_map<Gram, std::vector<int>> grams;   // sorted track indices containing each gram
+
+	// the previous query and its results, refined when the next query extends it
+	std::string lastQuery;
+	std::vector<int> results;
+	std::vector<int> scratch;
+	bool resultsValid{ false };
+
+	std::vector<int> lookupResults;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrackSearchIndex)
+};
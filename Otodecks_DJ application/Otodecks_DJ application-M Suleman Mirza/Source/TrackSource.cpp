@@ -0,0 +1,249 @@
+/*
+  ==============================================================================
+
+	TrackSource.cpp
+	Created: 17th October 2026 - 11:55 AM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#include "TrackSource.h"
+using namespace juce;
+
+//==============================================================================
+/* positionable source that lets the GUI swap in a newly loaded track without locking the audio thread */
+
+TrackSource::TrackSource()
+{
+	startTimer(1000);
+}
+
+TrackSource::~TrackSource()
+{
+	stopTimer();
+}
+
+void TrackSource::prepareToPlay(int samplesPerBlockExpected, double newSampleRate)
+{
+	blockSize = samplesPerBlockExpected;
+	sampleRate = newSampleRate;
+
+	// the device is stopped here, so the current track can be re-prepared for the new block size
+	if (auto* track = activeTrack.load())
+		track->getPlaybackSource()->prepareToPlay(blockSize, sampleRate);
+
+	prepared = true;
+}
+
+void TrackSource::releaseResources()
+{
+	prepared = false;
+}
+
+/* picks up the desired track, applies pending seeks and reads the next block from it, from a cue's audio first after a jump */
+void TrackSource::getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill)
+{
+	// publish which track we are about to read before touching it, then check it is still wanted
+	LoadedTrack* track = desiredTrack.load();
+	activeTrack.store(track);
+	while (desiredTrack.load() != track)
+	{
+		track = desiredTrack.load();
+		activeTrack.store(track);
+	}
+
+	if (track == nullptr)
+	{
+		bufferToFill.clearActiveBufferRegion();
+		return;
+	}
+
+	auto* source = track->getPlaybackSource();
+	const int64 seekTo{ requestedPosition.exchange(-1) };
+	if (seekTo >= 0)
+	{
+		source->setNextReadPosition(seekTo);
+		stopCueAudio();
+	}
+
+	// a jump asked for just as another track was loaded is dropped
+	if (playingCue != nullptr && playingCue->track != track)
+		stopCueAudio();
+
+	// the source is sent on to where the cue's audio ends, so it has that long to be buffered
+	if (playingCue != nullptr && cueStarted)
+	{
+		source->setNextReadPosition(playingCue->position + playingCue->buffer.getNumSamples());
+		cueStarted = false;
+	}
+
+	track->setLooping(looping.load());
+
+	const int fromCue{ playingCue != nullptr ? readCueAudio(bufferToFill) : 0 };
+	if (fromCue < bufferToFill.numSamples)
+	{
+		const AudioSourceChannelInfo rest{ bufferToFill.buffer, bufferToFill.startSample + fromCue, bufferToFill.numSamples - fromCue };
+
+		// a zero timeout only checks the buffered range, it never blocks the callback
+		if (track->bufferedSource != nullptr && !track->bufferedSource->waitForNextAudioBlockReady(rest, 0))
+			++underruns;
+
+		source->getNextAudioBlock(rest);
+	}
+	position.store(playingCue != nullptr ? playingCue->position + cueReadPosition : source->getNextReadPosition());
+}
+
+/* copies the next of the cue's audio into the block, returns how many samples it had left to give */
+int TrackSource::readCueAudio(const AudioSourceChannelInfo& bufferToFill)
+{
+	const auto& audio = playingCue->buffer;
+	const int numSamples{ jmin(bufferToFill.numSamples, audio.getNumSamples() - cueReadPosition) };
+	for (int ch = 0; ch < bufferToFill.buffer->getNumChannels(); ++ch)
+	{
+		if (ch < audio.getNumChannels())
+			bufferToFill.buffer->copyFrom(ch, bufferToFill.startSample, audio, ch, cueReadPosition, numSamples);
+		else
+			bufferToFill.buffer->clear(ch, bufferToFill.startSample, numSamples);
+	}
+
+	cueReadPosition += numSamples;
+	if (cueReadPosition >= audio.getNumSamples())
+		stopCueAudio();
+	return numSamples;
+}
+
+/* audio thread, the message thread can release the cue from here on */
+void TrackSource::stopCueAudio()
+{
+	playingCue = nullptr;
+	cueStarted = false;
+	activeCue.store(nullptr);
+}
+
+/* publishes the cue before using it and checks it is still the one asked for, as getNextAudioBlock does the track.
+   the stretcher and resampler in front of the deck are flushed by the player when this returns true */
+bool TrackSource::applyPendingJump()
+{
+	const uint32 jumps{ requestedJumps.load() };
+	if (jumps == appliedJumps)
+		return false;
+	appliedJumps = jumps;
+
+	CueAudio* cue = requestedCue.load();
+	activeCue.store(cue);
+	while (requestedCue.load() != cue)
+	{
+		cue = requestedCue.load();
+		activeCue.store(cue);
+	}
+
+	playingCue = cue;
+	cueStarted = cue != nullptr;
+	cueReadPosition = 0;
+	return true;
+}
+
+/* seeks are applied by the audio thread at the start of the next block, a jump not yet taken up is cancelled */
+void TrackSource::setNextReadPosition(int64 newPosition)
+{
+	requestedCue.store(nullptr);
+	requestedPosition.store(jmax((int64) 0, newPosition));
+	position.store(newPosition);
+}
+
+int64 TrackSource::getNextReadPosition() const
+{
+	return position.load();
+}
+
+int64 TrackSource::getTotalLength() const
+{
+	return totalLength.load();
+}
+
+bool TrackSource::isLooping() const
+{
+	return looping.load();
+}
+
+void TrackSource::setLooping(bool shouldLoop)
+{
+	looping.store(shouldLoop);
+}
+
+//==============================================================================
+/* hands a new track to the audio thread, the previous one is released later on the message thread */
+void TrackSource::setTrack(LoadedTrack::Ptr newTrack)
+{
+	if (newTrack != nullptr)
+		heldTracks.add(newTrack);
+
+	totalLength.store(newTrack != nullptr ? newTrack->lengthInSamples : 0);
+	setNextReadPosition(0);
+	desiredTrack.store(newTrack.get());
+
+	// nothing is reading while the device is stopped, so the swap can happen right away
+	if (!prepared.load())
+		activeTrack.store(newTrack.get());
+
+	releaseRetiredTracks();
+}
+
+/* the jump is taken at the start of the next block the deck renders, to the sample */
+void TrackSource::jumpTo(CueAudio::Ptr cue)
+{
+	heldCues.add(cue);
+	requestedPosition.store(-1);
+	requestedCue.store(cue.get());
+	position.store(cue->position);
+	++requestedJumps;
+
+	releaseRetiredTracks();
+}
+
+/* returns the track most recently handed to setTrack() */
+LoadedTrack* TrackSource::getTrack() const
+{
+	return desiredTrack.load();
+}
+
+LoadedTrack* TrackSource::getActiveTrack() const
+{
+	return activeTrack.load();
+}
+
+/* returns the number of blocks played before the read-ahead buffer was ready */
+int TrackSource::getUnderrunCount() const
+{
+	return underruns.load();
+}
+
+/* returns the block size the device last prepared with */
+int TrackSource::getBlockSize() const
+{
+	return blockSize;
+}
+
+void TrackSource::timerCallback()
+{
+	releaseRetiredTracks();
+}
+
+/* drops our reference to any track or cue the audio thread can no longer be reading */
+void TrackSource::releaseRetiredTracks()
+{
+	for (int i = heldTracks.size(); --i >= 0;)
+	{
+		auto* track = heldTracks.getUnchecked(i);
+		if (track != desiredTrack.load() && track != activeTrack.load())
+			heldTracks.remove(i);
+	}
+
+	for (int i = heldCues.size(); --i >= 0;)
+	{
+		auto* cue = heldCues.getUnchecked(i);
+		if (cue != requestedCue.load() && cue != activeCue.load())
+			heldCues.remove(i);
+	}
+}
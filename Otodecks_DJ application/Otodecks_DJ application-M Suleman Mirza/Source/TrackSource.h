@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+	TrackSource.h
+	Created: 17th October 2026 - 11:20 AM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "TrackLoader.h"
+#include <atomic>
+
+//==============================================================================
+/* positionable source that lets the GUI swap in a newly loaded track without locking the audio thread.
+   hot cue jumps are handed over the same way and play from the cue's decoded audio while the track's
+   read-ahead buffer refills from where that audio ends */
+
+class TrackSource : public juce::PositionableAudioSource,
+					private juce::Timer
+{
+public:
+	TrackSource();
+	~TrackSource() override;
+
+	// implement PositionableAudioSource
+	void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+	void releaseResources() override;
+	void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+	void setNextReadPosition(juce::int64 newPosition) override;
+	juce::int64 getNextReadPosition() const override;
+	juce::int64 getTotalLength() const override;
+	bool isLooping() const override;
+	void setLooping(bool shouldLoop) override;
+
+	// message thread only
+	void setTrack(LoadedTrack::Ptr newTrack);
+	void jumpTo(CueAudio::Ptr cue);
+	LoadedTrack* getTrack() const;
+	int getUnderrunCount() const;
+	int getBlockSize() const;
+
+	// audio thread only, the track the last block was read from. it stays alive until the next block
+	LoadedTrack* getActiveTrack() const;
+
+	// audio thread only, takes up the last jump asked for before the next block is read. true if there was one
+	bool applyPendingJump();
+
+private:
+	// implement Timer to release tracks the audio thread has finished with
+	void timerCallback() override;
+	void releaseRetiredTracks();
+	int readCueAudio(const juce::AudioSourceChannelInfo& bufferToFill);
+	void stopCueAudio();
+
+	// the track the GUI wants playing, and the one the audio thread is reading from.
+	// tracks are only ever deleted on the message thread once neither pointer refers to them
+	std::atomic<LoadedTrack*> desiredTrack{ nullptr };
+	std::atomic<LoadedTrack*> activeTrack{ nullptr };
+	juce::ReferenceCountedArray<LoadedTrack> heldTracks;
+
+	// the cue the GUI last jumped to and the one the audio thread is playing, released like the tracks.
+	// each jump bumps the count so jumping to the same cue again is seen
+	std::atomic<CueAudio*> requestedCue{ nullptr };
+	std::atomic<CueAudio*> activeCue{ nullptr };
+	std::atomic<juce::uint32> requestedJumps{ 0 };
+	juce::ReferenceCountedArray<CueAudio> heldCues;
+
+	// audio thread only
+	juce::uint32 appliedJumps{ 0 };
+	CueAudio* playingCue{ nullptr };
+	bool cueStarted{ false };
+	int cueReadPosition{ 0 };
+
+	std::atomic<juce::int64> requestedPosition{ -1 };
+	std::atomic<juce::int64> position{ 0 };
+	std::atomic<juce::int64> totalLength{ 0 };
+	std::atomic<bool> looping{ false };
+	std::atomic<bool> prepared{ false };
+
+	// blocks where the read-ahead buffer had not caught up with playback
+	std::atomic<int> underruns{ 0 };
+	int blockSize{ 512 };
+	double sampleRate{ 44100.0 };
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrackSource)
+};
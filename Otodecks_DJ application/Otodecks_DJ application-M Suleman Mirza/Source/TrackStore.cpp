@@ -0,0 +1,515 @@
+/*
+  ==============================================================================
+
+	TrackStore.cpp
+	Created: 18th October 2026 - 09:30 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#include "TrackStore.h"
+#include <algorithm>
+using namespace juce;
+
+//==============================================================================
+/* interns a string, returning the id it already had if it has been seen before */
+uint32 TrackStore::StringPool::intern(const String& text)
+{
+	auto it = ids.find(text);
+	if (it != ids.end())
+		return it->second;
+
+	const uint32 id{ (uint32) strings.size() };
+	strings.add(text);
+	ids.emplace(text, id);
+	return id;
+}
+
+const String& TrackStore::StringPool::get(uint32 id) const
+{
+	return strings[(int) id];
+}
+
+uint32 TrackStore::StringPool::size() const
+{
+	return (uint32) strings.size();
+}
+
+void TrackStore::StringPool::clear()
+{
+	strings.clear();
+	ids.clear();
+}
+
+void TrackStore::StringPool::swapWith(StringPool& other) noexcept
+{
+	strings.swapWith(other.strings);
+	ids.swap(other.ids);
+}
+
+size_t TrackStore::StringPool::getMemoryUsage() const
+{
+	size_t bytes{ ids.size() * (sizeof(String) + sizeof(uint32) + sizeof(void*) * 2) };
+	for (auto& text : strings)
+		bytes += sizeof(String) + text.getNumBytesAsUTF8() + 1;
+	return bytes;
+}
+
+/* the strings back to back with their offsets, like the store's file names */
+void TrackStore::StringPool::writeTo(ColumnWriter& writer) const
+{
+	std::string text;
+	std::vector<uint32> offsets{ 0 };
+	for (auto& string : strings)
+	{
+		text += string.toStdString();
+		offsets.push_back((uint32) text.size());
+	}
+	writer.writeText(text);
+	writer.writeColumn(offsets);
+}
+
+bool TrackStore::StringPool::readFrom(ColumnReader& reader)
+{
+	std::string text;
+	std::vector<uint32> offsets;
+	if (!reader.readText(text) || !reader.readColumn(offsets) || offsets.empty() || offsets.back() != text.size())
+		return false;
+
+	clear();
+	for (size_t i = 0; i + 1 < offsets.size(); ++i)
+	{
+		if (offsets[i] > offsets[i + 1])
+			return false;
+		intern(String::fromUTF8(text.data() + offsets[i], (int) (offsets[i + 1] - offsets[i])));
+	}
+	return true;
+}
+
+//==============================================================================
+/* the playlist's tracks stored column by column */
+
+TrackStore::TrackStore()
+{
+	clear();
+}
+
+/* splits the path into interned folder and extension and a file name, and appends the columns */
+int TrackStore::add(const Track& track)
+{
+	const String fullPath{ track.file.getFullPathName() };
+	const String folder{ fullPath.upToLastOccurrenceOf(File::getSeparatorString(), true, false) };
+	const String name{ fullPath.substring(folder.length(), fullPath.length() - track.fileExtension.length()) };
+
+	names += name.toStdString();
+	nameOffsets.push_back((uint32) names.size());
+
+	const TrackId id{ (TrackId) indexOfId.size() };
+	indexOfId.push_back(size());
+	ids.push_back(id);
+
+	folderIds.push_back(folders.intern(folder));
+	extensionIds.push_back((uint16) extensions.intern(track.fileExtension));
+	keyIds.push_back((uint16) keys.intern(track.key));
+	lengths.push_back((float) track.lengthInSeconds);
+	sampleRates.push_back((float) track.sampleRate);
+	bpms.push_back((float) track.bpm);
+	firstBeats.push_back((float) track.firstBeat);
+	loudnesses.push_back((float) track.loudness);
+	truePeaks.push_back((float) track.truePeak);
+	analysed.push_back(track.analysed);
+	pathHashes.push_back(hashPath(track.path));
+	fingerprints.push_back(parseFingerprint(track.fingerprint));
+	hotCueIds.push_back(0);
+	fileStatuses.push_back(unchecked);
+
+	return size() - 1;
+}
+
+/* removes every column's entry, the tracks after it move down one index but keep their ids */
+void TrackStore::remove(int index)
+{
+	if (!isPositiveAndBelow(index, size()))
+		return;
+
+	const size_t i{ (size_t) index };
+	const uint32 length{ nameOffsets[i + 1] - nameOffsets[i] };
+	names.erase(nameOffsets[i], length);
+	nameOffsets.erase(nameOffsets.begin() + index + 1);
+	for (size_t n = i + 1; n < nameOffsets.size(); ++n)
+		nameOffsets[n] -= length;
+
+	releaseHotCues(index);
+
+	indexOfId[ids[i]] = -1;
+	for (size_t n = i + 1; n < ids.size(); ++n)
+		--indexOfId[ids[n]];
+
+	ids.erase(ids.begin() + index);
+	folderIds.erase(folderIds.begin() + index);
+	extensionIds.erase(extensionIds.begin() + index);
+	keyIds.erase(keyIds.begin() + index);
+	lengths.erase(lengths.begin() + index);
+	sampleRates.erase(sampleRates.begin() + index);
+	bpms.erase(bpms.begin() + index);
+	firstBeats.erase(firstBeats.begin() + index);
+	loudnesses.erase(loudnesses.begin() + index);
+	truePeaks.erase(truePeaks.begin() + index);
+	analysed.erase(analysed.begin() + index);
+	pathHashes.erase(pathHashes.begin() + index);
+	fingerprints.erase(fingerprints.begin() + index);
+	hotCueIds.erase(hotCueIds.begin() + index);
+	fileStatuses.erase(fileStatuses.begin() + index);
+}
+
+void TrackStore::clear()
+{
+	folders.clear();
+	extensions.clear();
+	keys.clear();
+	keys.intern({});   // id 0 is "no key yet"
+
+	names.clear();
+	nameOffsets.assign(1, 0);
+	ids.clear();
+	folderIds.clear();
+	extensionIds.clear();
+	keyIds.clear();
+	lengths.clear();
+	sampleRates.clear();
+	bpms.clear();
+	firstBeats.clear();
+	loudnesses.clear();
+	truePeaks.clear();
+	analysed.clear();
+	pathHashes.clear();
+	fingerprints.clear();
+	hotCueIds.clear();
+	hotCueSets.assign(1, HotCues{});
+	fileStatuses.clear();
+	indexOfId.clear();
+}
+
+void TrackStore::swapWith(TrackStore& other) noexcept
+{
+	folders.swapWith(other.folders);
+	extensions.swapWith(other.extensions);
+	keys.swapWith(other.keys);
+
+	names.swap(other.names);
+	nameOffsets.swap(other.nameOffsets);
+	ids.swap(other.ids);
+	folderIds.swap(other.folderIds);
+	extensionIds.swap(other.extensionIds);
+	keyIds.swap(other.keyIds);
+	lengths.swap(other.lengths);
+	sampleRates.swap(other.sampleRates);
+	bpms.swap(other.bpms);
+	firstBeats.swap(other.firstBeats);
+	loudnesses.swap(other.loudnesses);
+	truePeaks.swap(other.truePeaks);
+	analysed.swap(other.analysed);
+	pathHashes.swap(other.pathHashes);
+	fingerprints.swap(other.fingerprints);
+	hotCueIds.swap(other.hotCueIds);
+	hotCueSets.swap(other.hotCueSets);
+	fileStatuses.swap(other.fileStatuses);
+	indexOfId.swap(other.indexOfId);
+}
+
+int TrackStore::size() const
+{
+	return (int) ids.size();
+}
+
+TrackStore::TrackId TrackStore::getId(int index) const
+{
+	return isPositiveAndBelow(index, size()) ? ids[(size_t) index] : invalidId;
+}
+
+int TrackStore::getIndexOf(TrackId id) const
+{
+	return id < indexOfId.size() ? indexOfId[id] : -1;
+}
+
+//==============================================================================
+/* the title is the file name trimmed, as Track builds it */
+String TrackStore::getTitle(int index) const
+{
+	const std::string_view name{ getName(index) };
+	return String::fromUTF8(name.data(), (int) name.size()).trim();
+}
+
+std::string_view TrackStore::getName(int index) const
+{
+	const size_t i{ (size_t) index };
+	return std::string_view{ names }.substr(nameOffsets[i], nameOffsets[i + 1] - nameOffsets[i]);
+}
+
+String TrackStore::getPath(int index) const
+{
+	const std::string_view name{ getName(index) };
+	return folders.get(folderIds[(size_t) index]) + String::fromUTF8(name.data(), (int) name.size())
+		+ getExtension(index);
+}
+
+File TrackStore::getFile(int index) const
+{
+	return File{ getPath(index) };
+}
+
+const String& TrackStore::getExtension(int index) const
+{
+	return extensions.get(extensionIds[(size_t) index]);
+}
+
+const String& TrackStore::getKey(int index) const
+{
+	return keys.get(keyIds[(size_t) index]);
+}
+
+double TrackStore::getLengthInSeconds(int index) const
+{
+	return lengths[(size_t) index];
+}
+
+double TrackStore::getSampleRate(int index) const
+{
+	return sampleRates[(size_t) index];
+}
+
+double TrackStore::getBpm(int index) const
+{
+	return bpms[(size_t) index];
+}
+
+double TrackStore::getFirstBeat(int index) const
+{
+	return firstBeats[(size_t) index];
+}
+
+double TrackStore::getLoudness(int index) const
+{
+	return loudnesses[(size_t) index];
+}
+
+double TrackStore::getTruePeak(int index) const
+{
+	return truePeaks[(size_t) index];
+}
+
+uint8 TrackStore::getAnalysed(int index) const
+{
+	return analysed[(size_t) index];
+}
+
+uint64 TrackStore::getPathHash(int index) const
+{
+	return pathHashes[(size_t) index];
+}
+
+uint64 TrackStore::getFingerprint(int index) const
+{
+	return fingerprints[(size_t) index];
+}
+
+void TrackStore::setBeatGrid(int index, double bpm, double firstBeat)
+{
+	if (!isPositiveAndBelow(index, size()))
+		return;
+
+	bpms[(size_t) index] = (float) bpm;
+	firstBeats[(size_t) index] = (float) firstBeat;
+}
+
+void TrackStore::setKey(int index, const String& key)
+{
+	if (isPositiveAndBelow(index, size()))
+		keyIds[(size_t) index] = (uint16) keys.intern(key);
+}
+
+void TrackStore::setLoudness(int index, double loudness, double truePeak)
+{
+	if (!isPositiveAndBelow(index, size()))
+		return;
+
+	loudnesses[(size_t) index] = (float) loudness;
+	truePeaks[(size_t) index] = (float) truePeak;
+}
+
+void TrackStore::setAnalysed(int index, uint8 measurements)
+{
+	if (isPositiveAndBelow(index, size()))
+		analysed[(size_t) index] = measurements;
+}
+
+void TrackStore::setAudioDetails(int index, double lengthInSeconds, double sampleRate)
+{
+	if (!isPositiveAndBelow(index, size()))
+		return;
+
+	lengths[(size_t) index] = (float) lengthInSeconds;
+	sampleRates[(size_t) index] = (float) sampleRate;
+}
+
+const HotCues& TrackStore::getHotCues(int index) const
+{
+	return hotCueSets[hotCueIds[(size_t) index]];
+}
+
+/* a track's first cue gives it a set of its own, clearing its last one hands the set back */
+void TrackStore::setHotCues(int index, const HotCues& hotCues)
+{
+	if (!isPositiveAndBelow(index, size()))
+		return;
+
+	if (hotCues.isEmpty())
+	{
+		releaseHotCues(index);
+		return;
+	}
+
+	uint32& id{ hotCueIds[(size_t) index] };
+	if (id == 0)
+	{
+		id = (uint32) hotCueSets.size();
+		hotCueSets.push_back(hotCues);
+	}
+	else
+	{
+		hotCueSets[id] = hotCues;
+	}
+}
+
+/* the last set moves into the freed one's place so the sets stay packed */
+void TrackStore::releaseHotCues(int index)
+{
+	const uint32 id{ hotCueIds[(size_t) index] };
+	if (id == 0)
+		return;
+
+	hotCueIds[(size_t) index] = 0;
+	const uint32 last{ (uint32) hotCueSets.size() - 1 };
+	if (id != last)
+	{
+		hotCueSets[id] = hotCueSets[last];
+		*std::find(hotCueIds.begin(), hotCueIds.end(), last) = id;
+	}
+	hotCueSets.pop_back();
+}
+
+TrackStore::FileStatus TrackStore::getFileStatus(int index) const
+{
+	return fileStatuses[(size_t) index];
+}
+
+void TrackStore::setFileStatus(int index, FileStatus status)
+{
+	if (isPositiveAndBelow(index, size()))
+		fileStatuses[(size_t) index] = status;
+}
+
+const std::vector<float>& TrackStore::getLengths() const
+{
+	return lengths;
+}
+
+const std::vector<float>& TrackStore::getBpms() const
+{
+	return bpms;
+}
+
+size_t TrackStore::getMemoryUsage() const
+{
+	return names.capacity()
+		+ nameOffsets.capacity() * sizeof(uint32)
+		+ ids.capacity() * sizeof(TrackId)
+		+ folderIds.capacity() * sizeof(uint32)
+		+ (extensionIds.capacity() + keyIds.capacity()) * sizeof(uint16)
+		+ (lengths.capacity() + sampleRates.capacity() + bpms.capacity() + firstBeats.capacity()
+		   + loudnesses.capacity() + truePeaks.capacity()) * sizeof(float)
+		+ analysed.capacity()
+		+ (pathHashes.capacity() + fingerprints.capacity()) * sizeof(uint64)
+		+ hotCueIds.capacity() * sizeof(uint32) + hotCueSets.capacity() * sizeof(HotCues)
+		+ fileStatuses.capacity() * sizeof(FileStatus)
+		+ indexOfId.capacity() * sizeof(int)
+		+ folders.getMemoryUsage() + extensions.getMemoryUsage() + keys.getMemoryUsage();
+}
+
+//==============================================================================
+/* the pools, the name buffer and every column, in the order readFrom() expects */
+void TrackStore::writeTo(ColumnWriter& writer) const
+{
+	folders.writeTo(writer);
+	extensions.writeTo(writer);
+	keys.writeTo(writer);
+
+	writer.writeText(names);
+	writer.writeColumn(nameOffsets);
+	writer.writeColumn(ids);
+	writer.writeColumn(folderIds);
+	writer.writeColumn(extensionIds);
+	writer.writeColumn(keyIds);
+	writer.writeColumn(lengths);
+	writer.writeColumn(sampleRates);
+	writer.writeColumn(bpms);
+	writer.writeColumn(firstBeats);
+	writer.writeColumn(loudnesses);
+	writer.writeColumn(truePeaks);
+	writer.writeColumn(analysed);
+	writer.writeColumn(pathHashes);
+	writer.writeColumn(fingerprints);
+	writer.writeColumn(hotCueIds);
+	writer.writeColumn(hotCueSets);
+	writer.writeColumn(indexOfId);
+}
+
+/* copies each column straight out of the reader, then checks they all agree before trusting them */
+bool TrackStore::readFrom(ColumnReader& reader)
+{
+	bool ok{ folders.readFrom(reader) && extensions.readFrom(reader) && keys.readFrom(reader) };
+	ok = ok && reader.readText(names) && reader.readColumn(nameOffsets) && reader.readColumn(ids)
+		&& reader.readColumn(folderIds) && reader.readColumn(extensionIds) && reader.readColumn(keyIds)
+		&& reader.readColumn(lengths) && reader.readColumn(sampleRates) && reader.readColumn(bpms)
+		&& reader.readColumn(firstBeats) && reader.readColumn(loudnesses) && reader.readColumn(truePeaks)
+		&& reader.readColumn(analysed) && reader.readColumn(pathHashes) && reader.readColumn(fingerprints)
+		&& reader.readColumn(hotCueIds) && reader.readColumn(hotCueSets) && reader.readColumn(indexOfId);
+
+	const size_t numTracks{ ids.size() };
+	ok = ok && nameOffsets.size() == numTracks + 1 && nameOffsets.front() == 0 && nameOffsets.back() == names.size()
+		&& folderIds.size() == numTracks && extensionIds.size() == numTracks && keyIds.size() == numTracks
+		&& lengths.size() == numTracks && sampleRates.size() == numTracks && bpms.size() == numTracks
+		&& firstBeats.size() == numTracks && loudnesses.size() == numTracks && truePeaks.size() == numTracks
+		&& analysed.size() == numTracks
+		&& pathHashes.size() == numTracks && fingerprints.size() == numTracks
+		&& hotCueIds.size() == numTracks && !hotCueSets.empty();
+
+	// ids and pool references index other columns, so a damaged file must not get past here
+	for (size_t i = 0; ok && i < numTracks; ++i)
+		ok = ids[i] < indexOfId.size() && indexOfId[ids[i]] == (int) i && nameOffsets[i] <= nameOffsets[i + 1]
+			&& folderIds[i] < folders.size() && extensionIds[i] < extensions.size() && keyIds[i] < keys.size()
+			&& hotCueIds[i] < hotCueSets.size();
+
+	if (!ok)
+		clear();
+	else
+		fileStatuses.assign(numTracks, unchecked);
+	return ok;
+}
+
+//==============================================================================
+/* 64 bit FNV-1a of the canonical path, two different files colliding is vanishingly unlikely even in a huge library */
+uint64 TrackStore::hashPath(const String& canonicalPath)
+{
+	uint64 hash{ 14695981039346656037ull };
+	for (auto* bytes = canonicalPath.toRawUTF8(); *bytes != 0; ++bytes)
+		hash = (hash ^ (uint8) *bytes) * 1099511628211ull;
+	return hash;
+}
+
+/* fingerprints are written in hex by TrackMetadataIndex */
+uint64 TrackStore::parseFingerprint(const String& fingerprint)
+{
+	return fingerprint.isEmpty() ? 0 : (uint64) fingerprint.getHexValue64();
+}
@@ -0,0 +1,150 @@
+/*
+  ==============================================================================
+
+	TrackStore.h
+	Created: 18th October 2026 - 09:10 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Track.h"
+#include "ColumnStream.h"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+//==============================================================================
+/* the playlist's tracks stored column by column instead of as Track objects.
+   folders, extensions and keys are interned so a track only holds a small id for each, file names
+   sit back to back in one buffer, and lengths, sample rates, tempos, beat grids and loudness are plain
+   numbers that are only formatted when a row is drawn. a track costs around seventy bytes plus its file name.
+   most tracks never get hot cues, so only those that have some take a set of them, the rest share set 0.
+
+   tracks are addressed by index like the rest of the playlist, and also carry a 32 bit id that
+   stays the same while the track is in the library however the tracks around it move */
+
+class TrackStore
+{
+public:
+	using TrackId = juce::uint32;
+	static constexpr TrackId invalidId{ 0xffffffff };
+
+	// whether a track's file was there this run, only checked once its row is drawn
+	enum FileStatus : juce::uint8
+	{
+		unchecked,
+		checking,
+		present,
+		missing
+	};
+
+	TrackStore();
+
+	// appends the track and returns its index
+	int add(const Track& track);
+	void remove(int index);
+	void clear();
+	int size() const;
+
+	// exchanges every column with other, for a store filled on another thread
+	void swapWith(TrackStore& other) noexcept;
+
+	TrackId getId(int index) const;
+	int getIndexOf(TrackId id) const;   // -1 once the track has been removed
+
+	juce::String getTitle(int index) const;
+	std::string_view getName(int index) const;   // the file name without extension, UTF-8
+	juce::String getPath(int index) const;
+	juce::File getFile(int index) const;
+	const juce::String& getExtension(int index) const;
+	const juce::String& getKey(int index) const;
+	double getLengthInSeconds(int index) const;
+	double getSampleRate(int index) const;
+	double getBpm(int index) const;
+	double getFirstBeat(int index) const;
+	double getLoudness(int index) const;   // LUFS
+	double getTruePeak(int index) const;   // dBTP
+	juce::uint8 getAnalysed(int index) const;   // TrackAnalysis::Measurements taken so far
+
+	// duplicate checks compare these instead of keeping every path twice
+	juce::uint64 getPathHash(int index) const;
+	juce::uint64 getFingerprint(int index) const;   // zero if the file was not fingerprinted
+
+	// filled in once a track has been analysed
+	void setBeatGrid(int index, double bpm, double firstBeat);
+	void setKey(int index, const juce::String& key);
+	void setLoudness(int index, double loudness, double truePeak);
+	void setAnalysed(int index, juce::uint8 measurements);
+
+	// set on a deck and written back by the playlist
+	const HotCues& getHotCues(int index) const;
+	void setHotCues(int index, const HotCues& hotCues);
+
+	// filled in later for tracks added before their file was probed
+	void setAudioDetails(int index, double lengthInSeconds, double sampleRate);
+
+	FileStatus getFileStatus(int index) const;
+	void setFileStatus(int index, FileStatus status);
+
+	// whole columns, for filters that look at every track
+	const std::vector<float>& getLengths() const;
+	const std::vector<float>& getBpms() const;
+
+	// bytes held by the store, for the benchmarks
+	size_t getMemoryUsage() const;
+
+	// every column as it is in memory, see LibrarySession. a failed read leaves the store empty
+	void writeTo(ColumnWriter& writer) const;
+	bool readFrom(ColumnReader& reader);
+
+	static juce::uint64 hashPath(const juce::String& canonicalPath);
+	static juce::uint64 parseFingerprint(const juce::String& fingerprint);
+
+private:
+	// each distinct string once, tracks refer to it by its position
+	class StringPool
+	{
+	public:
+		juce::uint32 intern(const juce::String& text);
+		const juce::String& get(juce::uint32 id) const;
+		void clear();
+		size_t getMemoryUsage() const;
+		void writeTo(ColumnWriter& writer) const;
+		bool readFrom(ColumnReader& reader);
+		juce::uint32 size() const;
+		void swapWith(StringPool& other) noexcept;
+
+	private:
+		juce::StringArray strings;
+		std::unordered_map<juce::String, juce::uint32> ids;
+	};
+
+	void releaseHotCues(int index);
+
+	StringPool folders, extensions, keys;
+
+	// file names without folder or extension back to back, track n's starts at nameOffsets[n]
+	std::string names;
+	std::vector<juce::uint32> nameOffsets{ 0 };
+
+	std::vector<TrackId> ids;
+	std::vector<juce::uint32> folderIds;
+	std::vector<juce::uint16> extensionIds, keyIds;
+	std::vector<float> lengths, sampleRates, bpms, firstBeats, loudnesses, truePeaks;
+	std::vector<juce::uint8> analysed;
+	std::vector<juce::uint64> pathHashes, fingerprints;
+
+	// track n's hot cues are hotCueSets[hotCueIds[n]], set 0 is always empty and shared by every track without any
+	std::vector<juce::uint32> hotCueIds;
+	std::vector<HotCues> hotCueSets;
+	std::vector<FileStatus> fileStatuses;   // never saved, files can come and go between runs
+
+	std::vector<int> indexOfId;   // by id, -1 for removed tracks
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrackStore)
+};
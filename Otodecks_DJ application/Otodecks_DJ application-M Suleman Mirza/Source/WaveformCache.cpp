@@ -0,0 +1,341 @@
+/*
+  ==============================================================================
+
+	WaveformCache.cpp
+	Created: 19th October 2026 - 09:55 AM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#include "WaveformCache.h"
+#include "TrackMetadataIndex.h"
+#include <cmath>
+using namespace juce;
+
+namespace
+{
+	// bumped whenever the bucket layout changes, older files are generated again
+	const int waveformMagic{ (int) ByteOrder::littleEndianInt("OTWV") };
+	const int waveformVersion{ 1 };
+	const int headerSize{ 24 };
+
+	int8 toPeak(float sample)
+	{
+		return (int8) jlimit(-127, 127, roundToInt(sample * 127.0f));
+	}
+
+	uint8 toLoudness(double rms)
+	{
+		return (uint8) jlimit(0, 255, roundToInt(rms * 255.0));
+	}
+}
+
+//==============================================================================
+/* a track's waveform summarised at several zoom levels */
+
+int WaveformPyramid::Level::size() const
+{
+	return (int) mins.size();
+}
+
+WaveformPyramid::Builder::Builder(double sampleRate, int64 lengthInSamples) :
+	pyramid{ new WaveformPyramid() }
+{
+	pyramid->sampleRate = sampleRate;
+	pyramid->lengthInSamples = lengthInSamples;
+
+	Level finest;
+	finest.samplesPerBucket = finestBucketSize;
+	const size_t numBuckets{ (size_t) (lengthInSamples / finestBucketSize + 1) };
+	finest.mins.reserve(numBuckets);
+	finest.maxs.reserve(numBuckets);
+	finest.rms.reserve(numBuckets);
+	pyramid->levels.push_back(std::move(finest));
+}
+
+/* folds the block into the finest level a bucket's worth at a time, both channels into the same bucket */
+void WaveformPyramid::Builder::addBlock(const AudioBuffer<float>& block, int startSample, int numSamples)
+{
+	const int numChannels{ jmin(block.getNumChannels(), 2) };
+	int done{ 0 };
+	while (done < numSamples)
+	{
+		const int count{ jmin(numSamples - done, finestBucketSize - bucketSamples) };
+		for (int ch = 0; ch < numChannels; ++ch)
+		{
+			const float* samples{ block.getReadPointer(ch, startSample + done) };
+			const auto range = FloatVectorOperations::findMinAndMax(samples, count);
+			bucketMin = jmin(bucketMin, range.getStart());
+			bucketMax = jmax(bucketMax, range.getEnd());
+
+			// averaged over both channels, so a mono file and its stereo copy look the same
+			double squares{ 0.0 };
+			for (int i = 0; i < count; ++i)
+				squares += samples[i] * samples[i];
+			bucketSquares += squares / numChannels;
+		}
+
+		bucketSamples += count;
+		done += count;
+		if (bucketSamples == finestBucketSize)
+			closeBucket();
+	}
+}
+
+void WaveformPyramid::Builder::closeBucket()
+{
+	auto& finest = pyramid->levels.front();
+	finest.mins.push_back(toPeak(bucketMin));
+	finest.maxs.push_back(toPeak(bucketMax));
+	finest.rms.push_back(toLoudness(std::sqrt(bucketSquares / jmax(1, bucketSamples))));
+
+	bucketMin = 0.0f;
+	bucketMax = 0.0f;
+	bucketSquares = 0.0;
+	bucketSamples = 0;
+}
+
+/* each coarser level merges levelRatio buckets of the one below, until a level is small enough to draw whole */
+WaveformPyramid::Ptr WaveformPyramid::Builder::finish()
+{
+	if (bucketSamples > 0)
+		closeBucket();
+
+	auto& levels = pyramid->levels;
+	while (levels.back().size() > minBucketsPerLevel)
+	{
+		const Level& finer = levels.back();
+		Level coarser;
+		coarser.samplesPerBucket = finer.samplesPerBucket * levelRatio;
+
+		for (int start = 0; start < finer.size(); start += levelRatio)
+		{
+			const int end{ jmin(finer.size(), start + levelRatio) };
+			int8 low{ 127 }, high{ -127 };
+			double squares{ 0.0 };
+			for (int i = start; i < end; ++i)
+			{
+				low = jmin(low, finer.mins[(size_t) i]);
+				high = jmax(high, finer.maxs[(size_t) i]);
+				squares += (double) finer.rms[(size_t) i] * finer.rms[(size_t) i];
+			}
+			coarser.mins.push_back(low);
+			coarser.maxs.push_back(high);
+			coarser.rms.push_back((uint8) jlimit(0, 255, roundToInt(std::sqrt(squares / (end - start)))));
+		}
+		levels.push_back(std::move(coarser));
+	}
+	return pyramid;
+}
+
+//==============================================================================
+const WaveformPyramid::Level& WaveformPyramid::getLevelFor(double samplesPerPixel) const
+{
+	for (size_t i = levels.size(); --i > 0;)
+		if (levels[i].samplesPerBucket <= samplesPerPixel)
+			return levels[i];
+	return levels.front();
+}
+
+/* a vertical line per pixel for the peaks, and a shorter one over it for the loudness */
+void WaveformPyramid::draw(Graphics& gfx, Rectangle<int> area, int64 startSample, int64 endSample,
+						   Colour peakColour, Colour rmsColour) const
+{
+	if (levels.empty() || area.isEmpty() || endSample <= startSample)
+		return;
+
+	const double samplesPerPixel{ (endSample - startSample) / (double) area.getWidth() };
+	const Level& level{ getLevelFor(samplesPerPixel) };
+	const float centre{ (float) area.getCentreY() };
+	const float peakScale{ area.getHeight() * 0.5f / 127.0f };
+	const float rmsScale{ area.getHeight() * 0.5f / 255.0f };
+
+	for (int x = 0; x < area.getWidth(); ++x)
+	{
+		// a zoomed view can start before the track or run past its end
+		const int64 from{ startSample + (int64) (x * samplesPerPixel) };
+		const int64 to{ startSample + (int64) ((x + 1) * samplesPerPixel) };
+		if (to <= 0)
+			continue;
+
+		const int first{ (int) (jmax((int64) 0, from) / level.samplesPerBucket) };
+		const int last{ jmin(level.size(), jmax(first + 1, (int) (to / level.samplesPerBucket))) };
+		if (first >= level.size())
+			break;
+
+		int low{ 127 }, high{ -127 }, loudness{ 0 };
+		for (int i = first; i < last; ++i)
+		{
+			low = jmin(low, (int) level.mins[(size_t) i]);
+			high = jmax(high, (int) level.maxs[(size_t) i]);
+			loudness = jmax(loudness, (int) level.rms[(size_t) i]);
+		}
+
+		gfx.setColour(peakColour);
+		gfx.drawVerticalLine(area.getX() + x, centre - high * peakScale, centre - low * peakScale + 1.0f);
+		gfx.setColour(rmsColour);
+		gfx.drawVerticalLine(area.getX() + x, centre - loudness * rmsScale, centre + loudness * rmsScale + 1.0f);
+	}
+}
+
+double WaveformPyramid::getLengthInSeconds() const
+{
+	return sampleRate > 0 ? lengthInSamples / sampleRate : 0.0;
+}
+
+size_t WaveformPyramid::getSizeInBytes() const
+{
+	size_t bytes{ sizeof(WaveformPyramid) };
+	for (auto& level : levels)
+		bytes += sizeof(Level) + (size_t) level.size() * 3;
+	return bytes;
+}
+
+/* the levels finest first, the sample rate and length are in the cache file's header */
+void WaveformPyramid::writeTo(ColumnWriter& writer) const
+{
+	writer.writeValue((uint64) levels.size());
+	for (auto& level : levels)
+	{
+		writer.writeValue((uint64) level.samplesPerBucket);
+		writer.writeColumn(level.mins);
+		writer.writeColumn(level.maxs);
+		writer.writeColumn(level.rms);
+	}
+}
+
+bool WaveformPyramid::readFrom(ColumnReader& reader)
+{
+	const uint64 numLevels{ reader.readValue() };
+	if (numLevels == 0 || numLevels > 32)
+		return false;
+
+	levels.resize((size_t) numLevels);
+	for (auto& level : levels)
+	{
+		level.samplesPerBucket = (int) reader.readValue();
+		if (level.samplesPerBucket <= 0 || !reader.readColumn(level.mins) || !reader.readColumn(level.maxs)
+			|| !reader.readColumn(level.rms) || level.maxs.size() != level.mins.size() || level.rms.size() != level.mins.size())
+		{
+			levels.clear();
+			return false;
+		}
+	}
+	return true;
+}
+
+//==============================================================================
+/* waveforms saved on disk, one file per track named after a hash of its contents */
+
+WaveformCache::WaveformCache(AudioFormatManager& _formatManager, const File& _folder) :
+	formatManager{ _formatManager },
+	folder{ _folder }
+{
+}
+
+WaveformCache::~WaveformCache()
+{
+}
+
+File WaveformCache::getDefaultFolder()
+{
+	return File::getSpecialLocation(File::userApplicationDataDirectory)
+		.getChildFile("OtoDecks")
+		.getChildFile("Waveforms");
+}
+
+/* the same fingerprint the library uses to spot copies, the size and both ends of the file */
+File WaveformCache::getCacheFile(const String& contentHash) const
+{
+	return folder.getChildFile(contentHash + ".waveform");
+}
+
+/* reads the whole file in one go, it is a few hundred KB at most */
+WaveformPyramid::Ptr WaveformCache::find(const File& file) const
+{
+	if (!file.existsAsFile())
+		return nullptr;
+
+	const String contentHash{ TrackMetadataIndex::computeFingerprint(file) };
+	MemoryBlock data;
+	if (contentHash.isEmpty() || !getCacheFile(contentHash).loadFileAsData(data) || data.getSize() < (size_t) headerSize)
+		return nullptr;
+
+	MemoryInputStream header{ data.getData(), (size_t) headerSize, false };
+	if (header.readInt() != waveformMagic || header.readInt() != waveformVersion)
+		return nullptr;
+
+	WaveformPyramid::Ptr waveform{ new WaveformPyramid() };
+	waveform->sampleRate = header.readDouble();
+	waveform->lengthInSamples = header.readInt64();
+
+	ColumnReader reader{ static_cast<const char*>(data.getData()) + headerSize, data.getSize() - headerSize };
+	if (!waveform->readFrom(reader))
+	{
+		DBG("WaveformCache::find: " << getCacheFile(contentHash).getFullPathName() << " is damaged");
+		return nullptr;
+	}
+	return waveform;
+}
+
+bool WaveformCache::contains(const File& file) const
+{
+	const String contentHash{ TrackMetadataIndex::computeFingerprint(file) };
+	return contentHash.isNotEmpty() && getCacheFile(contentHash).existsAsFile();
+}
+
+void WaveformCache::store(const File& file, WaveformPyramid::Ptr waveform)
+{
+	const String contentHash{ TrackMetadataIndex::computeFingerprint(file) };
+	if (waveform != nullptr && contentHash.isNotEmpty())
+		save(contentHash, *waveform);
+}
+
+/* written to a temporary file and renamed, two threads saving the same track just replace each other's file */
+bool WaveformCache::save(const String& contentHash, const WaveformPyramid& waveform) const
+{
+	folder.createDirectory();
+	TemporaryFile temp{ getCacheFile(contentHash) };
+	{
+		FileOutputStream out{ temp.getFile() };
+		if (!out.openedOk())
+			return false;
+
+		out.writeInt(waveformMagic);
+		out.writeInt(waveformVersion);
+		out.writeDouble(waveform.sampleRate);
+		out.writeInt64(waveform.lengthInSamples);
+
+		ColumnWriter writer{ out };
+		waveform.writeTo(writer);
+		out.flush();
+		if (out.getStatus().failed())
+			return false;
+	}
+	return temp.overwriteTargetFileWithTemporary();
+}
+
+/* decodes a block at a time into the builder, giving up if its pool job is removed or the pool shuts down */
+WaveformPyramid::Ptr WaveformCache::generate(const File& file) const
+{
+	std::unique_ptr<AudioFormatReader> reader{ formatManager.createReaderFor(file) };
+	if (reader == nullptr || reader->sampleRate <= 0)
+		return nullptr;
+
+	const int blockSize{ 65536 };
+	AudioBuffer<float> block{ jmin((int) reader->numChannels, 2), blockSize };
+	WaveformPyramid::Builder builder{ reader->sampleRate, reader->lengthInSamples };
+
+	for (int64 pos = 0; pos < reader->lengthInSamples; pos += blockSize)
+	{
+		if (auto* job = ThreadPoolJob::getCurrentThreadPoolJob())
+			if (job->shouldExit())
+				return nullptr;
+
+		const int numSamples{ (int) jmin((int64) blockSize, reader->lengthInSamples - pos) };
+		reader->read(&block, 0, numSamples, pos, true, true);
+		builder.addBlock(block, 0, numSamples);
+	}
+	return builder.finish();
+}
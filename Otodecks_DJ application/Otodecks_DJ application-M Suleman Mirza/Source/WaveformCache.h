@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+	WaveformCache.h
+	Created: 19th October 2026 - 09:20 AM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ColumnStream.h"
+#include <vector>
+
+//==============================================================================
+/* a track's waveform summarised at several zoom levels, the peaks and loudness of each bucket of samples.
+   level 0 has a bucket every 256 samples and each level after it is four times coarser, so drawing
+   any stretch of the track reads only a few buckets per pixel whatever the zoom.
+   both channels are mixed into one summary, a bucket costs three bytes */
+
+class WaveformPyramid : public juce::ReferenceCountedObject
+{
+public:
+	using Ptr = juce::ReferenceCountedObjectPtr<WaveformPyramid>;
+
+	struct Level
+	{
+		int samplesPerBucket{ 0 };
+		std::vector<juce::int8> mins, maxs;   // peaks scaled to -127..127
+		std::vector<juce::uint8> rms;         // 0..255
+
+		int size() const;
+	};
+
+	// summarises the audio a block at a time as it is decoded, then builds the coarser levels from the finest
+	class Builder
+	{
+	public:
+		Builder(double sampleRate, juce::int64 lengthInSamples);
+
+		void addBlock(const juce::AudioBuffer<float>& block, int startSample, int numSamples);
+		WaveformPyramid::Ptr finish();
+
+	private:
+		void closeBucket();
+
+		WaveformPyramid::Ptr pyramid;
+		float bucketMin{ 0.0f }, bucketMax{ 0.0f };
+		double bucketSquares{ 0.0 };
+		int bucketSamples{ 0 };
+	};
+
+	double sampleRate{ 0.0 };
+	juce::int64 lengthInSamples{ 0 };
+	std::vector<Level> levels;
+
+	// the coarsest level that still has a bucket for every samplesPerPixel samples
+	const Level& getLevelFor(double samplesPerPixel) const;
+
+	// draws samples [startSample, endSample) across area one pixel column at a time, loudness over the peaks
+	void draw(juce::Graphics& gfx, juce::Rectangle<int> area, juce::int64 startSample, juce::int64 endSample,
+			  juce::Colour peakColour, juce::Colour rmsColour) const;
+
+	double getLengthInSeconds() const;
+	size_t getSizeInBytes() const;
+
+	void writeTo(ColumnWriter& writer) const;
+	bool readFrom(ColumnReader& reader);
+
+	static constexpr int finestBucketSize{ 256 };
+	static constexpr int levelRatio{ 4 };
+	static constexpr int minBucketsPerLevel{ 256 };   // no level coarser than this is built
+};
+
+//==============================================================================
+/* waveforms saved on disk, one file per track named after a hash of its contents, so a renamed or
+   copied file finds its waveform and an edited one gets a new one.
+   the track analyser builds waveforms while it decodes newly imported tracks, and the track loader
+   saves any it had to build itself, so a track loaded onto a deck usually has its whole waveform
+   ready without decoding it first */
+
+class WaveformCache
+{
+public:
+	WaveformCache(juce::AudioFormatManager& _formatManager, const juce::File& _folder = getDefaultFolder());
+	~WaveformCache();
+
+	// any thread. the saved waveform for the file's contents, nullptr if there is none yet
+	WaveformPyramid::Ptr find(const juce::File& file) const;
+
+	// any thread. whether a waveform is saved for the file's contents, without reading it
+	bool contains(const juce::File& file) const;
+
+	// any thread, saves a waveform built while the file was being decoded for another reason
+	void store(const juce::File& file, WaveformPyramid::Ptr waveform);
+
+	// decodes the whole file on the calling thread, nullptr if it cannot be read or its pool job is stopped
+	WaveformPyramid::Ptr generate(const juce::File& file) const;
+
+	static juce::File getDefaultFolder();
+
+private:
+	juce::File getCacheFile(const juce::String& contentHash) const;
+	bool save(const juce::String& contentHash, const WaveformPyramid& waveform) const;
+
+	juce::AudioFormatManager& formatManager;
+	juce::File folder;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformCache)
+};
@@ -1,98 +1,131 @@
-/*
-  ==============================================================================
-
-	WaveformDisplay.cpp
-	Created: 2nd February 2023 - 06:33 PM
-	Author:  Muhammad Suleman Mirza
-
-  ==============================================================================
-*/
-
-#include <JuceHeader.h>
-#include "WaveformDisplay.h"
-using namespace juce;
-
-//==============================================================================
-/* class that handles drawing and callback of the wave graphic */
-
-WaveformDisplay::WaveformDisplay(AudioFormatManager& formatManagerToUse,
-								 AudioThumbnailCache& cacheToUse) :
-	audioThumb{ 1000, formatManagerToUse, cacheToUse },
-	fileLoaded{ false },
-	position{ 0 }
-{
-	audioThumb.addChangeListener(this);
-}
-
-WaveformDisplay::~WaveformDisplay()
-{
-
-}
-
-/* paints main colours of the waveform graphic and playhead */
-void WaveformDisplay::paint(Graphics& gfx)
-{
-	gfx.fillAll(Colours::darkgrey);   // the background is removed
-
-	gfx.setColour(Colours::grey);
-	gfx.drawRect(getLocalBounds(), 1);   // draw a border around the component
-
-	if (fileLoaded)
-	{
-		gfx.setColour(Colours::blue); // draw waveform
-		audioThumb.drawChannel(gfx, getLocalBounds(), 0, audioThumb.getTotalLength(), 0, 1.0f);
-
-		// draw current position indicator hand
-		gfx.setColour(Colours::darkorange);
-		
-		// set width of indicator hand relative to length of track (in seconds)
-		gfx.drawRect(position * getWidth(), 0, (int) std::max(3.0, ((getWidth() / 2) / audioThumb.getTotalLength()) + 2), getHeight());
-
-		// set opaque colour to fill area passed
-		gfx.setColour(Colours::black);
-		gfx.setOpacity(0.5);
-		gfx.fillRect(0, 0, position * getWidth(), getHeight());
-	}
-	else
-	{
-		gfx.setFont(20.0f);
-		gfx.drawText("File not loaded...", getLocalBounds(), Justification::centred, true);   // draw the placeholder text
-	}
-
-}
-
-void WaveformDisplay::resized()
-{
-}
-
-/* loads the audio file into audioThumb that handles drawing the waveform */
-void WaveformDisplay::loadURL(juce::URL audioURL)
-{
-	audioThumb.clear();
-	fileLoaded = audioThumb.setSource(new URLInputSource(audioURL));
-	if (fileLoaded)
-	{
-		DBG("WaveformDisplay::loadURL: loaded!");
-		position = 0;
-		repaint();
-	}
-	else {
-		DBG("WaveformDisplay::loadURL: not loaded :(");
-	}
-}
-
-/* listen for changes to waveform display, calls repaint(); */
-void WaveformDisplay::changeListenerCallback(ChangeBroadcaster* source)
-{
-	repaint();
-}
-
-/* set the relative position of the playhead */
-void WaveformDisplay::setPositionRelative(double pos)
-{
-	if (pos != position && pos > 0)
-	{
-		position = pos;
-		repaint();
-	}
+/*
+  ==============================================================================
+
+	WaveformDisplay.cpp
+	Created: 2nd February 2023 - 06:33 PM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "WaveformDisplay.h"
+using namespace juce;
+
+//==============================================================================
+/* class that handles drawing of the wave graphic */
+
+WaveformDisplay::WaveformDisplay() :
+	position{ 0 }
+{
+	// every pixel is painted, so nothing behind is redrawn when the playhead moves
+	setOpaque(true);
+}
+
+WaveformDisplay::~WaveformDisplay()
+{
+
+}
+
+/* copies the cached waveform and draws the playhead over it, usually only inside the area that moved */
+void WaveformDisplay::paint(Graphics& gfx)
+{
+	if (waveform != nullptr && waveformImage.isValid())
+	{
+		gfx.drawImageAt(waveformImage, 0, 0);
+
+		// draw current position indicator hand
+		gfx.setColour(Colours::darkorange);
+		gfx.drawRect(getPlayheadArea());
+
+		// set opaque colour to fill area passed
+		gfx.setColour(Colours::black);
+		gfx.setOpacity(0.5);
+		gfx.fillRect(0, 0, (int) (position * getWidth()), getHeight());
+	}
+	else
+	{
+		gfx.fillAll(Colours::darkgrey);   // the background is removed
+
+		gfx.setColour(Colours::grey);
+		gfx.drawRect(getLocalBounds(), 1);   // draw a border around the component
+
+		gfx.setFont(20.0f);
+		gfx.drawText(placeholder, getLocalBounds(), Justification::centred, true);   // draw the placeholder text
+	}
+
+}
+
+void WaveformDisplay::resized()
+{
+	renderWaveform();
+}
+
+/* draws the background, border and waveform into the image the playhead is painted over */
+void WaveformDisplay::renderWaveform()
+{
+	if (waveform == nullptr || getWidth() <= 0 || getHeight() <= 0)
+	{
+		waveformImage = {};
+		return;
+	}
+
+	waveformImage = Image{ Image::RGB, getWidth(), getHeight(), false };
+	Graphics gfx{ waveformImage };
+	gfx.fillAll(Colours::darkgrey);   // the background is removed
+
+	gfx.setColour(Colours::grey);
+	gfx.drawRect(getLocalBounds(), 1);   // draw a border around the component
+
+	// draw waveform, peaks with the loudness over them
+	waveform->draw(gfx, getLocalBounds(), 0, waveform->lengthInSamples, Colours::blue, Colours::lightblue);
+}
+
+/* the indicator hand, its width relative to length of track (in seconds) */
+Rectangle<int> WaveformDisplay::getPlayheadArea() const
+{
+	const double lengthInSeconds{ waveform != nullptr ? waveform->getLengthInSeconds() : 0.0 };
+	const int width{ (int) std::max(3.0, lengthInSeconds > 0.0 ? (getWidth() / 2) / lengthInSeconds + 2 : 3.0) };
+	return { (int) (position * getWidth()), 0, width, getHeight() };
+}
+
+/* takes the waveform the track loader found in the cache or built, it is always complete when there is one */
+void WaveformDisplay::loadTrack(LoadedTrack::Ptr track)
+{
+	waveform = track->waveform;
+	placeholder = "Building waveform...";
+	position = 0;
+	renderWaveform();
+	if (waveform != nullptr)
+	{
+		DBG("WaveformDisplay::loadTrack: loaded!");
+	}
+	else {
+		DBG("WaveformDisplay::loadTrack: waveform still being built");
+	}
+	repaint();
+}
+
+/* the waveform built after the track was loaded, or nullptr if the file could not be read through */
+void WaveformDisplay::setWaveform(WaveformPyramid::Ptr newWaveform)
+{
+	waveform = newWaveform;
+	placeholder = "No waveform available";
+	renderWaveform();
+	repaint();
+}
+
+/* set the relative position of the playhead, only the pixels it crossed are painted again */
+void WaveformDisplay::setPositionRelative(double pos)
+{
+	if (pos == position || pos <= 0)
+		return;
+
+	const Rectangle<int> before{ getPlayheadArea() };
+	position = pos;
+	const Rectangle<int> after{ getPlayheadArea() };
+
+	// a long track can play for several ticks before the hand moves a whole pixel
+	if (after != before)
+		repaint(before.getUnion(after));
 }
\ No newline at end of file
@@ -1,41 +1,47 @@
-/*
-  ==============================================================================
-
-	WaveformDisplay.h
-	Created: 2nd February 2023 - 08:21 AM
-	Author:  Muhammad Suleman Mirza
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-
-//==============================================================================
-/* class that handles drawing and callback of the wave graphic */
-
-class WaveformDisplay : public juce::Component,
-	public juce::ChangeListener
-{
-public:
-	WaveformDisplay(juce::AudioFormatManager& formatManagerToUse,
-					juce::AudioThumbnailCache& cacheToUse);
-	~WaveformDisplay() override;
-
-	void paint(juce::Graphics&) override;
-	void resized() override;
-
-	void loadURL(juce::URL audioURL);
-
-	void changeListenerCallback(juce::ChangeBroadcaster* source) override;
-
-	void setPositionRelative(double pos);
-
-private:
-	juce::AudioThumbnail audioThumb;
-	bool fileLoaded;
-	double position;
-
-	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformDisplay)
-};
+/*
+  ==============================================================================
+
+	WaveformDisplay.h
+	Created: 2nd February 2023 - 08:21 AM
+	Author:  Muhammad Suleman Mirza
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "TrackLoader.h"
+
+//==============================================================================
+/* class that handles drawing of the wave graphic, from the waveform the track loader hands over complete.
+   the waveform is drawn into an image once per track and size, so moving the playhead only repaints
+   the strip between its old and new place */
+
+class WaveformDisplay : public juce::Component
+{
+public:
+	WaveformDisplay();
+	~WaveformDisplay() override;
+
+	void paint(juce::Graphics&) override;
+	void resized() override;
+
+	// a streaming track the waveform cache did not have comes without one, it is set once built.
+	// setting nullptr then means it could not be built, the playhead stays where it is either way
+	void loadTrack(LoadedTrack::Ptr track);
+	void setWaveform(WaveformPyramid::Ptr newWaveform);
+
+	void setPositionRelative(double pos);
+
+private:
+	void renderWaveform();
+	juce::Rectangle<int> getPlayheadArea() const;
+
+	WaveformPyramid::Ptr waveform;   // nullptr until a track is loaded
+	juce::String placeholder{ "File not loaded..." };   // shown while there is no waveform
+	juce::Image waveformImage;       // the whole track at the component's size, without the playhead
+	double position;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformDisplay)
+};